@@ -7,6 +7,7 @@
 
 #include "fedes/indexing/octree/octree.h"
 #include "fedes/common/log.h"
+#include "fedes/common/compression.h"
 #include "fedes/model/examples.h"
 #include "fedes/model/export.h"
 
@@ -27,8 +28,31 @@ void prompt(BS::thread_pool& pool) {
 		std::cerr << "[Error] Invalid model ID!\n";
 		return;
 	}
-	fedes::SetExampleModels(source, target, model);
-	fedes::ExportRawModel(target, ("oct-M" + std::to_string(model)));
+
+	size_t integration_points{};
+	std::cout << "Enter target integration points for stresses/strains (1 - element centroids, 2 - Gauss points): \n";
+	std::cin >> integration_points;
+	if (integration_points < 1 || integration_points > 2 || std::cin.fail()) {
+		std::cin.clear();
+		std::cin.ignore();
+		std::cerr << "[Error] Invalid integration points option!\n";
+		return;
+	}
+	size_t export_format{};
+	std::cout << "Enter export format (1 - ASCII .vtu, 2 - binary .vtu, 3 - compressed binary .vtu): \n";
+	std::cin >> export_format;
+	if (export_format < 1 || export_format > 3 || std::cin.fail() || (export_format == 3 && !fedes::HasZlib())) {
+		std::cin.clear();
+		std::cin.ignore();
+		std::cerr << "[Error] Invalid export format!\n";
+		return;
+	}
+	const fedes::VtuFormat format = export_format == 3 ? fedes::VtuFormat::Compressed :
+		(export_format == 2 ? fedes::VtuFormat::Appended : fedes::VtuFormat::Ascii);
+
+	fedes::SetExampleModels(source, target, model, integration_points == 2, &pool);
+	fedes::ExportRawModel(target, ("oct-M" + std::to_string(model)), format, &pool);
+	source.Reorder(); // renumbered for memory locality, ExportModels restores the file order
 
 
 	std::cout << "Enter maximum depth of Octree: \n";
@@ -44,17 +68,29 @@ void prompt(BS::thread_pool& pool) {
 
 	std::cout << "Parallelizing root construction\n";
 
-	std::cout << "Enter interpolation type (1 - NPM, 2 - FOP, 3 - DMUE, 4 - ESF) \n";
+	std::cout << "Enter interpolation type (1 - NPM, 2 - FOP, 3 - DMUE, 4 - ESF, 5 - IDW, 6 - RBF) \n";
 	std::cin >> interpolation_type;
-	if (interpolation_type < 1 || interpolation_type > 4 || std::cin.fail()) {
+	if (interpolation_type < 1 || interpolation_type > 6 || std::cin.fail()) {
 		std::cin.clear();
 		std::cin.ignore();
 		std::cerr << "[Error] Invalid interplation type!\n";
 		return;
 	}
 
+	size_t fop_mode = 1;
 	double radius = 10.0;
 	if (interpolation_type == 2) {
+		std::cout << "Enter Field of Points search mode (1 - fixed radius, 2 - nearest point in every direction, 3 - adaptive radius) \n";
+		std::cin >> fop_mode;
+		if (fop_mode < 1 || fop_mode > 3 || std::cin.fail()) {
+			std::cin.clear();
+			std::cin.ignore();
+			std::cerr << "[Error] Invalid Field of Points mode!\n";
+			return;
+		}
+	}
+
+	if (interpolation_type == 2 && fop_mode == 1) {
 		std::cout << "Enter radius for Field of Points search \n";
 		std::cin >> radius;
 		if (radius < 0.00 || std::isinf(radius) || std::isnan(radius) || std::cin.fail()) {
@@ -79,7 +115,7 @@ void prompt(BS::thread_pool& pool) {
 
 	size_t max_leaf_scan_threshold = 1000;
 	if (interpolation_type == 4) {
-		std::cout << "Enter max leaves to scan prior to relaxing geometry boundaries (boundary shift threshold) \n";
+		std::cout << "Enter max leaves to scan prior to selecting the least relaxed element (boundary shift threshold) \n";
 		std::cin >> max_leaf_scan_threshold;
 		if (max_leaf_scan_threshold <= 0 || std::cin.fail()) {
 			std::cin.clear();
@@ -90,25 +126,58 @@ void prompt(BS::thread_pool& pool) {
 		}
 	}
 
+	size_t idw_neighbours = 8;
+	double idw_power = 2.0;
+	if (interpolation_type == 5) {
+		std::cout << "Enter number of nearest points and distance power for IDW (e.g. 8 2) \n";
+		std::cin >> idw_neighbours >> idw_power;
+		if (idw_neighbours < 1 || idw_power < 0.00 || std::isinf(idw_power) || std::isnan(idw_power) || std::cin.fail()) {
+			std::cin.clear();
+			std::cin.ignore();
+			std::cerr << "[Error] Invalid IDW parameters!\n";
+			return;
+		}
+	}
+
+	size_t rbf_neighbours = 16;
+	if (interpolation_type == 6) {
+		std::cout << "Enter number of nearest points per local RBF system (e.g. 16 - 32) \n";
+		std::cin >> rbf_neighbours;
+		if (rbf_neighbours < 1 || std::cin.fail()) {
+			std::cin.clear();
+			std::cin.ignore();
+			std::cerr << "[Error] Invalid number of nearest points!\n";
+			return;
+		}
+	}
+
 	FEDES_INFO("[CLI]: Example model {}, max depth {}, leaf split threshold {}", model, max_depth,
 		points_per_leaf);
 
 	switch (interpolation_type) {
 		case 1:
 			OctreeNPM(source, target, max_depth, points_per_leaf, pool);
-			fedes::ExportModels(source, target, ("oct-M" + std::to_string(model)), ("oct-M" + std::to_string(model) + "-npm"));
+			fedes::ExportModels(source, target, ("oct-M" + std::to_string(model)), ("oct-M" + std::to_string(model) + "-npm"), format, &pool);
 			break;
 		case 2:
-			OctreeDMUFOP(source, target, max_depth, points_per_leaf, radius, pool);
-			fedes::ExportModels(source, target, ("oct-M" + std::to_string(model)), ("oct-M" + std::to_string(model) + "-dmufop"));
+			OctreeDMUFOP(source, target, max_depth, points_per_leaf, fop_mode, radius, pool);
+			fedes::ExportModels(source, target, ("oct-M" + std::to_string(model)), ("oct-M" + std::to_string(model) + "-dmufop"), format, &pool);
 			break;
 		case 3:
 			OctreeDMUE(source, target, max_depth, points_per_leaf, min_scan_dmue, pool);
-			fedes::ExportModels(source, target, ("oct-M" + std::to_string(model)), ("oct-M" + std::to_string(model) + "-dmue"));
+			fedes::ExportModels(source, target, ("oct-M" + std::to_string(model)), ("oct-M" + std::to_string(model) + "-dmue"), format, &pool);
 			break;
 		case 4:
 			OctreeESF(source, target, max_depth, points_per_leaf, max_leaf_scan_threshold, pool);
-			fedes::ExportModels(source, target, ("oct-M" + std::to_string(model)), ("oct-M" + std::to_string(model) + "-esf"));
+			fedes::ExportModels(source, target, ("oct-M" + std::to_string(model)), ("oct-M" + std::to_string(model) + "-esf"), format, &pool);
+			break;
+		case 5:
+			OctreeIDW(source, target, max_depth, points_per_leaf, idw_neighbours, idw_power, pool);
+			fedes::ExportModels(source, target, ("oct-M" + std::to_string(model)), ("oct-M" + std::to_string(model) + "-idw"), format, &pool);
+			break;
+		case 6:
+			OctreeRBF(source, target, max_depth, points_per_leaf, rbf_neighbours, pool);
+			fedes::ExportModels(source, target, ("oct-M" + std::to_string(model)), ("oct-M" + std::to_string(model) + "-rbf"), format, &pool);
 			break;
 	}
 
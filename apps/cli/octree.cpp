@@ -5,8 +5,22 @@
 #include <BS_thread_pool.hpp>
 
 #include "fedes/indexing/octree/octree.h"
+#include "fedes/indexing/surface/bvh.h"
 #include "fedes/interpolations/octree/octree.h"
 #include "fedes/instrumentation/timer.h"
+#include "fedes/verification/quality.h"
+
+/*
+ * @brief Statistics of the mapped fields and coverage of the target by the source, with timing
+ */
+static void WriteMappingQuality(const fedes::Octree<double>& octree, const fedes::Model& source, const fedes::Model& target,
+	                            BS::thread_pool& pool, size_t max_leaf_scans_threshold = 1000) {
+	fedes::internal::Timer verification_timer("Mapping Verification");
+	fedes::MappingQuality quality = fedes::ParallelMappingQuality(octree, source, target, pool, 16, max_leaf_scans_threshold);
+	auto verification_duration = verification_timer.Stop();
+	quality.Write();
+	verification_timer.WriteDuration(verification_duration);
+}
 
 /*
  * @brief Nearest Point Method with Octree Index with timing
@@ -18,27 +32,40 @@ void OctreeNPM(fedes::Model& source, fedes::Model& target, size_t max_depth, siz
 	auto build_duration = build_timer.Stop();
 
 	fedes::internal::Timer interpolation_timer("Octree NPM Interpolation");
-	fedes::ParallelNearestPointMethod(octree, source, target, pool);
+	fedes::ParallelNearestPointMethod(octree, source, target, pool, fedes::TargetOrder::Morton);
 	auto interpolation_duration = interpolation_timer.Stop();
 	build_timer.WriteDuration(build_duration);
 	interpolation_timer.WriteDuration(interpolation_duration);
+	WriteMappingQuality(octree, source, target, pool);
 }
 
 
 /*
  * @brief Distance Method using Field of Points with Octree Index with timing
+ * @param fop_mode: 1 - fixed radius, 2 - nearest point in every direction, 3 - adaptive radius
  */
 void OctreeDMUFOP(fedes::Model& source, fedes::Model& target, size_t max_depth, size_t points_per_leaf,
-	             double radius, BS::thread_pool& pool) {
+	             size_t fop_mode, double radius, BS::thread_pool& pool) {
 	fedes::internal::Timer build_timer("Octree Node Index Construction");
 	fedes::Octree<double> octree(source.nodes, max_depth, points_per_leaf, &pool);
 	auto build_duration = build_timer.Stop();
 
 	fedes::internal::Timer interpolation_timer("Octree Distance Method using Field of Points Interpolation");
-	fedes::ParallelFieldOfPoints(octree, source, target, pool, radius);
+	switch (fop_mode) {
+		case 2:
+			fedes::ParallelFieldOfPoints(octree, source, target, pool, fedes::TargetOrder::Morton);
+			break;
+		case 3:
+			fedes::ParallelAdaptiveFieldOfPoints(octree, source, target, pool, 8, 2.0, fedes::TargetOrder::Morton);
+			break;
+		default:
+			fedes::ParallelFieldOfPoints(octree, source, target, pool, radius, fedes::TargetOrder::Morton);
+			break;
+	}
 	auto interpolation_duration = interpolation_timer.Stop();
 	build_timer.WriteDuration(build_duration);
 	interpolation_timer.WriteDuration(interpolation_duration);
+	WriteMappingQuality(octree, source, target, pool);
 }
 
 /*
@@ -50,11 +77,17 @@ void OctreeDMUE(fedes::Model& source, fedes::Model& target, size_t max_depth, si
 	fedes::Octree<double> octree(source.nodes, source.elements, max_depth, points_per_leaf, &pool);
 	auto build_duration = build_timer.Stop();
 
+	fedes::internal::Timer surface_timer("Surface Index Construction");
+	fedes::SurfaceBVH surface(source.nodes, source.elements);
+	auto surface_duration = surface_timer.Stop();
+
 	fedes::internal::Timer interpolation_timer("Octree Distance Method using Elements Interpolation");
-	fedes::ParallelDMUE(octree, source, target, pool, min_scan_dmue);
+	fedes::ParallelDMUE(octree, source, target, pool, min_scan_dmue, fedes::TargetOrder::Morton, &surface);
 	auto interpolation_duration = interpolation_timer.Stop();
 	build_timer.WriteDuration(build_duration);
+	surface_timer.WriteDuration(surface_duration);
 	interpolation_timer.WriteDuration(interpolation_duration);
+	WriteMappingQuality(octree, source, target, pool);
 }
 
 /*
@@ -66,9 +99,49 @@ void OctreeESF(fedes::Model& source, fedes::Model& target, size_t max_depth, siz
 	fedes::Octree<double> octree(source.nodes, source.elements, max_depth, points_per_leaf, &pool);
 	auto build_duration = build_timer.Stop();
 
+	fedes::internal::Timer surface_timer("Surface Index Construction");
+	fedes::SurfaceBVH surface(source.nodes, source.elements);
+	auto surface_duration = surface_timer.Stop();
+
 	fedes::internal::Timer interpolation_timer("Octree Element Shape Function Interpolation");
-	fedes::ParallelElementShapeFunction(octree, source, target, pool, max_leaf_scans_threshold);
+	fedes::ParallelElementShapeFunction(octree, source, target, pool, max_leaf_scans_threshold, fedes::TargetOrder::Morton, &surface);
+	auto interpolation_duration = interpolation_timer.Stop();
+	build_timer.WriteDuration(build_duration);
+	surface_timer.WriteDuration(surface_duration);
+	interpolation_timer.WriteDuration(interpolation_duration);
+	WriteMappingQuality(octree, source, target, pool, max_leaf_scans_threshold);
+}
+
+/*
+ * @brief Inverse Distance Weighting over the k nearest points with Octree Index with timing
+ */
+void OctreeIDW(fedes::Model& source, fedes::Model& target, size_t max_depth, size_t points_per_leaf,
+	          size_t k, double power, BS::thread_pool& pool) {
+	fedes::internal::Timer build_timer("Octree Node Index Construction");
+	fedes::Octree<double> octree(source.nodes, max_depth, points_per_leaf, &pool);
+	auto build_duration = build_timer.Stop();
+
+	fedes::internal::Timer interpolation_timer("Octree Inverse Distance Weighting Interpolation");
+	fedes::ParallelInverseDistanceWeighting(octree, source, target, pool, k, power, fedes::TargetOrder::Morton);
+	auto interpolation_duration = interpolation_timer.Stop();
+	build_timer.WriteDuration(build_duration);
+	interpolation_timer.WriteDuration(interpolation_duration);
+	WriteMappingQuality(octree, source, target, pool);
+}
+
+/*
+ * @brief Local Radial Basis Function interpolation over the k nearest points with Octree Index with timing
+ */
+void OctreeRBF(fedes::Model& source, fedes::Model& target, size_t max_depth, size_t points_per_leaf,
+	          size_t k, BS::thread_pool& pool) {
+	fedes::internal::Timer build_timer("Octree Node Index Construction");
+	fedes::Octree<double> octree(source.nodes, max_depth, points_per_leaf, &pool);
+	auto build_duration = build_timer.Stop();
+
+	fedes::internal::Timer interpolation_timer("Octree Radial Basis Function Interpolation");
+	fedes::ParallelRadialBasisFunction(octree, source, target, pool, k, fedes::TargetOrder::Morton);
 	auto interpolation_duration = interpolation_timer.Stop();
 	build_timer.WriteDuration(build_duration);
 	interpolation_timer.WriteDuration(interpolation_duration);
+	WriteMappingQuality(octree, source, target, pool);
 }
@@ -9,10 +9,17 @@ void OctreeNPM(fedes::Model& source, fedes::Model& target, size_t max_depth, siz
 	            BS::thread_pool& pool);
 
 void OctreeDMUFOP(fedes::Model& source, fedes::Model& target, size_t max_depth, size_t points_per_leaf,
-	             double radius, BS::thread_pool& pool);
+	             size_t fop_mode, double radius, BS::thread_pool& pool);
 
 void OctreeDMUE(fedes::Model& source, fedes::Model& target, size_t max_depth, size_t points_per_leaf,
 	           size_t min_leaf_scan_dmue, BS::thread_pool& pool);
 
 void OctreeESF(fedes::Model& source, fedes::Model& target, size_t max_depth, size_t points_per_leaf,
 	          size_t max_leaf_scans_threshold, BS::thread_pool& pool);
+
+
+void OctreeIDW(fedes::Model& source, fedes::Model& target, size_t max_depth, size_t points_per_leaf,
+	          size_t k, double power, BS::thread_pool& pool);
+
+void OctreeRBF(fedes::Model& source, fedes::Model& target, size_t max_depth, size_t points_per_leaf,
+	          size_t k, BS::thread_pool& pool);
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "fedes/common/base64.h"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace fedes {
+
+	namespace {
+		constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+		// Values 0-63 are digits, the others are flags (any of the two top bits set)
+		constexpr uint8_t invalid = 0xFF, padding = 0xFE, blank = 0xFD;
+
+		constexpr std::array<uint8_t, 256> decoding = []() {
+			std::array<uint8_t, 256> table{};
+			table.fill(invalid);
+			for (size_t i = 0; i < alphabet.size(); ++i) {
+				table[static_cast<uint8_t>(alphabet[i])] = static_cast<uint8_t>(i);
+			}
+			table['='] = padding;
+			for (char c : { ' ', '\t', '\r', '\n' }) {
+				table[static_cast<uint8_t>(c)] = blank;
+			}
+			return table;
+		}();
+	}
+
+	/*
+	 * @brief Decodes base64 text, which may be wrapped over lines and may be the concatenation of several padded encodings
+	 * (VTK encodes the header of a compressed array separately from its data). Whole quads of digits, the bulk of the text,
+	 * are decoded with one table lookup per character and no branch per character.
+	 * @param output: at least Base64DecodedSize(text) bytes
+	 * @return number of bytes written
+	 * @exception std::invalid_argument for characters outside the alphabet or a truncated quad
+	 */
+	size_t Base64Decode(std::string_view text, char* output) {
+		const auto* input = reinterpret_cast<const uint8_t*>(text.data());
+		const size_t size = text.size();
+		size_t i = 0, written = 0;
+		while (true) {
+			while (i + 4 <= size) {
+				const uint32_t a = decoding[input[i]], b = decoding[input[i + 1]], c = decoding[input[i + 2]], d = decoding[input[i + 3]];
+				if ((a | b | c | d) & 0xC0) {
+					break;
+				}
+				const uint32_t bits = a << 18 | b << 12 | c << 6 | d;
+				output[written] = static_cast<char>(bits >> 16);
+				output[written + 1] = static_cast<char>(bits >> 8);
+				output[written + 2] = static_cast<char>(bits);
+				written += 3;
+				i += 4;
+			}
+
+			// A quad broken by blanks, or ending with padding
+			uint32_t quad[4];
+			size_t count = 0;
+			while (i < size && count < 4) {
+				const uint8_t value = decoding[input[i++]];
+				if (value == blank) {
+					continue;
+				}
+				if (value == invalid) {
+					throw std::invalid_argument("Invalid base64 character at " + std::to_string(i - 1));
+				}
+				quad[count++] = value;
+			}
+			if (count == 0) {
+				return written;
+			}
+			if (count < 4 || quad[0] == padding || quad[1] == padding || (quad[2] == padding && quad[3] != padding)) {
+				throw std::invalid_argument("Invalid base64 quad before " + std::to_string(i));
+			}
+			const size_t bytes = quad[2] == padding ? 1 : (quad[3] == padding ? 2 : 3);
+			const uint32_t bits = quad[0] << 18 | quad[1] << 12 | (quad[2] & 0x3F) << 6 | (quad[3] & 0x3F);
+			for (size_t k = 0; k < bytes; ++k) {
+				output[written++] = static_cast<char>(bits >> (16 - 8 * k));
+			}
+		}
+	}
+
+	/*
+	 * @brief Encodes the bytes as padded base64 text on a single line
+	 */
+	std::string Base64Encode(std::string_view bytes) {
+		const auto* input = reinterpret_cast<const uint8_t*>(bytes.data());
+		std::string text((bytes.size() + 2) / 3 * 4, '=');
+		size_t i = 0, written = 0;
+		for (; i + 3 <= bytes.size(); i += 3) {
+			const uint32_t bits = static_cast<uint32_t>(input[i]) << 16 | static_cast<uint32_t>(input[i + 1]) << 8 | input[i + 2];
+			text[written++] = alphabet[bits >> 18];
+			text[written++] = alphabet[(bits >> 12) & 0x3F];
+			text[written++] = alphabet[(bits >> 6) & 0x3F];
+			text[written++] = alphabet[bits & 0x3F];
+		}
+		if (i < bytes.size()) {
+			const bool two = i + 1 < bytes.size();
+			const uint32_t bits = static_cast<uint32_t>(input[i]) << 16 | (two ? static_cast<uint32_t>(input[i + 1]) << 8 : 0);
+			text[written++] = alphabet[bits >> 18];
+			text[written++] = alphabet[(bits >> 12) & 0x3F];
+			if (two) {
+				text[written] = alphabet[(bits >> 6) & 0x3F];
+			}
+		}
+		return text;
+	}
+}
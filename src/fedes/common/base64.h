@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace fedes {
+
+	// Base64 (RFC 4648) as used by the binary formats of VTK XML files
+
+	/*
+	 * @brief Upper bound of the number of bytes Base64Decode writes for the text
+	 */
+	inline size_t Base64DecodedSize(std::string_view text) {
+		return (text.size() / 4 + 1) * 3;
+	}
+
+	size_t Base64Decode(std::string_view text, char* output);
+	std::string Base64Encode(std::string_view bytes);
+}
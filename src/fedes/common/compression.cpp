@@ -0,0 +1,60 @@
+#include "fedes/common/compression.h"
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(FEDES_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+namespace fedes {
+
+	bool HasZlib() {
+#if defined(FEDES_HAS_ZLIB)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/*
+	 * @brief Compresses the bytes into a zlib stream
+	 * @param level: 0 (none) to 9 (smallest), -1 for zlib's default
+	 * @exception std::runtime_error without zlib or if compression fails
+	 */
+	std::vector<char> ZlibCompress(std::string_view bytes, int level) {
+#if defined(FEDES_HAS_ZLIB)
+		uLongf size = compressBound(static_cast<uLong>(bytes.size()));
+		std::vector<char> compressed(size);
+		const int result = compress2(reinterpret_cast<Bytef*>(compressed.data()), &size, reinterpret_cast<const Bytef*>(bytes.data()),
+			static_cast<uLong>(bytes.size()), level);
+		if (result != Z_OK) {
+			throw std::runtime_error("zlib compression failed (" + std::to_string(result) + ")");
+		}
+		compressed.resize(size);
+		return compressed;
+#else
+		throw std::runtime_error("FEDES was built without zlib");
+#endif
+	}
+
+	/*
+	 * @brief Uncompresses a zlib stream of known uncompressed size
+	 * @param output: exactly size bytes
+	 * @exception std::runtime_error without zlib, for corrupt streams, or if the size does not match
+	 */
+	void ZlibUncompress(std::string_view compressed, char* output, size_t size) {
+#if defined(FEDES_HAS_ZLIB)
+		uLongf written = static_cast<uLongf>(size);
+		const int result = uncompress(reinterpret_cast<Bytef*>(output), &written, reinterpret_cast<const Bytef*>(compressed.data()),
+			static_cast<uLong>(compressed.size()));
+		if (result != Z_OK || written != size) {
+			throw std::runtime_error("zlib stream corrupt or of unexpected size (" + std::to_string(result) + ")");
+		}
+#else
+		throw std::runtime_error("FEDES was built without zlib");
+#endif
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace fedes {
+
+	// zlib streams, as in the blocks of compressed VTK XML files. zlib is optional: without it (FEDES_HAS_ZLIB undefined)
+	// HasZlib is false and the functions throw.
+
+	bool HasZlib();
+	std::vector<char> ZlibCompress(std::string_view bytes, int level = -1);
+	void ZlibUncompress(std::string_view compressed, char* output, size_t size);
+}
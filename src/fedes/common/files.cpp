@@ -17,10 +17,8 @@ namespace fedes {
 	 */
 	void SetInputFileStream(const std::filesystem::path& path, std::ifstream& input_stream) {
 		input_stream.exceptions(std::ifstream::badbit);
-		const size_t buffer_size = 256 * 1024;
-		char buffer[buffer_size];
+		// No larger pubsetbuf() buffer: a local one would dangle once this returns, see MappedFile for fast reads instead
 		try {
-			input_stream.rdbuf()->pubsetbuf(buffer, buffer_size);
 			input_stream.open(path, std::ios::in);
 		} catch (const std::ifstream::failure& e) {
 			throw;
@@ -85,15 +83,16 @@ namespace fedes {
 	 * 
 	 * @param path: Path and name of the file to create/write/output to
 	 * @param output_stream: Output stream to set
+	 * @param binary: open in binary mode, so bytes are written unchanged (no \r\n translation on Windows)
 	 * @exception Propagates std::ofstream::failure
 	 */
-	void SetOutputFileStream(const std::filesystem::path& path, std::ofstream& output_stream) {
+	void SetOutputFileStream(const std::filesystem::path& path, std::ofstream& output_stream, bool binary) {
 		output_stream.exceptions(std::ifstream::badbit);
 		try {
 			if (!std::filesystem::is_directory(path.parent_path()) && path.has_parent_path()) {
 				std::filesystem::create_directories(path.parent_path());
 			}
-			output_stream.open(path, std::ios::out | std::ios::trunc);
+			output_stream.open(path, binary ? std::ios::out | std::ios::trunc | std::ios::binary : std::ios::out | std::ios::trunc);
 		} catch (const std::ofstream::failure& e) {
 			throw;
 		}
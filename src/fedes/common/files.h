@@ -12,7 +12,7 @@ namespace fedes {
 	void RewindInputStream(std::ifstream& input_stream);
 	std::string StringFromFile(const std::filesystem::path& path);
 
-	void SetOutputFileStream(const std::filesystem::path& output_file_path, std::ofstream& output_stream);
+	void SetOutputFileStream(const std::filesystem::path& output_file_path, std::ofstream& output_stream, bool binary = false);
 	void CloseOutputFileStream(std::ofstream& output_stream);
 
 	void PrintCurrentDir(std::ostream& os = std::cout);
@@ -0,0 +1,113 @@
+#include "fedes/common/mapped_file.h"
+
+#include <cerrno>
+#include <filesystem>
+#include <ios>
+#include <string>
+#include <system_error>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fedes {
+
+	/*
+	 * @brief Maps the whole file read-only, empty files yield an empty view
+	 * @param path: File path that is relative from the execution binary
+	 * @exception std::ios_base::failure (i.e. std::ifstream::failure) if the file cannot be opened or mapped
+	 */
+	MappedFile::MappedFile(const std::filesystem::path& path) {
+		// Built before any handle is closed, which would overwrite the error
+		auto failure = [&](const char* what) {
+#if defined(_WIN32)
+			const std::error_code error(static_cast<int>(GetLastError()), std::system_category());
+#else
+			const std::error_code error(errno, std::generic_category());
+#endif
+			return std::ios_base::failure(std::string(what) + ": " + path.string(), error);
+		};
+#if defined(_WIN32)
+		file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file_ == INVALID_HANDLE_VALUE) {
+			file_ = nullptr;
+			throw failure("Mapped file: unable to open");
+		}
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file_, &size)) {
+			const std::ios_base::failure error = failure("Mapped file: unable to read the size of");
+			CloseHandle(file_);
+			throw error;
+		}
+		size_ = static_cast<size_t>(size.QuadPart);
+		if (size_ == 0) {
+			return;
+		}
+		mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping_ == nullptr) {
+			const std::ios_base::failure error = failure("Mapped file: unable to map");
+			CloseHandle(file_);
+			throw error;
+		}
+		data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+		if (data_ == nullptr) {
+			const std::ios_base::failure error = failure("Mapped file: unable to map");
+			CloseHandle(mapping_);
+			CloseHandle(file_);
+			throw error;
+		}
+#else
+		descriptor_ = open(path.c_str(), O_RDONLY);
+		if (descriptor_ == -1) {
+			throw failure("Mapped file: unable to open");
+		}
+		struct stat status;
+		if (fstat(descriptor_, &status) == -1) {
+			const std::ios_base::failure error = failure("Mapped file: unable to read the size of");
+			close(descriptor_);
+			throw error;
+		}
+		size_ = static_cast<size_t>(status.st_size);
+		if (size_ == 0) {
+			return;
+		}
+		void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor_, 0);
+		if (data == MAP_FAILED) {
+			const std::ios_base::failure error = failure("Mapped file: unable to map");
+			close(descriptor_);
+			throw error;
+		}
+		// Parsers scan the file front to back, let the kernel read ahead aggressively
+		madvise(data, size_, MADV_SEQUENTIAL);
+		data_ = static_cast<const char*>(data);
+#endif
+	}
+
+	MappedFile::~MappedFile() noexcept {
+#if defined(_WIN32)
+		if (data_ != nullptr) {
+			UnmapViewOfFile(data_);
+		}
+		if (mapping_ != nullptr) {
+			CloseHandle(mapping_);
+		}
+		if (file_ != nullptr) {
+			CloseHandle(file_);
+		}
+#else
+		if (data_ != nullptr) {
+			munmap(const_cast<char*>(data_), size_);
+		}
+		if (descriptor_ != -1) {
+			close(descriptor_);
+		}
+#endif
+	}
+}
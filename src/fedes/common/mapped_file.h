@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace fedes {
+
+	/*
+	 * @brief Read-only memory mapping of a whole file, the pages are loaded by the OS on first access and shared with its
+	 * page cache, so parsing works directly on the file contents without copying them into stream buffers or strings.
+	 */
+	class MappedFile {
+	public:
+		explicit MappedFile(const std::filesystem::path& path);
+		~MappedFile() noexcept;
+
+		MappedFile(const MappedFile& other) = delete;
+		MappedFile& operator=(const MappedFile& other) = delete;
+		MappedFile(MappedFile&& other) noexcept = delete;
+		MappedFile& operator=(MappedFile&& other) noexcept = delete;
+
+		[[nodiscard]] std::string_view view() const {
+			return { data_, size_ };
+		}
+
+		[[nodiscard]] size_t size() const {
+			return size_;
+		}
+
+	private:
+		const char* data_ = nullptr;
+		size_t size_ = 0;
+#if defined(_WIN32)
+		void* file_ = nullptr;
+		void* mapping_ = nullptr;
+#else
+		int descriptor_ = -1;
+#endif
+	};
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <concepts>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+
+namespace fedes {
+
+	// Allocation free scanning of text held in memory, e.g. a MappedFile: lines and tokens are std::string_view into the text
+	// and numbers are converted in place with std::from_chars
+
+	/*
+	 * @brief The line starting at position, without its line break (\n or \r\n)
+	 * @param position: advanced to the start of the next line, text.size() after the last one
+	 */
+	inline std::string_view NextLine(std::string_view text, size_t& position) {
+		const size_t begin = position;
+		const void* found = std::memchr(text.data() + begin, '\n', text.size() - begin);
+		size_t end = found != nullptr ? static_cast<const char*>(found) - text.data() : text.size();
+		position = end < text.size() ? end + 1 : end;
+		if (end > begin && text[end - 1] == '\r') {
+			--end;
+		}
+		return text.substr(begin, end - begin);
+	}
+
+	/*
+	 * @brief Number of lines in the text, i.e. line breaks plus an unterminated last line
+	 */
+	inline size_t CountLines(std::string_view text) {
+		const size_t breaks = static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+		return breaks + (!text.empty() && text.back() != '\n');
+	}
+
+	inline void SkipBlanks(std::string_view line, size_t& position) {
+		while (position < line.size() && (line[position] == ' ' || line[position] == '\t')) {
+			++position;
+		}
+	}
+
+	/*
+	 * @brief Whether only blanks remain after position
+	 */
+	inline bool AtEnd(std::string_view line, size_t position) {
+		SkipBlanks(line, position);
+		return position >= line.size();
+	}
+
+	/*
+	 * @brief Case insensitive prefix test, the prefix is expected in lower case
+	 */
+	inline bool StartsWithLower(std::string_view line, std::string_view prefix) {
+		if (line.size() < prefix.size()) {
+			return false;
+		}
+		for (size_t i = 0; i < prefix.size(); ++i) {
+			if (std::tolower(static_cast<unsigned char>(line[i])) != prefix[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/*
+	 * @brief Parses the number at position, skipping leading blanks and a leading '+' (which std::from_chars rejects)
+	 * @param position: advanced past the number on success
+	 * @return false if there is no number at position, leaving value untouched
+	 */
+	template <typename T> requires std::integral<T> || std::floating_point<T>
+	bool ParseNumber(std::string_view line, size_t& position, T& value) {
+		size_t p = position;
+		SkipBlanks(line, p);
+		if (p < line.size() && line[p] == '+') {
+			++p;
+		}
+		const char* first = line.data() + p;
+		const char* last = line.data() + line.size();
+		const std::from_chars_result result = std::from_chars(first, last, value);
+		if (result.ec != std::errc() || result.ptr == first) {
+			return false;
+		}
+		position = result.ptr - line.data();
+		return true;
+	}
+
+	/*
+	 * @brief The blank separated token after position, empty once only blanks remain
+	 * @param position: advanced past the token
+	 */
+	inline std::string_view NextToken(std::string_view line, size_t& position) {
+		SkipBlanks(line, position);
+		const size_t begin = position;
+		while (position < line.size() && line[position] != ' ' && line[position] != '\t') {
+			++position;
+		}
+		return line.substr(begin, position - begin);
+	}
+
+	/*
+	 * @brief Skips blanks and the given separator if it is the next character
+	 * @return whether the separator was found
+	 */
+	inline bool SkipSeparator(std::string_view line, size_t& position, char separator) {
+		SkipBlanks(line, position);
+		if (position < line.size() && line[position] == separator) {
+			++position;
+			return true;
+		}
+		return false;
+	}
+}
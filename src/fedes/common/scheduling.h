@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/maths/vector3.h"
+#include "fedes/maths/z_ordering.h"
+
+namespace fedes {
+
+	/*
+	 * @brief Dynamically scheduled counterpart of BS::thread_pool::parallelize_loop
+	 *
+	 * parallelize_loop splits [first, last) into one equal static block per thread, so a thread given the expensive part of a
+	 * mapping (boundary points, dense regions) finishes long after the others. Here, every thread instead repeatedly claims
+	 * the next `grain` sized chunk from a shared atomic counter, until the range is exhausted.
+	 * @param loop: called as loop(a, b) for every chunk [a, b), i.e. the same signature as for parallelize_loop
+	 * @param grain: chunk size, 0 picks one that yields ~16 chunks per thread
+	 * @return futures to wait on, any state captured by reference in the loop must outlive them
+	 */
+	template <typename F>
+	[[nodiscard]] BS::multi_future<void> ParallelFor(BS::thread_pool& pool, size_t first, size_t last, F&& loop, size_t grain = 0) {
+		BS::multi_future<void> futures;
+		if (last <= first) {
+			return futures;
+		}
+
+		const size_t threads = std::max<size_t>(1, pool.get_thread_count());
+		const size_t total = last - first;
+		if (grain == 0) {
+			grain = std::max<size_t>(1, total / (threads * 16));
+		}
+
+		std::shared_ptr<std::atomic<size_t>> next = std::make_shared<std::atomic<size_t>>(first);
+		std::shared_ptr<std::decay_t<F>> chunk = std::make_shared<std::decay_t<F>>(std::forward<F>(loop));
+		const size_t workers = std::min(threads, (total + grain - 1) / grain);
+		for (size_t w = 0; w < workers; ++w) {
+			futures.f.push_back(pool.submit(
+				[next, chunk, last, grain]()
+				{
+					for (size_t a = next->fetch_add(grain); a < last; a = next->fetch_add(grain)) {
+						(*chunk)(a, std::min(a + grain, last));
+					}
+				}));
+		}
+		return futures;
+	}
+
+	/*
+	 * @brief Order in which a mapping processes the target points. Target meshes exported by Abaqus/Ansys are often numbered
+	 * in a spatially random order, so consecutive queries descend to unrelated octants. Along the Morton (Z-Order) curve,
+	 * consecutive queries, and the chunks claimed by each thread, visit the same octants and elements while still cached.
+	 */
+	enum class TargetOrder { File, Morton };
+
+	/*
+	 * @brief Permutation to process target points in, results are still written to the target index itself
+	 * @return the target index of every processing position, empty (identity) for TargetOrder::File
+	 */
+	template <std::floating_point T>
+	[[nodiscard]] std::vector<size_t> TargetPermutation(const std::vector<fedes::Vector3<T>>& points, TargetOrder order) {
+		if (order == TargetOrder::Morton) {
+			return fedes::MortonOrder(points);
+		}
+		return {};
+	}
+}
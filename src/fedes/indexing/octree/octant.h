@@ -65,6 +65,23 @@ namespace fedes::internal {
 			return fedes::DetermineDirection(center, point);
 		}
 		
+		/*
+		 * @brief Returns the directions (as per DetermineDirection) around the given origin that this Octant overlaps
+		 * @return bit mask, bit i set if the Octant may contain points in direction i of the origin
+		 */
+		[[nodiscard]] uint_fast8_t DirectionMask(const Vector3& origin) const {
+			uint_fast8_t x = (aabb_min.x < origin.x ? 0b01 : 0) | (aabb_max.x >= origin.x ? 0b10 : 0);
+			uint_fast8_t y = (aabb_min.y < origin.y ? 0b01 : 0) | (aabb_max.y >= origin.y ? 0b10 : 0);
+			uint_fast8_t z = (aabb_min.z < origin.z ? 0b01 : 0) | (aabb_max.z >= origin.z ? 0b10 : 0);
+			uint_fast8_t mask = 0;
+			for (uint_fast8_t dir = 0; dir < 8; ++dir) {
+				if ((x >> ((dir >> 2) & 1) & 1) && (y >> ((dir >> 1) & 1) & 1) && (z >> (dir & 1) & 1)) {
+					mask |= 1 << dir;
+				}
+			}
+			return mask;
+		}
+
 		/*
 	     * @brief Calculates the minimum squared distance to a given point from this Octant
 		 * Handles containment (return 0 case).
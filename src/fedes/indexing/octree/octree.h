@@ -1,6 +1,9 @@
 #pragma once
 
 #include <array>
+#include <algorithm>
+#include <bit>
+#include <cmath>
 #include <span>
 #include <vector>
 #include <optional>
@@ -10,6 +13,7 @@
 #include <stdexcept>
 #include <concepts>
 #include <unordered_set>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <assert.h>
@@ -21,10 +25,13 @@
 #include "fedes/maths/z_ordering.h"
 #include "fedes/maths/element_type.h"
 #include "fedes/maths/geometry.h"
+#include "fedes/maths/element_cache.h"
+#include "fedes/maths/isoparametric.h"
 #include "fedes/indexing/octree/traversals.h"
 #include "fedes/indexing/octree/octant.h"
 #include "fedes/indexing/octree/octant_comparator.h"
 #include "fedes/common/log.h"
+#include "fedes/common/scheduling.h"
 
 namespace fedes {	
 
@@ -41,7 +48,10 @@ namespace fedes {
 		const std::span<Vector3>* points_;
 		const std::vector<std::vector<size_t>>* elements_ = nullptr;
 		std::vector<std::vector<size_t>> node_elements_; // @brief: Node to element lookup
+		std::vector<ElementCache> element_cache_; // @brief: Per-element inverse maps for containment tests, empty if disabled
+		std::unordered_map<const Octant*, std::vector<ElementBlock>> leaf_blocks_; // @brief: Per-leaf SoA packed candidate elements, empty if disabled
 		ElementType element_type_;
+		double max_element_extent_ = 0.0; // @brief: Largest element bounding box diagonal
 		BS::thread_pool* pool_;
 
 		size_t leaf_split_threshold_; // @brief: Splitting threshold - until a leaf contains X points, prevent splitting
@@ -82,9 +92,13 @@ namespace fedes {
 
 		/*
 		 * @brief Element index constructor overload
+		 * @param cache_elements: precompute the inverse map and bounding box of every element, turning each MUESF containment test
+		 * into a matrix-vector product for tetrahedra and a box-rejected Newton inverse mapping for wedges and hexahedra (costs 18
+		 * doubles per element), and pack the candidate elements of every leaf into blocks that are tested several at a time
+		 * (costs 18 doubles per element per leaf it touches)
 		 */
 		Octree(const std::span<Vector3>& points, const std::vector<std::vector<size_t>>& elements, size_t max_depth, 
-			  size_t leaf_split_threshold, std::optional<BS::thread_pool*> pool = std::nullopt)
+			  size_t leaf_split_threshold, std::optional<BS::thread_pool*> pool = std::nullopt, bool cache_elements = true)
 		: points_(&points), elements_(&elements), leaf_split_threshold_(leaf_split_threshold), max_depth_(max_depth) {
 			if (points_->empty()) {
 				throw std::length_error("Octree Element Index Constructor: Empty set of initial points sent");
@@ -93,24 +107,39 @@ namespace fedes {
 				throw std::length_error("Octree Element Index Constructor: Empty set of elements sent");
 			}
 			element_type_ = DetermineElementType(*elements_);
+			MaxElementExtent();
 			
 			if (pool.has_value()) {
 				pool_ = pool.value();
 				ParallelConstructRoot();
 				ParallelNodeElementMap();
+				if (cache_elements) {
+					ParallelCacheElements();
+				}
 			} else {
 				ConstructRoot();
 				NodeElementMap();
+				if (cache_elements) {
+					CacheElements();
+				}
 			}
 
 			for (size_t i = 0; i != points_->size(); i++) {
 				Insert(*root_, i, 0);
 			}
+
+			if (cache_elements) {
+				if (pool.has_value()) {
+					ParallelPackLeafBlocks();
+				} else {
+					PackLeafBlocks();
+				}
+			}
 			FEDES_INFO("[Octree Element Index]: parallelize = {}, max depth {}, leaf split threshold {}", pool.has_value(),
 				max_depth, leaf_split_threshold_);
 			FEDES_INFO("[Octree Element Index]: root center {}, root 1/2 e: {}, number of points {}, number of elements {}", root_->center,
 				root_->extent, points_->size(), elements_->size());
-			FEDES_INFO("[Octree Element Index]: element type is {}", element_type_);
+			FEDES_INFO("[Octree Element Index]: element type is {}, element cache = {}", element_type_, cache_elements);
 		}
 
 		~Octree() noexcept {
@@ -137,19 +166,65 @@ namespace fedes {
 			return NearestNeighbour(query_point);
 		}
 
+		/*
+		 * @brief The k nearest points to the query point, closest first
+		 * @param results: filled with the Point ID and Euclidean Distance of each (fewer than k if the Octree holds fewer points),
+		 * reusing the same vector for consecutive queries avoids reallocating it
+		 */
+		void KNearest(const Vector3& query_point, size_t k, std::vector<std::pair<size_t, PointT>>& results) const {
+			KNearestNeighbours(query_point, k, results);
+		}
+
 		[[nodiscard]] std::array<std::pair<size_t, PointT>, 8> FieldOfPoints(const Vector3& query_point, const PointT max_radius) const {
 			return FieldSearch(query_point, *root_, max_radius);
 		}
 
+		/*
+		 * @brief Radius-free field of points: the nearest point in each of the 8 directions (as per DetermineDirection)
+		 * @return Point ID and Euclidean Distance to query point for each direction, default pairs for directions without any point
+		 */
+		[[nodiscard]] std::array<std::pair<size_t, PointT>, 8> FieldOfPoints(const Vector3& query_point) const {
+			return DirectionalFieldSearch(query_point);
+		}
+
+		/*
+		 * @brief Field of points with a per-query radius adapted to the local point density. The initial radius is the distance
+		 * to the k-th nearest point of the leaf containing the query (or the leaf's diagonal if it holds fewer points), and is
+		 * only grown, geometrically, for the directions that are still empty.
+		 * @param k: neighbour rank for the initial radius
+		 * @param growth: factor to grow the radius by for each round, > 1
+		 * @return Point ID and Euclidean Distance to query point for each direction, default pairs for directions without any point
+		 */
+		[[nodiscard]] std::array<std::pair<size_t, PointT>, 8> AdaptiveFieldOfPoints(const Vector3& query_point, size_t k = 8, PointT growth = 2.0) const {
+			return AdaptiveFieldSearch(query_point, k, growth);
+		}
+
 		[[nodiscard]] size_t DMUE(const Vector3& query_point, size_t min_element_scan = 20) const {
 			return DMUESearch(query_point, min_element_scan);
 		}
 		
 		/* 
 		 * @param leaf_threshold: In case of differing geometries  the whole tree need not be searched before the boundaries are relaxed.
+		 * @param max_relaxation: largest relaxation of the containment bounds still considered a containing element, beyond which
+		 * the local coordinates are projected onto the closest element instead (see MuesfData)
 		 */
-		[[nodiscard]] std::pair<size_t, MuesfData> MUESF(const Vector3& query_point, size_t leaf_threshold) const {
-			return MUESFSearch(query_point, leaf_threshold);
+		[[nodiscard]] std::pair<size_t, MuesfData> MUESF(const Vector3& query_point, size_t leaf_threshold, double max_relaxation = 0.25) const {
+			return MUESFSearch(query_point, leaf_threshold, max_relaxation);
+		}
+
+		/*
+		 * @brief MUESF starting from a hint, e.g. the element of the previous integration point of the same target element: if
+		 * the hinted element contains the point within the base bounds it is returned straight away, skipping the search
+		 */
+		[[nodiscard]] std::pair<size_t, MuesfData> MUESF(const Vector3& query_point, size_t leaf_threshold, double max_relaxation,
+			                                             std::optional<size_t> hint) const {
+			if (hint.has_value() && *hint < elements_->size()) {
+				MuesfData local = LocalCoordinates(*hint, query_point);
+				if (BoundsViolation(local, BaseContainmentBounds()) < 0) {
+					return { *hint, local };
+				}
+			}
+			return MUESFSearch(query_point, leaf_threshold, max_relaxation);
 		}
 
 		void RadiusSearch(const Vector3& query_point, PointT radius, std::vector<size_t>& results) const {
@@ -176,6 +251,10 @@ namespace fedes {
 			return element_type_;
 		}
 
+		const std::vector<ElementCache>& element_cache() const {
+			return element_cache_;
+		}
+
 		// ====================================================================
 		// Iterators & traversals 
 		// ====================================================================
@@ -289,6 +368,17 @@ namespace fedes {
 			root_ = new Octant(center, extent / 2);
 		}
 
+		void MaxElementExtent() {
+			for (const auto& element : *elements_) {
+				Vector3 min = (*points_)[element[0]];
+				Vector3 max = (*points_)[element[0]];
+				for (const auto& n : element) {
+					MinMax(min, max, (*points_)[n]);
+				}
+				max_element_extent_ = std::max(max_element_extent_, static_cast<double>(fedes::Distance(min, max)));
+			}
+		}
+
 		void NodeElementMap() {
 			node_elements_.resize(points_->size());
 
@@ -310,6 +400,73 @@ namespace fedes {
 			}
 		}
 		
+		void CacheElements() {
+			element_cache_.resize(elements_->size());
+			for (size_t e = 0; e < elements_->size(); ++e) {
+				element_cache_[e] = CacheElement(*points_, (*elements_)[e], element_type_);
+			}
+		}
+
+		void ParallelCacheElements() {
+			element_cache_.resize(elements_->size());
+			fedes::ParallelFor(*pool_, 0, elements_->size(),
+				[&](const size_t a, const size_t b)
+				{
+					for (size_t e = a; e < b; ++e) {
+						element_cache_[e] = CacheElement(*points_, (*elements_)[e], element_type_);
+					}
+				}).wait();
+		}
+
+		/*
+		 * @brief Candidate elements of a leaf, i.e. all elements touching any of its points, in the order MUESF visits them
+		 */
+		std::vector<size_t> LeafCandidates(const Octant& leaf) const {
+			std::vector<size_t> candidates;
+			std::unordered_set<size_t> seen;
+			for (const auto& p : leaf.points) {
+				for (const auto& e : node_elements_[p]) {
+					if (seen.insert(e).second) {
+						candidates.emplace_back(e);
+					}
+				}
+			}
+			return candidates;
+		}
+
+		void PackLeafBlocks() {
+			for (post_order_iterator it = post_begin(); it != post_end(); ++it) {
+				const Octant* octant = it.operator->();
+				if (octant->IsLeaf() && !octant->IsEmpty()) {
+					leaf_blocks_.emplace(octant, PackElementBlocks(LeafCandidates(*octant), element_cache_));
+				}
+			}
+		}
+
+		void ParallelPackLeafBlocks() {
+			std::vector<const Octant*> leaves;
+			for (post_order_iterator it = post_begin(); it != post_end(); ++it) {
+				const Octant* octant = it.operator->();
+				if (octant->IsLeaf() && !octant->IsEmpty()) {
+					leaves.emplace_back(octant);
+				}
+			}
+
+			std::vector<std::vector<ElementBlock>> blocks(leaves.size());
+			fedes::ParallelFor(*pool_, 0, leaves.size(),
+				[&](const size_t a, const size_t b)
+				{
+					for (size_t l = a; l < b; ++l) {
+						blocks[l] = PackElementBlocks(LeafCandidates(*leaves[l]), element_cache_);
+					}
+				}).wait();
+
+			leaf_blocks_.reserve(leaves.size());
+			for (size_t l = 0; l < leaves.size(); ++l) {
+				leaf_blocks_.emplace(leaves[l], std::move(blocks[l]));
+			}
+		}
+		
 		/*
 		* @brief Inserts a point starting from the given Octant
 		* @param octant: the Octant to insert into from. The root at the start, and in recursive cases, any arbitrary Octant.
@@ -441,6 +598,48 @@ namespace fedes {
 			return best;
 		}
 
+		/*
+		 * @brief Best-first search like NearestNeighbour, keeping a max-heap of the k best candidates, whose top (the current k-th
+		 * nearest) bounds the octants still to be visited
+		 */
+		void KNearestNeighbours(const Vector3& query_point, size_t k, std::vector<std::pair<size_t, PointT>>& results) const {
+			results.clear();
+			if (k == 0) {
+				return;
+			}
+			auto closer = [](const std::pair<size_t, PointT>& a, const std::pair<size_t, PointT>& b) { return a.second < b.second; };
+			std::priority_queue<Octant*, std::vector<Octant*>, OctantComparator<PointT>> pq(query_point);
+			pq.push(root_);
+
+			while (!pq.empty() && (results.size() < k || results.front().second > pq.top()->MinimumDistanceSq(query_point))) {
+				Octant* node = pq.top();
+				pq.pop();
+
+				if (node->IsLeaf()) {
+					for (const auto& p : node->points) {
+						PointT dist_sq = fedes::DistanceSquared(query_point, (*points_)[p]);
+						if (results.size() < k) {
+							results.emplace_back(p, dist_sq);
+							std::push_heap(results.begin(), results.end(), closer);
+						} else if (dist_sq < results.front().second) {
+							std::pop_heap(results.begin(), results.end(), closer);
+							results.back() = { p, dist_sq };
+							std::push_heap(results.begin(), results.end(), closer);
+						}
+					}
+				} else { // Enqueue interior nodes
+					for (size_t i = 0; i < 8; ++i) {
+						pq.push(node->child[i]);
+					}
+				}
+			}
+
+			std::sort_heap(results.begin(), results.end(), closer);
+			for (auto& result : results) {
+				result.second = std::sqrt(result.second);
+			}
+		}
+
 
 		size_t DMUESearch(const Vector3& query_point, size_t scan_number) const {
 			assert(!node_elements_.empty());
@@ -484,116 +683,217 @@ namespace fedes {
 
 
 		/*
+		 * @brief Single pass MUESF: candidates are scored by how far the bounds would have to be relaxed for them to contain
+		 * the point (see BoundsViolation). The first candidate containing the point within the FEDES v2 base bounds is returned
+		 * straight away, otherwise the least relaxed candidate is returned once the search is exhausted, with no rescans.
 		 * @param max_leaf_scans: in case geometry differs, without this parameter, the whole tree would be unnecessarily searched before boundaries are relaxed. 
+		 * @param max_relaxation: candidates needing a larger relaxation are not considered to contain the point, the closest one
+		 * is returned instead with its local coordinates projected onto the element (MuesfData::projected)
 		 */
-		std::pair<size_t, MuesfData> MUESFSearch(const Vector3& query_point, size_t max_leaf_scans = 1000) const {
+		std::pair<size_t, MuesfData> MUESFSearch(const Vector3& query_point, size_t max_leaf_scans = 1000, double max_relaxation = 0.25) const {
 			assert(!node_elements_.empty());
-			bool found = false;
 			std::unordered_set<size_t> considered_elements;
 			std::priority_queue<Octant*, std::vector<Octant*>, OctantComparator<PointT>> pq(query_point);
 			size_t scanned_leaves = 0;
 			pq.push(root_);
 
-			// Tetrahedron
-			double g3 = -0.01;
-			double h3 = -0.01;
-			double r3 = -0.01;
-			double g_h_r3 = 1.01;
-
-			// Wedge
-			double g4 = -0.01;
-			double h4 = -0.01;
-			double r4 = -1.01;
-			double gg4 = 1.01;
-			double hh4 = 1.01;
-			double rr4 = 1.01;
-
-			// Hexahedron
-			double g5 = -1.01;
-			double h5 = -1.01;
-			double r5 = -1.01;
-			double gg5 = 1.01;
-			double hh5 = 1.01;
-			double rr5 = 1.01;
-
-			std::optional<MuesfData> opt;
-
-			while (!found) {
-
-				if (pq.empty() || scanned_leaves > max_leaf_scans) { // || scanned_leaves > x || some real formula (?)
-					FEDES_DEBUG("[MUESF] Geometries are different. Node is not contained inside any examined element. Search must be relaxed.");
-					pq.push(root_);
-					considered_elements.clear();
-					scanned_leaves = 0;
-
-					// Tetrahedron
-					g3 = g3 - 0.05;
-					h3 = h3 - 0.05;
-					r3 = r3 - 0.05;
-					g_h_r3 = g_h_r3 + 0.05;
-
-					// Wedge
-					g4 = g4 - 0.05;
-					h4 = h4 - 0.05;
-					r4 = r4 - 0.05;
-					gg4 = gg4 + 0.05;
-					hh4 = hh4 + 0.05;
-					rr4 = rr4 + 0.05;
-
-					// Hexahedron
-					g5 = g5 - 0.05;
-					h5 = h5 - 0.05;
-					r5 = r5 - 0.05;
-					gg5 = gg5 + 0.05;
-					hh5 = hh5 + 0.05;
-					rr5 = rr5 + 0.05;
-				}
+			const ContainmentBounds bounds = BaseContainmentBounds();
+			const ContainmentBounds relaxed = Relax(bounds, max_relaxation);
+			const double padding = BoundingBoxPadding(relaxed);
+
+			// An element containing the point within max_relaxation has all of its nodes within this distance of it, no Octant
+			// further away can introduce a new candidate
+			const PointT reach = static_cast<PointT>(max_element_extent_ * (1.0 + 2.0 * padding));
+			const PointT reach_sq = reach * reach;
+
+			MuesfCandidate best{ .element = 0, .local = MuesfData{}, .violation = std::numeric_limits<double>::infinity() };
 
+			while (!pq.empty() && scanned_leaves < max_leaf_scans) {
 				Octant* node = pq.top();
+				if (node->MinimumDistanceSq(query_point) > reach_sq) {
+					break;
+				}
 				pq.pop();
 
-				if (node->IsLeaf()) {
-					scanned_leaves++;
-					for (const auto& p : node->points) {
-						for (const auto& e : node_elements_[p]) {
-							if (considered_elements.contains(e)) {
-								continue;
-							} else { 
-								considered_elements.insert(e);
-								switch (element_type_) {
-								case ElementType::Tetrahedron:
-									 opt = TetrahedronContainment(*points_, (*elements_)[e],
-										query_point, g3, h3, r3, g_h_r3);
-									if (opt.has_value()) {
-										return { e, *opt };
-									}
-									break;
-								case ElementType::Wedge:
-									opt = WedgeContainment(*points_, (*elements_)[e],
-										query_point, g4, h4, r4, gg4, hh4, rr4);
-									if (opt.has_value()) {
-										return { e, *opt };
-									}
-									break;
-								case ElementType::Hexahedron:
-									opt = HexahedronContainment(*points_, (*elements_)[e],
-										query_point, g5, h5, r5, gg5, hh5, rr5);
-									if (opt.has_value()) {
-										return { e, *opt };
-									}
-									break;
-								}
+				if (!node->IsLeaf()) { // Enqueue interior nodes
+					for (size_t i = 0; i < 8; ++i) {
+						pq.push(node->child[i]);
+					}
+					continue;
+				}
 
-							}
+				scanned_leaves++;
+				if (!leaf_blocks_.empty()) {
+					// Packed path: candidates are already deduplicated per leaf, elements shared between leaves are simply
+					// re-scored, which yields the same violation as before
+					auto blocks = leaf_blocks_.find(node);
+					if (blocks != leaf_blocks_.end() && ScoreLeafBlocks(blocks->second, query_point, bounds, padding, max_relaxation, best)) {
+						return { best.element, best.local };
+					}
+					continue;
+				}
+
+				for (const auto& p : node->points) {
+					for (const auto& e : node_elements_[p]) {
+						if (!considered_elements.insert(e).second) {
+							continue;
+						}
+						MuesfData local = LocalCoordinates(e, query_point);
+						double violation = BoundsViolation(local, bounds);
+						if (violation < 0) {
+							FEDES_INFO("[MUESF] Query point {} is contained inside element {}", query_point, e);
+							return { e, local };
+						}
+						if (violation < best.violation) {
+							best = { e, local, violation };
 						}
 					}
-				} else { // Enqueue interior nodes
-					for (size_t i = 0; i < 8; ++i) {
-						pq.push(node->child[i]);
+				}
+			}
+
+			if (best.violation <= max_relaxation) {
+				FEDES_DEBUG("[MUESF] Query point {} is contained inside element {} after relaxing the bounds by {}", query_point, best.element, best.violation);
+				best.local.relaxation = best.violation;
+				return { best.element, best.local };
+			}
+
+			if (best.violation == std::numeric_limits<double>::infinity()) {
+				// Nothing in reach (far outside the source), fall back to the elements of the nearest node
+				for (const auto& e : node_elements_[NearestNeighbour(query_point)]) {
+					MuesfData local = LocalCoordinates(e, query_point);
+					double violation = BoundsViolation(local, bounds);
+					if (violation < best.violation) {
+						best = { e, local, violation };
 					}
 				}
 			}
 
+			FEDES_DEBUG("[MUESF] Query point {} is outside of the source, projecting onto the closest element {} (relaxation {})", query_point, best.element, best.violation);
+			MuesfData projected = ProjectLocalCoordinates(best.local, element_type_);
+			projected.relaxation = best.violation;
+			projected.projected = true;
+			return { best.element, projected };
+		}
+
+		struct MuesfCandidate {
+			size_t element;
+			MuesfData local;
+			double violation;
+		};
+
+		/*
+		 * @brief The FEDES v2 initial containment bounds of the element type
+		 */
+		ContainmentBounds BaseContainmentBounds() const {
+			constexpr double inf = std::numeric_limits<double>::infinity();
+			switch (element_type_) {
+			case ElementType::Wedge:
+				// Exact wedge mapping also bounds the triangle (g + h), which the linearised v2 formula could not express
+				return { {-0.01, -0.01, -1.01}, {1.01, 1.01, 1.01}, inf, element_cache_.empty() ? inf : 1.01 };
+			case ElementType::Hexahedron:
+				return { {-1.01, -1.01, -1.01}, {1.01, 1.01, 1.01}, inf };
+			case ElementType::Tetrahedron:
+			default:
+				return { {-0.01, -0.01, -0.01}, {inf, inf, inf}, 1.01 };
+			}
+		}
+
+		/*
+		 * @brief Bounding box padding of the element type for the given bounds, tetrahedra are bounded like their
+		 * 4 node simplex: the negative mass of their barycentric coordinates
+		 */
+		double BoundingBoxPadding(const ContainmentBounds& bounds) const {
+			switch (element_type_) {
+			case ElementType::Wedge:
+				return fedes::BoundingBoxPadding<ElementType::Wedge>(bounds);
+			case ElementType::Hexahedron:
+				return fedes::BoundingBoxPadding<ElementType::Hexahedron>(bounds);
+			case ElementType::Tetrahedron:
+			default:
+				return std::max(0.0, -bounds.lower[0]) + std::max(0.0, -bounds.lower[1]) + std::max(0.0, -bounds.lower[2]) + std::max(0.0, bounds.sum - 1);
+			}
+		}
+
+		/*
+		 * @brief Local coordinates of the query point for the given element, exact when the element cache is enabled
+		 * and the FEDES v2 (linearised for wedges/hexahedra) formulas otherwise
+		 */
+		MuesfData LocalCoordinates(size_t e, const Vector3& query_point) const {
+			if (!element_cache_.empty()) {
+				return ExactLocalCoordinates(e, query_point, element_cache_[e].LocalCoordinates(query_point)).value_or(element_cache_[e].LocalCoordinates(query_point));
+			}
+			switch (element_type_) {
+			case ElementType::Wedge:
+				return WedgeLocalCoordinates(*points_, (*elements_)[e], query_point);
+			case ElementType::Hexahedron:
+				return HexahedronLocalCoordinates(*points_, (*elements_)[e], query_point);
+			case ElementType::Tetrahedron:
+			default:
+				return TetrahedronLocalCoordinates(*points_, (*elements_)[e], query_point);
+			}
+		}
+
+		/*
+		 * @brief Refines the linear estimate of the cached map: identity for tetrahedra, Newton inverse mapping otherwise
+		 * @return empty if the Newton iteration diverged (the point is far outside of the element)
+		 */
+		std::optional<MuesfData> ExactLocalCoordinates(size_t e, const Vector3& query_point, const MuesfData& initial) const {
+			switch (element_type_) {
+			case ElementType::Wedge:
+				return InverseMap<ElementType::Wedge>(*points_, (*elements_)[e], query_point, initial);
+			case ElementType::Hexahedron:
+				return InverseMap<ElementType::Hexahedron>(*points_, (*elements_)[e], query_point, initial);
+			case ElementType::Tetrahedron:
+			default:
+				return initial;
+			}
+		}
+
+		/*
+		 * @brief Scores the packed candidates of a leaf, updating the best candidate
+		 * @param padding: bounding box padding for max_relaxation, lanes whose box rejects the point keep their linear estimate,
+		 * bumped past max_relaxation, without running the Newton inverse mapping
+		 * @return true if a candidate contains the point within the given bounds, which is then stored in `best`
+		 */
+		bool ScoreLeafBlocks(const std::vector<ElementBlock>& blocks, const Vector3& query_point, const ContainmentBounds& bounds,
+			                 double padding, double max_relaxation, MuesfCandidate& best) const {
+			const bool affine = element_type_ == ElementType::Tetrahedron;
+			const double rejected = std::nextafter(max_relaxation, std::numeric_limits<double>::infinity());
+			std::array<std::array<double, element_block_width>, 3> local;
+			std::array<double, element_block_width> violation;
+
+			for (const ElementBlock& block : blocks) {
+				BlockViolation(block, query_point, bounds, local, violation);
+				uint_fast8_t boxes = affine ? 0 : BlockBoxContainment(block, query_point, padding);
+
+				for (size_t lane = 0; lane < block.count; ++lane) {
+					MuesfData lane_local{ .g = local[0][lane], .h = local[1][lane], .r = local[2][lane] };
+					double lane_violation = violation[lane];
+					if (!affine) {
+						if (boxes & (1u << lane)) {
+							std::optional<MuesfData> exact = ExactLocalCoordinates(block.ids[lane], query_point, lane_local);
+							if (exact.has_value()) {
+								lane_local = *exact;
+								lane_violation = BoundsViolation(lane_local, bounds);
+							} else {
+								lane_violation = std::max(lane_violation, rejected);
+							}
+						} else {
+							lane_violation = std::max(lane_violation, rejected);
+						}
+					}
+
+					if (lane_violation < 0) {
+						FEDES_INFO("[MUESF] Query point {} is contained inside cached element {} (block lane {})", query_point, block.ids[lane], lane);
+						best = { block.ids[lane], lane_local, lane_violation };
+						return true;
+					}
+					if (lane_violation < best.violation) {
+						best = { block.ids[lane], lane_local, lane_violation };
+					}
+				}
+			}
+			return false;
 		}
 
 		// @return: Point ID and Euclidean Distance to query point for each quadrant
@@ -626,6 +926,151 @@ namespace fedes {
 			return field;
 		}
 		
+		/*
+		 * @brief Best-first search for the nearest point in each of the 8 directions around the query point
+		 *
+		 * Octants are visited by increasing minimum distance, and only for the directions they overlap that may still be
+		 * improved on. The search terminates once every direction is settled (the next Octant is further away than its best
+		 * point) or provably empty (no remaining Octant overlaps it).
+		 */
+		[[nodiscard]] std::array<std::pair<size_t, PointT>, 8> DirectionalFieldSearch(const Vector3& query) const {
+			std::array<std::pair<size_t, PointT>, 8> field;
+			std::array<PointT, 8> best_sq;
+			best_sq.fill(std::numeric_limits<PointT>::max());
+
+			// Directions for which an Octant at the given squared distance could still yield a closer point
+			auto open = [&](PointT dist_sq) {
+				uint_fast8_t mask = 0;
+				for (uint_fast8_t dir = 0; dir < 8; ++dir) {
+					if (dist_sq < best_sq[dir]) {
+						mask |= 1 << dir;
+					}
+				}
+				return mask;
+			};
+
+			std::priority_queue<Octant*, std::vector<Octant*>, OctantComparator<PointT>> pq(query);
+			pq.push(root_);
+
+			while (!pq.empty()) {
+				Octant* node = pq.top();
+				pq.pop();
+				uint_fast8_t unsettled = open(node->MinimumDistanceSq(query));
+				if (unsettled == 0) { // Every remaining Octant is at least as far away, all directions are settled
+					break;
+				}
+				uint_fast8_t directions = node->DirectionMask(query) & unsettled;
+				if (directions == 0) {
+					continue;
+				}
+
+				if (node->IsLeaf()) {
+					for (const auto& p : node->points) {
+						uint_fast8_t dir = fedes::DetermineDirection(query, (*points_)[p]);
+						if (!(directions & (1 << dir))) {
+							continue;
+						}
+						PointT dist_sq = fedes::DistanceSquared(query, (*points_)[p]);
+						if (dist_sq < best_sq[dir]) {
+							best_sq[dir] = dist_sq;
+							field[dir].first = p;
+						}
+					}
+				} else { // Enqueue interior nodes that can still contribute
+					for (uint_fast8_t i = 0; i < 8; ++i) {
+						const Octant* child = node->child[i];
+						if (!(child->IsLeaf() && child->IsEmpty()) && (child->DirectionMask(query) & open(child->MinimumDistanceSq(query)))) {
+							pq.push(node->child[i]);
+						}
+					}
+				}
+			}
+
+			for (uint_fast8_t i = 0; i < 8; ++i) {
+				if (best_sq[i] != std::numeric_limits<PointT>::max()) {
+					field[i].second = std::sqrt(best_sq[i]);
+				}
+			}
+			return field;
+		}
+
+		[[nodiscard]] std::array<std::pair<size_t, PointT>, 8> AdaptiveFieldSearch(const Vector3& query, size_t k, PointT growth) const {
+			std::array<std::pair<size_t, PointT>, 8> field;
+			std::array<PointT, 8> best_sq;
+			best_sq.fill(std::numeric_limits<PointT>::max());
+
+			// Initial radius from the local density around the query
+			const Octant& leaf = OctantContainingPoint(query, *root_);
+			PointT radius = 2 * std::sqrt(leaf.extent.x * leaf.extent.x + leaf.extent.y * leaf.extent.y + leaf.extent.z * leaf.extent.z);
+			if (k > 0 && leaf.points.size() >= k) {
+				std::vector<PointT> distances_sq;
+				distances_sq.reserve(leaf.points.size());
+				for (const auto& p : leaf.points) {
+					distances_sq.emplace_back(fedes::DistanceSquared(query, (*points_)[p]));
+				}
+				std::nth_element(distances_sq.begin(), distances_sq.begin() + (k - 1), distances_sq.end());
+				radius = std::sqrt(distances_sq[k - 1]);
+			}
+
+			// Beyond the furthest root corner, every point has been examined and empty directions are provably empty
+			Vector3 far(std::max(std::abs(query.x - root_->aabb_min.x), std::abs(query.x - root_->aabb_max.x)),
+				        std::max(std::abs(query.y - root_->aabb_min.y), std::abs(query.y - root_->aabb_max.y)),
+				        std::max(std::abs(query.z - root_->aabb_min.z), std::abs(query.z - root_->aabb_max.z)));
+			const PointT max_radius = std::sqrt(far.x * far.x + far.y * far.y + far.z * far.z);
+			radius = std::max(radius, std::numeric_limits<PointT>::epsilon() * max_radius);
+			growth = std::max(growth, static_cast<PointT>(1.1));
+
+			uint_fast8_t empty = 0xFF;
+			while (empty != 0) {
+				PointT radius_sq = radius * radius;
+				MaskedRadiusSearch(*root_, query, radius, radius_sq, empty, field, best_sq);
+				for (uint_fast8_t dir = 0; dir < 8; ++dir) {
+					if (best_sq[dir] != std::numeric_limits<PointT>::max()) {
+						empty &= ~(1 << dir);
+					}
+				}
+				if (radius >= max_radius) {
+					break;
+				}
+				radius = std::min(radius * growth, max_radius);
+			}
+
+			for (uint_fast8_t i = 0; i < 8; ++i) {
+				if (best_sq[i] != std::numeric_limits<PointT>::max()) {
+					field[i].second = std::sqrt(best_sq[i]);
+				}
+			}
+			return field;
+		}
+
+		/*
+		 * @brief Radius search restricted to the given directions, keeping the nearest point within the radius per direction.
+		 * Unlike RadiusSearch, points are filtered by their actual distance, so that any point found is the nearest of its direction.
+		 */
+		void MaskedRadiusSearch(const Octant& octant, const Vector3& query, PointT radius, PointT radius_sq, uint_fast8_t mask,
+			                    std::array<std::pair<size_t, PointT>, 8>& field, std::array<PointT, 8>& best_sq) const {
+			if (octant.IsLeaf()) {
+				for (const auto& p : octant.points) {
+					uint_fast8_t dir = fedes::DetermineDirection(query, (*points_)[p]);
+					if (!(mask & (1 << dir))) {
+						continue;
+					}
+					PointT dist_sq = fedes::DistanceSquared(query, (*points_)[p]);
+					if (dist_sq <= radius_sq && dist_sq < best_sq[dir]) {
+						best_sq[dir] = dist_sq;
+						field[dir].first = p;
+					}
+				}
+			} else {
+				for (uint_fast8_t i = 0; i < 8; ++i) {
+					const Octant& child = *octant.child[i];
+					if (!(child.IsLeaf() && child.IsEmpty()) && (child.DirectionMask(query) & mask) && child.WithinSphere(query, radius, radius_sq)) {
+						MaskedRadiusSearch(child, query, radius, radius_sq, mask, field, best_sq);
+					}
+				}
+			}
+		}
+
 		void RadiusSearch(const Octant& octant, const Vector3& query_point, PointT radius, PointT radius_sq, std::vector<size_t>& results) const {
 			if (octant.IsLeaf()) {
 				for (const auto& p : octant.points) {
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "fedes/maths/element_type.h"
+
+namespace fedes {
+
+	/*
+	 * @brief Face of an element on the boundary of the mesh, i.e. not shared with any other element
+	 */
+	struct BoundaryFace {
+	public:
+		std::array<size_t, 4> nodes;
+		uint_fast8_t count; // @brief: 3 for triangles, 4 for quadrilaterals
+		size_t element;
+	};
+
+	/*
+	 * @brief Triangle of the boundary surface, quadrilateral faces are split in two
+	 */
+	struct SurfaceTriangle {
+	public:
+		std::array<size_t, 3> nodes;
+		size_t element;
+	};
+
+	namespace internal {
+
+		using FaceNodes = std::array<uint_fast8_t, 4>;
+		constexpr uint_fast8_t kNoNode = std::numeric_limits<uint_fast8_t>::max();
+
+		// Local node indexes of the faces of every element type, in the node order of the isoparametric elements
+		constexpr std::array<FaceNodes, 4> kTetrahedronFaces = { {
+			{ 0, 2, 1, kNoNode }, { 0, 1, 3, kNoNode }, { 1, 2, 3, kNoNode }, { 0, 3, 2, kNoNode }
+		} };
+		constexpr std::array<FaceNodes, 5> kWedgeFaces = { {
+			{ 0, 2, 1, kNoNode }, { 3, 4, 5, kNoNode }, { 0, 1, 4, 3 }, { 1, 2, 5, 4 }, { 0, 3, 5, 2 }
+		} };
+		constexpr std::array<FaceNodes, 6> kHexahedronFaces = { {
+			{ 0, 3, 2, 1 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 }, { 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 0, 4, 7, 3 }
+		} };
+
+		inline std::span<const FaceNodes> ElementFaces(ElementType element_type) {
+			switch (element_type) {
+			case ElementType::Wedge:
+				return kWedgeFaces;
+			case ElementType::Hexahedron:
+				return kHexahedronFaces;
+			case ElementType::Tetrahedron:
+			default:
+				return kTetrahedronFaces;
+			}
+		}
+
+		/*
+		 * @brief Face key independent of the node order, the sorted node IDs padded with the maximum value for triangles
+		 */
+		struct FaceKeyHash {
+			size_t operator()(const std::array<size_t, 4>& key) const noexcept {
+				size_t hash = 0;
+				for (const size_t& id : key) {
+					hash ^= std::hash<size_t>{}(id) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+				}
+				return hash;
+			}
+		};
+	}
+
+	/*
+	 * @brief Faces of the mesh belonging to exactly one element, which make up the boundary surface of the source geometry.
+	 * Only the corner nodes of the elements are used.
+	 * @return the boundary faces in element order
+	 */
+	inline std::vector<BoundaryFace> BoundaryFaces(const std::vector<std::vector<size_t>>& elements) {
+		std::vector<BoundaryFace> faces;
+		if (elements.empty()) {
+			return faces;
+		}
+		const ElementType element_type = DetermineElementType(elements);
+		const std::span<const internal::FaceNodes> local_faces = internal::ElementFaces(element_type);
+
+		// Occurrences of every face and the first face seen with it, interior faces are counted twice
+		std::unordered_map<std::array<size_t, 4>, std::pair<size_t, size_t>, internal::FaceKeyHash> occurrences;
+		occurrences.reserve(elements.size() * local_faces.size());
+		faces.reserve(elements.size() * local_faces.size());
+		for (size_t e = 0; e < elements.size(); ++e) {
+			for (const internal::FaceNodes& local : local_faces) {
+				BoundaryFace face{ .nodes = { 0, 0, 0, 0 }, .count = static_cast<uint_fast8_t>(local[3] == internal::kNoNode ? 3 : 4), .element = e };
+				std::array<size_t, 4> key;
+				key.fill(std::numeric_limits<size_t>::max());
+				for (uint_fast8_t n = 0; n < face.count; ++n) {
+					face.nodes[n] = key[n] = elements[e][local[n]];
+				}
+				std::sort(key.begin(), key.begin() + face.count);
+
+				auto [it, inserted] = occurrences.try_emplace(key, 0, faces.size());
+				++it->second.first;
+				if (inserted) {
+					faces.push_back(face);
+				}
+			}
+		}
+
+		std::vector<BoundaryFace> boundary;
+		for (const auto& [key, occurrence] : occurrences) {
+			if (occurrence.first == 1) {
+				boundary.push_back(faces[occurrence.second]);
+			}
+		}
+		std::sort(boundary.begin(), boundary.end(), [](const BoundaryFace& a, const BoundaryFace& b) {
+			return a.element != b.element ? a.element < b.element : a.nodes < b.nodes;
+		});
+		return boundary;
+	}
+
+	/*
+	 * @brief Triangulated boundary surface, every quadrilateral split along its 0-2 diagonal
+	 */
+	inline std::vector<SurfaceTriangle> BoundaryTriangles(const std::vector<std::vector<size_t>>& elements) {
+		std::vector<SurfaceTriangle> triangles;
+		for (const BoundaryFace& face : BoundaryFaces(elements)) {
+			triangles.push_back({ { face.nodes[0], face.nodes[1], face.nodes[2] }, face.element });
+			if (face.count == 4) {
+				triangles.push_back({ { face.nodes[0], face.nodes[2], face.nodes[3] }, face.element });
+			}
+		}
+		return triangles;
+	}
+}
@@ -1,12 +1,16 @@
 #pragma once
 
 #include <concepts>
+#include <optional>
 
 #include <BS_thread_pool.hpp>
 
 #include "fedes/indexing/octree/octree.h"
 #include "fedes/indexing/octree/octant.h"
 #include "fedes/model/model.h"
+#include "fedes/common/scheduling.h"
+#include "fedes/indexing/surface/bvh.h"
+#include "fedes/interpolations/octree/outside.h"
 
 namespace fedes {
 
@@ -38,23 +42,32 @@ namespace fedes {
 	}
 
 
+	/*
+	 * @param surface: boundary surface index of the source, target points outside of it are weighted over the element of the
+	 * closest surface point (see internal::ProjectOutside) rather than scanning elements for them
+	 */
 	template <std::floating_point T = double>
-	void ParallelDMUE(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, BS::thread_pool& pool, size_t scan_min = 50) {
+	void ParallelDMUE(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, BS::thread_pool& pool, size_t scan_min = 50,
+		              TargetOrder order = TargetOrder::File, const fedes::SurfaceBVH* surface = nullptr) {
 		if (source.ByNode()) {
 			std::cout << "Target node count: " << target.nodes.size() << '\n';
 			// std::cout << "Minimum element scans: " << scan_min << '\n';
 
-			pool.parallelize_loop(0, target.nodes.size(),
+			const std::vector<size_t> node_order = fedes::TargetPermutation(target.nodes, order);
+			fedes::ParallelFor(pool, 0, target.nodes.size(),
 				[&](const uint32_t& a, const uint32_t& b)
 				{
-					for (uint32_t i = a; i < b; i++) {
+					for (uint32_t p = a; p < b; p++) {
+						const size_t i = node_order.empty() ? p : node_order[p];
 						int_fast64_t coincide = octree.Find(target.nodes[i]);
 						if (coincide != -1) {
 							target.displacement[i] = source.displacement[coincide];
 							continue;
 						}
 
-						size_t best_element = octree.DMUE(target.nodes[i], scan_min);
+						fedes::Vector3<T> surface_point = target.nodes[i];
+						const std::optional<size_t> outside = internal::ProjectOutside(surface, surface_point);
+						size_t best_element = outside.has_value() ? *outside : octree.DMUE(target.nodes[i], scan_min);
 						FEDES_INFO("Target node index {} ({}) selected element = {}", i, target.nodes[i], best_element);
 						std::pair<std::vector<T>, T> coefficents = ProportionalDistanceCoefficents(source.elements[best_element], source, target.nodes[i]);
 						
@@ -76,11 +89,13 @@ namespace fedes {
 			bool accumulated_strain_map = !source.accumulated_strain.empty();
 			bool total_strain_map = !source.total_strain.empty();
 
-			pool.parallelize_loop(0, target.integration.size(),
+			const std::vector<size_t> integration_order = fedes::TargetPermutation(target.integration, order);
+			fedes::ParallelFor(pool, 0, target.integration.size(),
 				[&](const uint32_t& a, const uint32_t& b)
 				{
 
-					for (uint32_t i = a; i < b; i++) {
+					for (uint32_t p = a; p < b; p++) {
+						const size_t i = integration_order.empty() ? p : integration_order[p];
 						int_fast64_t coincide = octree.Find(target.integration[i]);
 						if (coincide != -1) {
 							if (stress_map) {
@@ -98,7 +113,9 @@ namespace fedes {
 							continue;
 						}
 
-						size_t best_element = octree.DMUE(target.integration[i], scan_min);
+						fedes::Vector3<T> surface_point = target.integration[i];
+						const std::optional<size_t> outside = internal::ProjectOutside(surface, surface_point);
+						size_t best_element = outside.has_value() ? *outside : octree.DMUE(target.integration[i], scan_min);
 						FEDES_INFO("Target integration index {} ({}) selected element = {}", i, target.integration[i], best_element);
 						std::pair<std::vector<T>, T> coefficents = ProportionalDistanceCoefficents(source.elements[best_element], source, target.integration[i]);
 
@@ -141,7 +158,8 @@ namespace fedes {
 	}
 
 	template <std::floating_point T = double>
-	void DMUE(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, size_t scan_min = 50) {
+	void DMUE(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, size_t scan_min = 50,
+		      const fedes::SurfaceBVH* surface = nullptr) {
 		if (source.ByNode()) {
 			std::cout << "Target node count: " << target.nodes.size() << '\n';
 			std::cout << "Target displacement count: " << target.displacement.size() << '\n';
@@ -153,7 +171,9 @@ namespace fedes {
 					continue;
 				}
 
-				size_t best_element = octree.DMUE(target.nodes[i], scan_min);
+				fedes::Vector3<T> surface_point = target.nodes[i];
+				const std::optional<size_t> outside = internal::ProjectOutside(surface, surface_point);
+				size_t best_element = outside.has_value() ? *outside : octree.DMUE(target.nodes[i], scan_min);
 				FEDES_INFO("Target node index {} ({}) selected element = {}", i, target.nodes[i], best_element);
 				std::pair<std::vector<T>, T> coefficents = ProportionalDistanceCoefficents(source.elements[best_element], source, target.nodes[i]);
 
@@ -192,7 +212,9 @@ namespace fedes {
 					continue;
 				}
 
-				size_t best_element = octree.DMUE(target.integration[i], scan_min);
+				fedes::Vector3<T> surface_point = target.integration[i];
+				const std::optional<size_t> outside = internal::ProjectOutside(surface, surface_point);
+				size_t best_element = outside.has_value() ? *outside : octree.DMUE(target.integration[i], scan_min);
 				FEDES_INFO("Target integration index {} ({}) selected element = {}", i, target.integration[i], best_element);
 				std::pair<std::vector<T>, T> coefficents = ProportionalDistanceCoefficents(source.elements[best_element], source, target.integration[i]);
 
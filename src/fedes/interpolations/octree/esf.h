@@ -1,31 +1,44 @@
 #pragma once
 
 #include <concepts>
+#include <optional>
 
 #include <BS_thread_pool.hpp>
 
 #include "fedes/indexing/octree/octree.h"
 #include "fedes/indexing/octree/octant.h"
 #include "fedes/model/model.h"
+#include "fedes/common/scheduling.h"
 #include "fedes/maths/geometry.h"
+#include "fedes/indexing/surface/bvh.h"
+#include "fedes/interpolations/octree/outside.h"
 
 namespace fedes {
 
 	// @Cleanup: use a class for elements
 
+	/*
+	 * @param surface: boundary surface index of the source, target points outside of it take the values at the closest surface
+	 * point (see internal::ProjectOutside) rather than relaxing the MUESF bounds over every leaf in reach
+	 */
 	template <std::floating_point T>
 	void ParallelElementShapeFunction(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, 
-		                             BS::thread_pool& pool, size_t max_leaf_scans_threshold = 1000) {
+		                             BS::thread_pool& pool, size_t max_leaf_scans_threshold = 1000, TargetOrder order = TargetOrder::File,
+		                             const fedes::SurfaceBVH* surface = nullptr) {
 		const ElementType element_type = octree.element_type();
 
 		if (source.ByNode()) {
 			std::cout << "Target node count: " << target.nodes.size() << '\n';
 
-			pool.parallelize_loop(0, target.nodes.size(),
+			const std::vector<size_t> node_order = fedes::TargetPermutation(target.nodes, order);
+			fedes::ParallelFor(pool, 0, target.nodes.size(),
 				[&](const uint32_t& a, const uint32_t& b)
 				{
-					for (uint32_t i = a; i < b; i++) {
-						std::pair<size_t, MuesfData> data = octree.MUESF(target.nodes[i], max_leaf_scans_threshold);
+					for (uint32_t p = a; p < b; p++) {
+						const size_t i = node_order.empty() ? p : node_order[p];
+						fedes::Vector3<T> query_point = target.nodes[i];
+						const std::optional<size_t> outside = internal::ProjectOutside(surface, query_point);
+						std::pair<size_t, MuesfData> data = octree.MUESF(query_point, max_leaf_scans_threshold, 0.25, outside);
 						const double& g = data.second.g;
 						const double& h = data.second.h;
 						const double& r = data.second.r;
@@ -77,13 +90,20 @@ namespace fedes {
 			bool accumulated_strain_map = !source.accumulated_strain.empty();
 			bool total_strain_map = !source.total_strain.empty();
 
-			pool.parallelize_loop(0, target.integration.size(),
+			const std::vector<size_t> integration_order = fedes::TargetPermutation(target.integration, order);
+			fedes::ParallelFor(pool, 0, target.integration.size(),
 				[&](const uint32_t& a, const uint32_t& b)
 				{
-
-					for (uint32_t i = a; i < b; i++) {
+					// Consecutive integration points (e.g. the Gauss points of one target element) mostly lie in the same source
+					// element, which is tested first
+					std::optional<size_t> hint;
+					for (uint32_t p = a; p < b; p++) {
+						const size_t i = integration_order.empty() ? p : integration_order[p];
 						
-						std::pair<size_t, MuesfData> data = octree.MUESF(target.integration[i], max_leaf_scans_threshold);
+						fedes::Vector3<T> query_point = target.integration[i];
+						const std::optional<size_t> outside = internal::ProjectOutside(surface, query_point);
+						std::pair<size_t, MuesfData> data = octree.MUESF(query_point, max_leaf_scans_threshold, 0.25, outside ? outside : hint);
+						hint = data.first;
 						const double& g = data.second.g;
 						const double& h = data.second.h;
 						const double& r = data.second.r;
@@ -210,7 +230,7 @@ namespace fedes {
 
 	template <std::floating_point T = double>
 	void ElementShapeFunction(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target,
-		                      size_t max_leaf_scans_threshold = 1000) {
+		                      size_t max_leaf_scans_threshold = 1000, const fedes::SurfaceBVH* surface = nullptr) {
 		const ElementType element_type = octree.element_type();
 
 		if (source.ByNode()) {
@@ -218,7 +238,9 @@ namespace fedes {
 			std::cout << "Target displacement count: " << target.displacement.size() << '\n';
 
 			for (size_t i = 0; i < target.nodes.size(); ++i) {
-				std::pair<size_t, MuesfData> data = octree.MUESF(target.nodes[i], max_leaf_scans_threshold);
+				fedes::Vector3<T> query_point = target.nodes[i];
+				const std::optional<size_t> outside = internal::ProjectOutside(surface, query_point);
+				std::pair<size_t, MuesfData> data = octree.MUESF(query_point, max_leaf_scans_threshold, 0.25, outside);
 				const double& g = data.second.g;
 				const double& h = data.second.h;
 				const double& r = data.second.r;
@@ -271,9 +293,13 @@ namespace fedes {
 			bool accumulated_strain_map = !source.accumulated_strain.empty();
 			bool total_strain_map = !source.total_strain.empty();
 
+			std::optional<size_t> hint;
 			for (size_t i = 0; i < target.integration.size(); ++i) {
 
-				std::pair<size_t, MuesfData> data = octree.MUESF(target.integration[i], max_leaf_scans_threshold);
+				fedes::Vector3<T> query_point = target.integration[i];
+				const std::optional<size_t> outside = internal::ProjectOutside(surface, query_point);
+				std::pair<size_t, MuesfData> data = octree.MUESF(query_point, max_leaf_scans_threshold, 0.25, outside ? outside : hint);
+				hint = data.first;
 				const double& g = data.second.g;
 				const double& h = data.second.h;
 				const double& r = data.second.r;
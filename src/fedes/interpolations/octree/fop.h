@@ -9,6 +9,7 @@
 #include "fedes/indexing/octree/octree.h"
 #include "fedes/indexing/octree/octant.h"
 #include "fedes/model/model.h"
+#include "fedes/common/scheduling.h"
 #include "fedes/maths/vector3.h"
 
 namespace fedes {
@@ -40,235 +41,305 @@ namespace fedes {
 
 
 
-	template <std::floating_point T = double>
-	void ParallelFieldOfPoints(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, BS::thread_pool& pool, T radius = 10.0) {
-		if (source.ByNode()) {
-			std::cout << "Radius: " << radius << "\n";
-			std::cout << "Target node count: " << target.nodes.size() << '\n';
-
-			pool.parallelize_loop(0, target.nodes.size(),
-				[&](const uint32_t& a, const uint32_t& b)
-				{
-					for (uint32_t i = a; i < b; i++) {
-						int_fast64_t coincide = octree.Find(target.nodes[i]);
-						if (coincide != -1) {
-							target.displacement[i] = source.displacement[coincide];
-							continue;
-						}
+	namespace internal {
+
+		/*
+		 * @brief Parallel FOP interpolation body, shared by the radius and the directional field queries
+		 * @param field_query: returns the field (closest point and its distance in each of the 8 directions) of a target point
+		 * @param order: order to process the target points in
+		 */
+		template <std::floating_point T, typename FieldQuery>
+		void ParallelFieldOfPoints(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, BS::thread_pool& pool,
+			                       FieldQuery&& field_query, TargetOrder order) {
+			if (source.ByNode()) {
+				std::cout << "Target node count: " << target.nodes.size() << '\n';
+
+				const std::vector<size_t> node_order = fedes::TargetPermutation(target.nodes, order);
+				fedes::ParallelFor(pool, 0, target.nodes.size(),
+					[&](const uint32_t& a, const uint32_t& b)
+					{
+						for (uint32_t p = a; p < b; p++) {
+							const size_t i = node_order.empty() ? p : node_order[p];
+							int_fast64_t coincide = octree.Find(target.nodes[i]);
+							if (coincide != -1) {
+								target.displacement[i] = source.displacement[coincide];
+								continue;
+							}
 
-						std::array<std::pair<size_t, T>, 8> field = octree.FieldOfPoints(target.nodes[i], radius);
-						std::pair<std::array<T, 8>, T> coefficents = ProportionalDistanceCoefficents(field);
+							std::array<std::pair<size_t, T>, 8> field = field_query(target.nodes[i]);
+							std::pair<std::array<T, 8>, T> coefficents = ProportionalDistanceCoefficents(field);
 
-						FEDES_INFO("Target node index {} ({}): quadrants 0 ({}), 1 ({}), 2 ({}), 3 ({}), 4 ({}), 5 ({}), 6 ({}), 7 ({})",
-							i, target.nodes[i], source.nodes[field[0].first], source.nodes[field[1].first], source.nodes[field[2].first], source.nodes[field[3].first], 
-							source.nodes[field[4].first], source.nodes[field[5].first], source.nodes[field[6].first], source.nodes[field[7].first]);
+							FEDES_INFO("Target node index {} ({}): quadrants 0 ({}), 1 ({}), 2 ({}), 3 ({}), 4 ({}), 5 ({}), 6 ({}), 7 ({})",
+								i, target.nodes[i], source.nodes[field[0].first], source.nodes[field[1].first], source.nodes[field[2].first], source.nodes[field[3].first], 
+								source.nodes[field[4].first], source.nodes[field[5].first], source.nodes[field[6].first], source.nodes[field[7].first]);
 						
 
-						for (uint_fast8_t j = 0; j < 8; ++j) {
-							if (field[j] != std::pair<size_t, T>()) {
-								for (uint_fast8_t k = 0; k < 3; ++k) {
-									target.displacement[i][k] += source.displacement[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+							for (uint_fast8_t j = 0; j < 8; ++j) {
+								if (field[j] != std::pair<size_t, T>()) {
+									for (uint_fast8_t k = 0; k < 3; ++k) {
+										target.displacement[i][k] += source.displacement[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+									}
 								}
 							}
-						}
-
-					}
-				}).wait();
-		}
 
-		if (source.ByIntegration()) {
-			std::cout << "Target integration count: " << target.integration.size() << '\n';
-			bool stress_map = !source.stress.empty();
-			bool plastic_strain_map = !source.plastic_strain.empty();
-			bool accumulated_strain_map = !source.accumulated_strain.empty();
-			bool total_strain_map = !source.total_strain.empty();
-
-			pool.parallelize_loop(0, target.integration.size(),
-				[&](const uint32_t& a, const uint32_t& b)
-				{
+						}
+					}).wait();
+			}
 
-					for (uint32_t i = a; i < b; i++) {
-						int_fast64_t coincide = octree.Find(target.integration[i]);
-						if (coincide != -1) {
-							if (stress_map) {
-								target.stress[i] = source.stress[coincide];
-							}
-							if (plastic_strain_map) {
-								target.plastic_strain[i] = source.plastic_strain[coincide];
-							}
-							if (total_strain_map) {
-								target.total_strain[i] = source.total_strain[coincide];
-							}
-							if (accumulated_strain_map) {
-								target.accumulated_strain[i] = source.accumulated_strain[coincide];
+			if (source.ByIntegration()) {
+				std::cout << "Target integration count: " << target.integration.size() << '\n';
+				bool stress_map = !source.stress.empty();
+				bool plastic_strain_map = !source.plastic_strain.empty();
+				bool accumulated_strain_map = !source.accumulated_strain.empty();
+				bool total_strain_map = !source.total_strain.empty();
+
+				const std::vector<size_t> integration_order = fedes::TargetPermutation(target.integration, order);
+				fedes::ParallelFor(pool, 0, target.integration.size(),
+					[&](const uint32_t& a, const uint32_t& b)
+					{
+
+						for (uint32_t p = a; p < b; p++) {
+							const size_t i = integration_order.empty() ? p : integration_order[p];
+							int_fast64_t coincide = octree.Find(target.integration[i]);
+							if (coincide != -1) {
+								if (stress_map) {
+									target.stress[i] = source.stress[coincide];
+								}
+								if (plastic_strain_map) {
+									target.plastic_strain[i] = source.plastic_strain[coincide];
+								}
+								if (total_strain_map) {
+									target.total_strain[i] = source.total_strain[coincide];
+								}
+								if (accumulated_strain_map) {
+									target.accumulated_strain[i] = source.accumulated_strain[coincide];
+								}
+								continue;
 							}
-							continue;
-						}
 
-						std::array<std::pair<size_t, T>, 8> field = octree.FieldOfPoints(target.integration[i], radius);
-						std::pair<std::array<T, 8>, T> coefficents = ProportionalDistanceCoefficents(field);
+							std::array<std::pair<size_t, T>, 8> field = field_query(target.integration[i]);
+							std::pair<std::array<T, 8>, T> coefficents = ProportionalDistanceCoefficents(field);
 
-						FEDES_INFO("Target integration index {} ({}): quadrants 0 ({}), 1 ({}), 2 ({}), 3 ({}), 4 ({}), 5 ({}), 6 ({}), 7 ({})",
-							i, target.integration[i], source.nodes[field[0].first], source.nodes[field[1].first], source.nodes[field[2].first], source.nodes[field[3].first],
-							source.nodes[field[4].first], source.nodes[field[5].first], source.nodes[field[6].first], source.nodes[field[7].first]);
+							FEDES_INFO("Target integration index {} ({}): quadrants 0 ({}), 1 ({}), 2 ({}), 3 ({}), 4 ({}), 5 ({}), 6 ({}), 7 ({})",
+								i, target.integration[i], source.nodes[field[0].first], source.nodes[field[1].first], source.nodes[field[2].first], source.nodes[field[3].first],
+								source.nodes[field[4].first], source.nodes[field[5].first], source.nodes[field[6].first], source.nodes[field[7].first]);
 						
-						if (stress_map) {
-							for (uint_fast8_t j = 0; j < 8; ++j) {
-								if (field[j] != std::pair<size_t, T>()) {
-									for (uint_fast8_t k = 0; k < 6; ++k) {
-										target.stress[i][k] += source.stress[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+							if (stress_map) {
+								for (uint_fast8_t j = 0; j < 8; ++j) {
+									if (field[j] != std::pair<size_t, T>()) {
+										for (uint_fast8_t k = 0; k < 6; ++k) {
+											target.stress[i][k] += source.stress[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+										}
 									}
 								}
 							}
-						}
 
-						if (plastic_strain_map) {
-							for (uint_fast8_t j = 0; j < 8; ++j) {
-								if (field[j] != std::pair<size_t, T>()) {
-									for (uint_fast8_t k = 0; k < 6; ++k) {
-										target.plastic_strain[i][k] += source.plastic_strain[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+							if (plastic_strain_map) {
+								for (uint_fast8_t j = 0; j < 8; ++j) {
+									if (field[j] != std::pair<size_t, T>()) {
+										for (uint_fast8_t k = 0; k < 6; ++k) {
+											target.plastic_strain[i][k] += source.plastic_strain[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+										}
 									}
 								}
 							}
-						}
 
-						if (total_strain_map) {
-							for (uint_fast8_t j = 0; j < 8; ++j) {
-								if (field[j] != std::pair<size_t, T>()) {
-									for (uint_fast8_t k = 0; k < 6; ++k) {
-										target.total_strain[i][k] += source.total_strain[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+							if (total_strain_map) {
+								for (uint_fast8_t j = 0; j < 8; ++j) {
+									if (field[j] != std::pair<size_t, T>()) {
+										for (uint_fast8_t k = 0; k < 6; ++k) {
+											target.total_strain[i][k] += source.total_strain[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+										}
 									}
 								}
 							}
-						}
 
-						if (accumulated_strain_map) {
-							for (uint_fast8_t j = 0; j < 8; ++j) {
-								if (field[j] != std::pair<size_t, T>()) {
-									for (uint_fast8_t k = 0; k < 3; ++k) {
-										target.accumulated_strain[i] += source.accumulated_strain[field[j].first] * (coefficents.first[j] / coefficents.second);
+							if (accumulated_strain_map) {
+								for (uint_fast8_t j = 0; j < 8; ++j) {
+									if (field[j] != std::pair<size_t, T>()) {
+										for (uint_fast8_t k = 0; k < 3; ++k) {
+											target.accumulated_strain[i] += source.accumulated_strain[field[j].first] * (coefficents.first[j] / coefficents.second);
+										}
 									}
 								}
 							}
-						}
 
 
-					}
-				}).wait();
+						}
+					}).wait();
+			}
 		}
-	}
 
-	template <std::floating_point T = double>
-	void FieldOfPoints(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, T radius = 10.0) {
-
-		if (source.ByNode()) {
-			std::cout << "Radius: " << radius << "\n";
-			std::cout << "Target node count: " << target.nodes.size() << '\n';
-			std::cout << "Target displacement count: " << target.displacement.size() << '\n';
-
-			for (size_t i = 0; i < target.nodes.size(); ++i) {
-				int_fast64_t coincide = octree.Find(target.nodes[i]);
-				if (coincide != -1) {
-					target.displacement[i] = source.displacement[coincide];
-					continue;
-				}
+		/*
+		 * @brief Serial FOP interpolation body, shared by the radius and the directional field queries
+		 */
+		template <std::floating_point T, typename FieldQuery>
+		void FieldOfPoints(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, FieldQuery&& field_query) {
+
+			if (source.ByNode()) {
+				std::cout << "Target node count: " << target.nodes.size() << '\n';
+				std::cout << "Target displacement count: " << target.displacement.size() << '\n';
+
+				for (size_t i = 0; i < target.nodes.size(); ++i) {
+					int_fast64_t coincide = octree.Find(target.nodes[i]);
+					if (coincide != -1) {
+						target.displacement[i] = source.displacement[coincide];
+						continue;
+					}
 
-				std::array<std::pair<size_t, T>, 8> field = octree.FieldOfPoints(target.nodes[i], radius);
-				std::pair<std::array<T, 8>, T> coefficents = ProportionalDistanceCoefficents(field);
+					std::array<std::pair<size_t, T>, 8> field = field_query(target.nodes[i]);
+					std::pair<std::array<T, 8>, T> coefficents = ProportionalDistanceCoefficents(field);
 
-				FEDES_INFO("Target node index {} ({}): quadrants 0 ({}), 1 ({}), 2 ({}), 3 ({}), 4 ({}), 5 ({}), 6 ({}), 7 ({})",
-					i, target.nodes[i], source.nodes[field[0].first], source.nodes[field[1].first], source.nodes[field[2].first], source.nodes[field[3].first],
-					source.nodes[field[4].first], source.nodes[field[5].first], source.nodes[field[6].first], source.nodes[field[7].first]);
+					FEDES_INFO("Target node index {} ({}): quadrants 0 ({}), 1 ({}), 2 ({}), 3 ({}), 4 ({}), 5 ({}), 6 ({}), 7 ({})",
+						i, target.nodes[i], source.nodes[field[0].first], source.nodes[field[1].first], source.nodes[field[2].first], source.nodes[field[3].first],
+						source.nodes[field[4].first], source.nodes[field[5].first], source.nodes[field[6].first], source.nodes[field[7].first]);
 
 
-				for (uint_fast8_t j = 0; j < 8; ++j) {
-					if (field[j] != std::pair<size_t, T>()) {
-						for (uint_fast8_t k = 0; k < 3; ++k) {
-							target.displacement[i][k] += source.displacement[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+					for (uint_fast8_t j = 0; j < 8; ++j) {
+						if (field[j] != std::pair<size_t, T>()) {
+							for (uint_fast8_t k = 0; k < 3; ++k) {
+								target.displacement[i][k] += source.displacement[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+							}
 						}
 					}
-				}
 
+				}
 			}
-		}
 
-		if (source.ByIntegration()) {
-			std::cout << "Target integration count: " << target.integration.size() << '\n';
-			bool stress_map = !source.stress.empty();
-			bool plastic_strain_map = !source.plastic_strain.empty();
-			bool accumulated_strain_map = !source.accumulated_strain.empty();
-			bool total_strain_map = !source.total_strain.empty();
+			if (source.ByIntegration()) {
+				std::cout << "Target integration count: " << target.integration.size() << '\n';
+				bool stress_map = !source.stress.empty();
+				bool plastic_strain_map = !source.plastic_strain.empty();
+				bool accumulated_strain_map = !source.accumulated_strain.empty();
+				bool total_strain_map = !source.total_strain.empty();
 
-			for (size_t i = 0; i < target.integration.size(); ++i) {
-				int_fast64_t coincide = octree.Find(target.integration[i]);
-				if (coincide != -1) {
-					if (stress_map) {
-						target.stress[i] = source.stress[coincide];
-					}
-					if (plastic_strain_map) {
-						target.plastic_strain[i] = source.plastic_strain[coincide];
-					}
-					if (total_strain_map) {
-						target.total_strain[i] = source.total_strain[coincide];
-					}
-					if (accumulated_strain_map) {
-						target.accumulated_strain[i] = source.accumulated_strain[coincide];
+				for (size_t i = 0; i < target.integration.size(); ++i) {
+					int_fast64_t coincide = octree.Find(target.integration[i]);
+					if (coincide != -1) {
+						if (stress_map) {
+							target.stress[i] = source.stress[coincide];
+						}
+						if (plastic_strain_map) {
+							target.plastic_strain[i] = source.plastic_strain[coincide];
+						}
+						if (total_strain_map) {
+							target.total_strain[i] = source.total_strain[coincide];
+						}
+						if (accumulated_strain_map) {
+							target.accumulated_strain[i] = source.accumulated_strain[coincide];
+						}
+						continue;
 					}
-					continue;
-				}
 
-				std::array<std::pair<size_t, T>, 8> field = octree.FieldOfPoints(target.integration[i], radius);
-				std::pair<std::array<T, 8>, T> coefficents = ProportionalDistanceCoefficents(field);
+					std::array<std::pair<size_t, T>, 8> field = field_query(target.integration[i]);
+					std::pair<std::array<T, 8>, T> coefficents = ProportionalDistanceCoefficents(field);
 
-				FEDES_INFO("Target integration index {} ({}): quadrants 0 ({}), 1 ({}), 2 ({}), 3 ({}), 4 ({}), 5 ({}), 6 ({}), 7 ({})",
-					i, target.integration[i], source.nodes[field[0].first], source.nodes[field[1].first], source.nodes[field[2].first], source.nodes[field[3].first],
-					source.nodes[field[4].first], source.nodes[field[5].first], source.nodes[field[6].first], source.nodes[field[7].first]);
+					FEDES_INFO("Target integration index {} ({}): quadrants 0 ({}), 1 ({}), 2 ({}), 3 ({}), 4 ({}), 5 ({}), 6 ({}), 7 ({})",
+						i, target.integration[i], source.nodes[field[0].first], source.nodes[field[1].first], source.nodes[field[2].first], source.nodes[field[3].first],
+						source.nodes[field[4].first], source.nodes[field[5].first], source.nodes[field[6].first], source.nodes[field[7].first]);
 
-				if (stress_map) {
-					for (uint_fast8_t j = 0; j < 8; ++j) {
-						if (field[j] != std::pair<size_t, T>()) {
-							for (uint_fast8_t k = 0; k < 6; ++k) {
-								target.stress[i][k] += source.stress[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+					if (stress_map) {
+						for (uint_fast8_t j = 0; j < 8; ++j) {
+							if (field[j] != std::pair<size_t, T>()) {
+								for (uint_fast8_t k = 0; k < 6; ++k) {
+									target.stress[i][k] += source.stress[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+								}
 							}
 						}
 					}
-				}
 
-				if (plastic_strain_map) {
-					for (uint_fast8_t j = 0; j < 8; ++j) {
-						if (field[j] != std::pair<size_t, T>()) {
-							for (uint_fast8_t k = 0; k < 6; ++k) {
-								target.plastic_strain[i][k] += source.plastic_strain[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+					if (plastic_strain_map) {
+						for (uint_fast8_t j = 0; j < 8; ++j) {
+							if (field[j] != std::pair<size_t, T>()) {
+								for (uint_fast8_t k = 0; k < 6; ++k) {
+									target.plastic_strain[i][k] += source.plastic_strain[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+								}
 							}
 						}
 					}
-				}
 
-				if (total_strain_map) {
-					for (uint_fast8_t j = 0; j < 8; ++j) {
-						if (field[j] != std::pair<size_t, T>()) {
-							for (uint_fast8_t k = 0; k < 6; ++k) {
-								target.total_strain[i][k] += source.total_strain[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+					if (total_strain_map) {
+						for (uint_fast8_t j = 0; j < 8; ++j) {
+							if (field[j] != std::pair<size_t, T>()) {
+								for (uint_fast8_t k = 0; k < 6; ++k) {
+									target.total_strain[i][k] += source.total_strain[field[j].first][k] * (coefficents.first[j] / coefficents.second);
+								}
 							}
 						}
 					}
-				}
 
-				if (accumulated_strain_map) {
-					for (uint_fast8_t j = 0; j < 8; ++j) {
-						if (field[j] != std::pair<size_t, T>()) {
-							for (uint_fast8_t k = 0; k < 3; ++k) {
-								target.accumulated_strain[i] += source.accumulated_strain[field[j].first] * (coefficents.first[j] / coefficents.second);
+					if (accumulated_strain_map) {
+						for (uint_fast8_t j = 0; j < 8; ++j) {
+							if (field[j] != std::pair<size_t, T>()) {
+								for (uint_fast8_t k = 0; k < 3; ++k) {
+									target.accumulated_strain[i] += source.accumulated_strain[field[j].first] * (coefficents.first[j] / coefficents.second);
+								}
 							}
 						}
 					}
 				}
 			}
-		}
 		
+		}
 	}
 
+	/*
+	 * @brief Distance Method using a Field of Points (FOP), in parallel: every target point is interpolated from the closest
+	 * source point in each of the 8 directions around it, searched for within the given radius
+	 * @param radius: search radius, directions without any source point within it do not contribute
+	 */
+	template <std::floating_point T = double>
+	void ParallelFieldOfPoints(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, BS::thread_pool& pool, T radius,
+		                       TargetOrder order = TargetOrder::File) {
+		std::cout << "Radius: " << radius << "\n";
+		internal::ParallelFieldOfPoints(octree, source, target, pool,
+			[&](const fedes::Vector3<T>& query) { return octree.FieldOfPoints(query, radius); }, order);
+	}
+
+	/*
+	 * @brief Radius-free FOP, in parallel: the closest source point in each of the 8 directions is found by the directional
+	 * best-first search of the Octree, so only directions without any source point at all do not contribute
+	 */
+	template <std::floating_point T = double>
+	void ParallelFieldOfPoints(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, BS::thread_pool& pool,
+		                       TargetOrder order = TargetOrder::File) {
+		internal::ParallelFieldOfPoints(octree, source, target, pool,
+			[&](const fedes::Vector3<T>& query) { return octree.FieldOfPoints(query); }, order);
+	}
 
+	/*
+	 * @brief Adaptive FOP, in parallel: every query derives its own radius from the local point density and only grows it for
+	 * the directions that are still empty (see Octree::AdaptiveFieldOfPoints), keeping the per-query cost predictable on
+	 * meshes with strongly varying element sizes
+	 * @param k: neighbour rank used for the initial radius
+	 * @param growth: geometric growth factor of the radius for empty directions
+	 */
+	template <std::floating_point T = double>
+	void ParallelAdaptiveFieldOfPoints(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, BS::thread_pool& pool,
+		                               size_t k = 8, T growth = 2.0, TargetOrder order = TargetOrder::File) {
+		std::cout << "Adaptive radius: k = " << k << ", growth = " << growth << "\n";
+		internal::ParallelFieldOfPoints(octree, source, target, pool,
+			[&](const fedes::Vector3<T>& query) { return octree.AdaptiveFieldOfPoints(query, k, growth); }, order);
+	}
 
+	template <std::floating_point T = double>
+	void FieldOfPoints(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, T radius) {
+		std::cout << "Radius: " << radius << "\n";
+		internal::FieldOfPoints(octree, source, target,
+			[&](const fedes::Vector3<T>& query) { return octree.FieldOfPoints(query, radius); });
+	}
+
+	template <std::floating_point T = double>
+	void FieldOfPoints(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target) {
+		internal::FieldOfPoints(octree, source, target,
+			[&](const fedes::Vector3<T>& query) { return octree.FieldOfPoints(query); });
+	}
+
+	template <std::floating_point T = double>
+	void AdaptiveFieldOfPoints(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, size_t k = 8, T growth = 2.0) {
+		std::cout << "Adaptive radius: k = " << k << ", growth = " << growth << "\n";
+		internal::FieldOfPoints(octree, source, target,
+			[&](const fedes::Vector3<T>& query) { return octree.AdaptiveFieldOfPoints(query, k, growth); });
+	}
 
 } // namespace end
\ No newline at end of file
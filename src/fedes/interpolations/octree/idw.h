@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/indexing/octree/octree.h"
+#include "fedes/model/model.h"
+#include "fedes/common/scheduling.h"
+#include "fedes/common/log.h"
+
+namespace fedes {
+
+	namespace internal {
+
+		/*
+		 * @brief Normalised inverse distance weights w_i = 1 / d_i^power of the given neighbours (closest first). They are computed
+		 * relative to the closest, (d_0 / d_i)^power, which cannot overflow for tiny distances. A coincident closest neighbour
+		 * takes all of the weight.
+		 */
+		template <std::floating_point T>
+		void InverseDistanceWeights(const std::vector<std::pair<size_t, T>>& neighbours, T power, std::vector<T>& weights) {
+			weights.assign(neighbours.size(), 0);
+			if (neighbours.empty()) {
+				return;
+			}
+			const T closest = neighbours.front().second;
+			if (closest == 0) {
+				weights[0] = 1;
+				return;
+			}
+
+			T total = 0;
+			for (size_t n = 0; n < neighbours.size(); ++n) {
+				weights[n] = std::pow(closest / neighbours[n].second, power);
+				total += weights[n];
+			}
+			for (T& weight : weights) {
+				weight /= total;
+			}
+		}
+
+		template <std::floating_point T>
+		void WeightedSum(const std::vector<std::vector<double>>& field, const std::vector<std::pair<size_t, T>>& neighbours,
+			             const std::vector<T>& weights, std::vector<double>& result) {
+			std::fill(result.begin(), result.end(), 0.0);
+			for (size_t n = 0; n < neighbours.size(); ++n) {
+				const std::vector<double>& value = field[neighbours[n].first];
+				for (size_t k = 0; k < result.size(); ++k) {
+					result[k] += weights[n] * value[k];
+				}
+			}
+		}
+
+		template <std::floating_point T>
+		double WeightedSum(const std::vector<double>& field, const std::vector<std::pair<size_t, T>>& neighbours, const std::vector<T>& weights) {
+			double result = 0;
+			for (size_t n = 0; n < neighbours.size(); ++n) {
+				result += weights[n] * field[neighbours[n].first];
+			}
+			return result;
+		}
+	}
+
+	/*
+	 * @brief Inverse Distance Weighting (IDW), in parallel: every target point is interpolated from its k nearest source points,
+	 * weighted by 1 / distance^power. Each chunk of target points reuses its neighbour and weight buffers across queries.
+	 * @tparam T: point data type of the Octree, i.e. double, float
+	 * @param octree: built Octree Index to use when performing the mapping
+	 * @param source: source model with nodal and FE data
+	 * @param target: target model to use to fill FE data with from the source with indexes preset using SetIndexes()
+	 * @param pool: the thread pool to parallelize with
+	 * @param k: number of nearest source points to interpolate from
+	 * @param power: distance exponent, larger values favour the closest points
+	 * @param order: order to process the target points in
+	 * @exception std::invalid_argument if k is 0
+	 */
+	template <std::floating_point T = double>
+	void ParallelInverseDistanceWeighting(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, BS::thread_pool& pool,
+		                                  size_t k = 8, T power = 2.0, TargetOrder order = TargetOrder::File) {
+		if (k == 0) {
+			throw std::invalid_argument("Inverse Distance Weighting: at least one nearest point (k) is required");
+		}
+		std::cout << "IDW: k = " << k << ", power = " << power << "\n";
+		if (source.ByNode()) {
+			std::cout << "Target node count: " << target.nodes.size() << '\n';
+			const std::vector<size_t> node_order = fedes::TargetPermutation(target.nodes, order);
+			fedes::ParallelFor(pool, 0, target.nodes.size(),
+				[&](const uint32_t& a, const uint32_t& b)
+				{
+					std::vector<std::pair<size_t, T>> neighbours;
+					std::vector<T> weights;
+					neighbours.reserve(k);
+					weights.reserve(k);
+					for (uint32_t p = a; p < b; p++) {
+						const size_t i = node_order.empty() ? p : node_order[p];
+						octree.KNearest(target.nodes[i], k, neighbours);
+						internal::InverseDistanceWeights(neighbours, power, weights);
+						FEDES_INFO("Target node index {} ({}). Weighted {} nearest nodes, closest at Source index {}", i, target.nodes[i],
+							neighbours.size(), neighbours.front().first);
+						internal::WeightedSum(source.displacement, neighbours, weights, target.displacement[i]);
+					}
+				}).wait();
+		}
+
+		if (source.ByIntegration()) {
+			std::cout << "Target integration count: " << target.integration.size() << '\n';
+			bool stress_map = !source.stress.empty();
+			bool plastic_strain_map = !source.plastic_strain.empty();
+			bool accumulated_strain_map = !source.accumulated_strain.empty();
+			bool total_strain_map = !source.total_strain.empty();
+
+			const std::vector<size_t> integration_order = fedes::TargetPermutation(target.integration, order);
+			fedes::ParallelFor(pool, 0, target.integration.size(),
+				[&](const uint32_t& a, const uint32_t& b)
+				{
+					std::vector<std::pair<size_t, T>> neighbours;
+					std::vector<T> weights;
+					neighbours.reserve(k);
+					weights.reserve(k);
+					for (uint32_t p = a; p < b; p++) {
+						const size_t i = integration_order.empty() ? p : integration_order[p];
+						octree.KNearest(target.integration[i], k, neighbours);
+						internal::InverseDistanceWeights(neighbours, power, weights);
+						FEDES_INFO("Target integration index {} ({}). Weighted {} nearest nodes, closest at Source index {}", i, target.integration[i],
+							neighbours.size(), neighbours.front().first);
+						if (stress_map) {
+							internal::WeightedSum(source.stress, neighbours, weights, target.stress[i]);
+						}
+						if (plastic_strain_map) {
+							internal::WeightedSum(source.plastic_strain, neighbours, weights, target.plastic_strain[i]);
+						}
+						if (accumulated_strain_map) {
+							target.accumulated_strain[i] = internal::WeightedSum(source.accumulated_strain, neighbours, weights);
+						}
+						if (total_strain_map) {
+							internal::WeightedSum(source.total_strain, neighbours, weights, target.total_strain[i]);
+						}
+					}
+				}).wait();
+		}
+	}
+
+	/*
+	 * @brief Inverse Distance Weighting (IDW) over the k nearest source points, see ParallelInverseDistanceWeighting
+	 */
+	template <std::floating_point T = double>
+	void InverseDistanceWeighting(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, size_t k = 8, T power = 2.0) {
+		if (k == 0) {
+			throw std::invalid_argument("Inverse Distance Weighting: at least one nearest point (k) is required");
+		}
+		std::vector<std::pair<size_t, T>> neighbours;
+		std::vector<T> weights;
+
+		if (source.ByNode()) {
+			for (size_t i = 0; i != target.nodes.size(); i++) {
+				octree.KNearest(target.nodes[i], k, neighbours);
+				internal::InverseDistanceWeights(neighbours, power, weights);
+				internal::WeightedSum(source.displacement, neighbours, weights, target.displacement[i]);
+			}
+		}
+
+		if (source.ByIntegration()) {
+			bool stress_map = !source.stress.empty();
+			bool plastic_strain_map = !source.plastic_strain.empty();
+			bool accumulated_strain_map = !source.accumulated_strain.empty();
+			bool total_strain_map = !source.total_strain.empty();
+
+			for (size_t i = 0; i != target.integration.size(); i++) {
+				octree.KNearest(target.integration[i], k, neighbours);
+				internal::InverseDistanceWeights(neighbours, power, weights);
+				if (stress_map) {
+					internal::WeightedSum(source.stress, neighbours, weights, target.stress[i]);
+				}
+				if (plastic_strain_map) {
+					internal::WeightedSum(source.plastic_strain, neighbours, weights, target.plastic_strain[i]);
+				}
+				if (accumulated_strain_map) {
+					target.accumulated_strain[i] = internal::WeightedSum(source.accumulated_strain, neighbours, weights);
+				}
+				if (total_strain_map) {
+					internal::WeightedSum(source.total_strain, neighbours, weights, target.total_strain[i]);
+				}
+			}
+		}
+	}
+}
@@ -7,6 +7,7 @@
 #include "fedes/indexing/octree/octree.h"
 #include "fedes/indexing/octree/octant.h"
 #include "fedes/model/model.h"
+#include "fedes/common/scheduling.h"
 #include "fedes/common/log.h"
 
 namespace fedes {
@@ -18,15 +19,19 @@ namespace fedes {
 	 * @param source: source model with nodal and FE data
 	 * @param target: target model to use to fill FE data with from the source with indexes preset using SetIndexes()
 	 * @param pool: the thread pool to parallelize with
+	 * @param order: order to process the target points in
 	 */
 	template <std::floating_point T = double>
-	void ParallelNearestPointMethod(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, BS::thread_pool& pool) {
+	void ParallelNearestPointMethod(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, BS::thread_pool& pool,
+		                            TargetOrder order = TargetOrder::File) {
 		if (source.ByNode()) {
 			std::cout << "Target node count: " << target.nodes.size() << '\n';
-			pool.parallelize_loop(0, target.nodes.size(),
+			const std::vector<size_t> node_order = fedes::TargetPermutation(target.nodes, order);
+			fedes::ParallelFor(pool, 0, target.nodes.size(),
 				[&](const uint32_t& a, const uint32_t& b)
 				{
-					for (uint32_t i = a; i < b; i++) {
+					for (uint32_t p = a; p < b; p++) {
+						const size_t i = node_order.empty() ? p : node_order[p];
 						size_t source_node_idx = octree.Nearest(target.nodes[i]);
 						FEDES_INFO("Target node index {} ({}). Found nearest node at Source index {} ({})", i, target.nodes[i],
 							source_node_idx, source.nodes[source_node_idx]);
@@ -42,10 +47,12 @@ namespace fedes {
 			bool accumulated_strain_map = !source.accumulated_strain.empty();
 			bool total_strain_map = !source.total_strain.empty();
 
-			pool.parallelize_loop(0, target.integration.size(),
+			const std::vector<size_t> integration_order = fedes::TargetPermutation(target.integration, order);
+			fedes::ParallelFor(pool, 0, target.integration.size(),
 				[&](const uint32_t& a, const uint32_t& b)
 				{
-					for (uint32_t i = a; i < b; i++) {
+					for (uint32_t p = a; p < b; p++) {
+						const size_t i = integration_order.empty() ? p : integration_order[p];
 						size_t source_node_idx = octree.Nearest(target.integration[i]);
 						FEDES_INFO("Target integration index {} ({}). Found nearest node at Source index {} ({})", i, target.integration[i],
 							source_node_idx, source.nodes[source_node_idx]);
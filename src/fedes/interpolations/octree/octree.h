@@ -3,4 +3,6 @@
 #include "fedes/interpolations/octree/npm.h"
 #include "fedes/interpolations/octree/fop.h"
 #include "fedes/interpolations/octree/dmue.h"
-#include "fedes/interpolations/octree/esf.h"
\ No newline at end of file
+#include "fedes/interpolations/octree/esf.h"
+#include "fedes/interpolations/octree/idw.h"
+#include "fedes/interpolations/octree/rbf.h"
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <concepts>
+#include <optional>
+
+#include "fedes/indexing/surface/bvh.h"
+#include "fedes/maths/vector3.h"
+#include "fedes/common/log.h"
+
+namespace fedes::internal {
+
+	/*
+	 * @brief Extrapolation policy of the element based mappings for target points outside of the source geometry, detected
+	 * up front with the surface index instead of by an exhausted element search: the point is moved onto the closest point of
+	 * the boundary surface, which lies on a face of the returned element.
+	 * @param surface: boundary surface index of the source, nullptr to search every point as is
+	 * @param query_point: target point, replaced by the closest surface point if it is outside
+	 * @return the source element owning the closest surface triangle for outside points, std::nullopt for inside points
+	 */
+	template <std::floating_point T>
+	std::optional<size_t> ProjectOutside(const fedes::SurfaceBVH* surface, fedes::Vector3<T>& query_point) {
+		if (surface == nullptr) {
+			return std::nullopt;
+		}
+		const fedes::Vector3<double> point(query_point.x, query_point.y, query_point.z);
+		if (surface->Inside(point)) {
+			return std::nullopt;
+		}
+		const fedes::SurfaceBVH::Hit hit = surface->Closest(point);
+		FEDES_DEBUG("[Outside] Query point {} is {} outside of the source, extrapolating from element {}", point, hit.distance, hit.element);
+		query_point = fedes::Vector3<T>(static_cast<T>(hit.point.x), static_cast<T>(hit.point.y), static_cast<T>(hit.point.z));
+		return hit.element;
+	}
+}
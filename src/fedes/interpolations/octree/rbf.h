@@ -0,0 +1,223 @@
+#pragma once
+
+#include <concepts>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/indexing/octree/octree.h"
+#include "fedes/interpolations/octree/idw.h"
+#include "fedes/model/model.h"
+#include "fedes/maths/vector3.h"
+#include "fedes/maths/linear_solve.h"
+#include "fedes/common/scheduling.h"
+#include "fedes/common/log.h"
+
+namespace fedes {
+
+	namespace internal {
+
+		/*
+		 * @brief Buffers of the local RBF solves, sized once for k neighbours and reused for every query of a chunk
+		 */
+		template <std::floating_point T>
+		struct RbfWorkspace {
+			std::vector<std::pair<size_t, T>> neighbours;
+			std::vector<T> weights;
+			std::vector<double> matrix;
+			std::vector<double> rhs;
+			std::vector<size_t> pivots;
+
+			explicit RbfWorkspace(size_t k)
+				: matrix((k + 4) * (k + 4)), rhs(k + 4), pivots(k + 4) {
+				neighbours.reserve(k);
+				weights.reserve(k);
+			}
+		};
+
+		/*
+		 * @brief Cardinal weights of the local polyharmonic spline phi(r) = r^3 with a linear polynomial term through the given
+		 * neighbours, evaluated at the query point. As the system [Phi P; P^T 0] is symmetric, solving it for the right-hand side
+		 * [phi(|x_q - x_j|); p(x_q)] yields weights that apply to every FE field at once, i.e. one solve per target point. Linear
+		 * fields are reproduced exactly. Coordinates are centred on the query and scaled by the furthest neighbour to keep the
+		 * system well conditioned.
+		 * @return false if the system is singular (e.g. coplanar neighbours), leaving the weights undefined
+		 */
+		template <std::floating_point T>
+		bool RbfWeights(const std::vector<fedes::Vector3<double>>& nodes, const fedes::Vector3<T>& query_point, RbfWorkspace<T>& workspace) {
+			const std::vector<std::pair<size_t, T>>& neighbours = workspace.neighbours;
+			const size_t m = neighbours.size();
+			const size_t n = m + 4;
+			const double scale = 1.0 / neighbours.back().second;
+			auto local = [&](size_t j) {
+				const fedes::Vector3<double>& node = nodes[neighbours[j].first];
+				return fedes::Vector3<double>((node.x - query_point.x) * scale, (node.y - query_point.y) * scale, (node.z - query_point.z) * scale);
+			};
+
+			std::span<double> a(workspace.matrix.data(), n * n);
+			for (size_t i = 0; i < m; ++i) {
+				const fedes::Vector3<double> yi = local(i);
+				a[i * n + i] = 0;
+				for (size_t j = i + 1; j < m; ++j) {
+					const fedes::Vector3<double> d = yi - local(j);
+					const double r = std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+					a[i * n + j] = a[j * n + i] = r * r * r;
+				}
+				const double p[4] = { 1.0, yi.x, yi.y, yi.z };
+				for (size_t c = 0; c < 4; ++c) {
+					a[i * n + m + c] = a[(m + c) * n + i] = p[c];
+				}
+				const double r = neighbours[i].second * scale;
+				workspace.rhs[i] = r * r * r;
+			}
+			for (size_t r = m; r < n; ++r) {
+				for (size_t c = m; c < n; ++c) {
+					a[r * n + c] = 0;
+				}
+			}
+			// The polynomial at the query point, which is the local origin
+			workspace.rhs[m] = 1.0;
+			workspace.rhs[m + 1] = workspace.rhs[m + 2] = workspace.rhs[m + 3] = 0.0;
+
+			if (!fedes::LUFactorize(a, n, workspace.pivots)) {
+				return false;
+			}
+			fedes::LUSolve(a, n, workspace.pivots, std::span<double>(workspace.rhs.data(), n));
+			workspace.weights.resize(m);
+			for (size_t j = 0; j < m; ++j) {
+				if (!std::isfinite(workspace.rhs[j])) {
+					return false;
+				}
+				workspace.weights[j] = static_cast<T>(workspace.rhs[j]);
+			}
+			return true;
+		}
+
+		/*
+		 * @brief Fills workspace.neighbours/weights for a target point. Coincident points copy the source values, too few or
+		 * degenerate neighbours fall back to inverse distance weights.
+		 */
+		template <std::floating_point T>
+		void LocalRbfWeights(const fedes::Octree<T>& octree, const fedes::Model& source, const fedes::Vector3<T>& query_point,
+			                 size_t k, RbfWorkspace<T>& workspace) {
+			octree.KNearest(query_point, k, workspace.neighbours);
+			if (workspace.neighbours.front().second == 0 || workspace.neighbours.size() < 5 ||
+				!RbfWeights(source.nodes, query_point, workspace)) {
+				FEDES_DEBUG("[RBF] Query point {}: using inverse distance weights of {} neighbours", query_point, workspace.neighbours.size());
+				InverseDistanceWeights(workspace.neighbours, T(2), workspace.weights);
+			}
+		}
+	}
+
+	/*
+	 * @brief Local Radial Basis Function (RBF) interpolation, in parallel: every target point is interpolated by a cubic
+	 * polyharmonic spline with a linear term through its k nearest source points (see internal::RbfWeights). Each chunk of
+	 * target points reuses one workspace, so the small dense solves do not allocate.
+	 * @tparam T: point data type of the Octree, i.e. double, float
+	 * @param octree: built Octree Index to use when performing the mapping
+	 * @param source: source model with nodal and FE data
+	 * @param target: target model to use to fill FE data with from the source with indexes preset using SetIndexes()
+	 * @param pool: the thread pool to parallelize with
+	 * @param k: number of nearest source points per local system, i.e. k + 4 unknowns
+	 * @param order: order to process the target points in
+	 * @exception std::invalid_argument if k is 0
+	 */
+	template <std::floating_point T = double>
+	void ParallelRadialBasisFunction(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, BS::thread_pool& pool,
+		                             size_t k = 16, TargetOrder order = TargetOrder::File) {
+		if (k == 0) {
+			throw std::invalid_argument("Radial Basis Function: at least one nearest point (k) is required");
+		}
+		std::cout << "RBF: k = " << k << "\n";
+		if (source.ByNode()) {
+			std::cout << "Target node count: " << target.nodes.size() << '\n';
+			const std::vector<size_t> node_order = fedes::TargetPermutation(target.nodes, order);
+			fedes::ParallelFor(pool, 0, target.nodes.size(),
+				[&](const uint32_t& a, const uint32_t& b)
+				{
+					internal::RbfWorkspace<T> workspace(k);
+					for (uint32_t p = a; p < b; p++) {
+						const size_t i = node_order.empty() ? p : node_order[p];
+						internal::LocalRbfWeights(octree, source, target.nodes[i], k, workspace);
+						internal::WeightedSum(source.displacement, workspace.neighbours, workspace.weights, target.displacement[i]);
+					}
+				}).wait();
+		}
+
+		if (source.ByIntegration()) {
+			std::cout << "Target integration count: " << target.integration.size() << '\n';
+			bool stress_map = !source.stress.empty();
+			bool plastic_strain_map = !source.plastic_strain.empty();
+			bool accumulated_strain_map = !source.accumulated_strain.empty();
+			bool total_strain_map = !source.total_strain.empty();
+
+			const std::vector<size_t> integration_order = fedes::TargetPermutation(target.integration, order);
+			fedes::ParallelFor(pool, 0, target.integration.size(),
+				[&](const uint32_t& a, const uint32_t& b)
+				{
+					internal::RbfWorkspace<T> workspace(k);
+					for (uint32_t p = a; p < b; p++) {
+						const size_t i = integration_order.empty() ? p : integration_order[p];
+						internal::LocalRbfWeights(octree, source, target.integration[i], k, workspace);
+						if (stress_map) {
+							internal::WeightedSum(source.stress, workspace.neighbours, workspace.weights, target.stress[i]);
+						}
+						if (plastic_strain_map) {
+							internal::WeightedSum(source.plastic_strain, workspace.neighbours, workspace.weights, target.plastic_strain[i]);
+						}
+						if (accumulated_strain_map) {
+							target.accumulated_strain[i] = internal::WeightedSum(source.accumulated_strain, workspace.neighbours, workspace.weights);
+						}
+						if (total_strain_map) {
+							internal::WeightedSum(source.total_strain, workspace.neighbours, workspace.weights, target.total_strain[i]);
+						}
+					}
+				}).wait();
+		}
+	}
+
+	/*
+	 * @brief Local Radial Basis Function (RBF) interpolation, see ParallelRadialBasisFunction
+	 */
+	template <std::floating_point T = double>
+	void RadialBasisFunction(const fedes::Octree<T>& octree, const fedes::Model& source, fedes::Model& target, size_t k = 16) {
+		if (k == 0) {
+			throw std::invalid_argument("Radial Basis Function: at least one nearest point (k) is required");
+		}
+		internal::RbfWorkspace<T> workspace(k);
+
+		if (source.ByNode()) {
+			for (size_t i = 0; i != target.nodes.size(); i++) {
+				internal::LocalRbfWeights(octree, source, target.nodes[i], k, workspace);
+				internal::WeightedSum(source.displacement, workspace.neighbours, workspace.weights, target.displacement[i]);
+			}
+		}
+
+		if (source.ByIntegration()) {
+			bool stress_map = !source.stress.empty();
+			bool plastic_strain_map = !source.plastic_strain.empty();
+			bool accumulated_strain_map = !source.accumulated_strain.empty();
+			bool total_strain_map = !source.total_strain.empty();
+
+			for (size_t i = 0; i != target.integration.size(); i++) {
+				internal::LocalRbfWeights(octree, source, target.integration[i], k, workspace);
+				if (stress_map) {
+					internal::WeightedSum(source.stress, workspace.neighbours, workspace.weights, target.stress[i]);
+				}
+				if (plastic_strain_map) {
+					internal::WeightedSum(source.plastic_strain, workspace.neighbours, workspace.weights, target.plastic_strain[i]);
+				}
+				if (accumulated_strain_map) {
+					target.accumulated_strain[i] = internal::WeightedSum(source.accumulated_strain, workspace.neighbours, workspace.weights);
+				}
+				if (total_strain_map) {
+					internal::WeightedSum(source.total_strain, workspace.neighbours, workspace.weights, target.total_strain[i]);
+				}
+			}
+		}
+	}
+}
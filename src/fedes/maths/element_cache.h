@@ -0,0 +1,400 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <vector>
+#include <optional>
+
+#include "fedes/maths/vector3.h"
+#include "fedes/maths/geometry.h"
+#include "fedes/maths/element_type.h"
+#include "fedes/common/log.h"
+
+namespace fedes {
+
+	/*
+	 * @brief Precomputed inverse map of a single source element, so that its local coordinates (g, h, r)
+	 * for any query point are given by: local = inverse * (query - origin)
+	 *
+	 * The FEDES v2 containment formulas are affine in the query point for all 3 element types:
+	 *  - Tetrahedron: exact barycentric map, origin = node 1, inverse of the edge matrix [c2 - c1, c3 - c1, c4 - c1]
+	 *  - Wedge: linearised map of FEDES v2 (f = 2q - (0.25 (c2 + c3) + 0.75 (c5 + c6)))
+	 *  - Hexahedron: linearised map of FEDES v2 (f = 8q - sum(c))
+	 * meaning the determinant and edge differences only ever need computing once per element.
+	 */
+	struct ElementCache {
+	public:
+		std::array<double, 9> inverse; // @brief: row-major 3x3
+		fedes::Vector3<double> origin;
+		fedes::Vector3<double> aabb_min; // @brief: nodal bounding box, for pre-rejection ahead of the exact inverse mapping
+		fedes::Vector3<double> aabb_max;
+	public:
+
+		/*
+		 * @brief Local coordinates of a query point with respect to the cached element
+		 */
+		MuesfData LocalCoordinates(const fedes::Vector3<double>& query_point) const {
+			const double dx = query_point.x - origin.x;
+			const double dy = query_point.y - origin.y;
+			const double dz = query_point.z - origin.z;
+			return MuesfData{
+				.g = inverse[0] * dx + inverse[1] * dy + inverse[2] * dz,
+				.h = inverse[3] * dx + inverse[4] * dy + inverse[5] * dz,
+				.r = inverse[6] * dx + inverse[7] * dy + inverse[8] * dz
+			};
+		}
+	};
+
+	/*
+	 * @brief Builds the inverse of the 3x3 matrix with the given columns, scaled by `scale`.
+	 * Degenerate elements (det = 0) end up with non-finite entries, and as such are never considered to contain a point,
+	 * which is the same behaviour as the uncached FEDES v2 formulas.
+	 */
+	inline std::array<double, 9> ScaledInverse(const fedes::Vector3<double>& c0, const fedes::Vector3<double>& c1,
+		                                       const fedes::Vector3<double>& c2, double scale) {
+		double det = c0.x * (c1.y * c2.z - c2.y * c1.z) - c1.x * (c0.y * c2.z - c2.y * c0.z) + c2.x * (c0.y * c1.z - c1.y * c0.z);
+		double s = scale / det;
+		return {
+			(c1.y * c2.z - c2.y * c1.z) * s, (c1.x * c2.z - c2.x * c1.z) * -s, (c1.x * c2.y - c2.x * c1.y) * s,
+			(c0.y * c2.z - c2.y * c0.z) * -s, (c0.x * c2.z - c2.x * c0.z) * s, (c0.x * c2.y - c2.x * c0.y) * -s,
+			(c0.y * c1.z - c1.y * c0.z) * s, (c0.x * c1.z - c1.x * c0.z) * -s, (c0.x * c1.y - c1.x * c0.y) * s
+		};
+	}
+
+	/*
+	 * @brief Computes the inverse map for an element of the given type
+	 * @param nodes: source nodes
+	 * @param element: the node indexes of the element
+	 * @param element_type: the (uniform) element type of the mesh
+	 */
+	inline ElementCache CacheElement(const std::span<fedes::Vector3<double>>& nodes, const std::vector<size_t>& element, ElementType element_type) {
+		ElementCache cache;
+		switch (element_type) {
+		case ElementType::Tetrahedron: {
+			const fedes::Vector3<double>& c1 = nodes[element[0]];
+			cache.origin = c1;
+			cache.inverse = ScaledInverse(nodes[element[1]] - c1, nodes[element[2]] - c1, nodes[element[3]] - c1, 1.0);
+			break;
+		}
+		case ElementType::Wedge: {
+			const fedes::Vector3<double>& c1 = nodes[element[0]];
+			const fedes::Vector3<double>& c2 = nodes[element[1]];
+			const fedes::Vector3<double>& c3 = nodes[element[2]];
+			const fedes::Vector3<double>& c4 = nodes[element[3]];
+			const fedes::Vector3<double>& c5 = nodes[element[4]];
+			const fedes::Vector3<double>& c6 = nodes[element[5]];
+			fedes::Vector3<double> fg = c2 - c1 - c4 + c5;
+			fedes::Vector3<double> fh = c3 - c1 - c4 + c6;
+			fedes::Vector3<double> fr = (c5 + c6 - c2 - c3) * 0.5;
+			cache.origin = ((c2 + c3) * 0.25 + (c5 + c6) * 0.75) / 2;
+			cache.inverse = ScaledInverse(fg, fh, fr, 2.0);
+			break;
+		}
+		case ElementType::Hexahedron: {
+			fedes::Vector3<double> fg, fh, fr, sum;
+			for (uint_fast8_t n = 0; n < 8; ++n) {
+				const fedes::Vector3<double>& c = nodes[element[n]];
+				fg += ((n == 1 || n == 2 || n == 5 || n == 6) ? c : c * -1.0);
+				fh += ((n == 2 || n == 3 || n == 6 || n == 7) ? c : c * -1.0);
+				fr += ((n >= 4) ? c : c * -1.0);
+				sum += c;
+			}
+			cache.origin = sum / 8;
+			cache.inverse = ScaledInverse(fg, fh, fr, 8.0);
+			break;
+		}
+		}
+
+		cache.aabb_min = nodes[element[0]];
+		cache.aabb_max = nodes[element[0]];
+		for (const auto& n : element) {
+			const fedes::Vector3<double>& c = nodes[n];
+			cache.aabb_min = fedes::Vector3<double>(std::min(cache.aabb_min.x, c.x), std::min(cache.aabb_min.y, c.y), std::min(cache.aabb_min.z, c.z));
+			cache.aabb_max = fedes::Vector3<double>(std::max(cache.aabb_max.x, c.x), std::max(cache.aabb_max.y, c.y), std::max(cache.aabb_max.z, c.z));
+		}
+		return cache;
+	}
+
+	/*
+	 * @brief Cached counterpart of TetrahedronContainment, with identical bounds semantics
+	 */
+	inline std::optional<MuesfData> TetrahedronContainment(const ElementCache& cache, const fedes::Vector3<double>& query_point,
+		                                                   double g3, double h3, double r3, double g_h_r3) {
+		MuesfData local = cache.LocalCoordinates(query_point);
+		if ((local.g > g3) && (local.h > h3) && (local.r > r3) && (local.g + local.h + local.r < g_h_r3)) {
+			FEDES_INFO("[Geometry] Query point {} is contained inside cached Tetrahedron Element", query_point);
+			return { local };
+		}
+		return {};
+	}
+
+	/*
+	 * @brief Cached counterpart of WedgeContainment, with identical bounds semantics
+	 */
+	inline std::optional<MuesfData> WedgeContainment(const ElementCache& cache, const fedes::Vector3<double>& query_point,
+		                                             double g4, double h4, double r4, double gg4, double hh4, double rr4) {
+		MuesfData local = cache.LocalCoordinates(query_point);
+		if ((local.g > g4) && (local.g < gg4) && (local.h > h4) && (local.h < hh4) && (local.r > r4) && (local.r < rr4)) {
+			FEDES_INFO("[Geometry] Query point {} is contained inside cached Wedge Element", query_point);
+			return { local };
+		}
+		return {};
+	}
+
+	/*
+	 * @brief Cached counterpart of HexahedronContainment, with identical bounds semantics
+	 */
+	inline std::optional<MuesfData> HexahedronContainment(const ElementCache& cache, const fedes::Vector3<double>& query_point,
+		                                                  double g5, double h5, double r5, double gg5, double hh5, double rr5) {
+		MuesfData local = cache.LocalCoordinates(query_point);
+		if ((local.g > g5) && (local.g < gg5) && (local.h > h5) && (local.h < hh5) && (local.r > r5) && (local.r < rr5)) {
+			FEDES_INFO("[Geometry] Query point {} is contained inside cached Hexahedron Element", query_point);
+			return { local };
+		}
+		return {};
+	}
+
+	/*
+	 * @brief Containment bounds of MUESF in terms of local coordinates: lower[i] < local[i] < upper[i], g + h + r < sum
+	 * and g + h < triangle. Tetrahedra only bound the lower coordinates and the sum, wedges and hexahedra bound each
+	 * coordinate, and the triangle bound is only used by the exact (isoparametric) wedge mapping.
+	 */
+	struct ContainmentBounds {
+	public:
+		std::array<double, 3> lower;
+		std::array<double, 3> upper;
+		double sum;
+		double triangle = std::numeric_limits<double>::infinity();
+	};
+
+	/*
+	 * @brief By how much the bounds must be relaxed (every bound widened by the same amount) for the local coordinates to
+	 * satisfy them. Negative if they already do, in which case the element contains the point.
+	 */
+	inline double BoundsViolation(const MuesfData& local, const ContainmentBounds& bounds) {
+		return std::max({ bounds.lower[0] - local.g, local.g - bounds.upper[0],
+		                  bounds.lower[1] - local.h, local.h - bounds.upper[1],
+		                  bounds.lower[2] - local.r, local.r - bounds.upper[2],
+		                  local.g + local.h + local.r - bounds.sum, local.g + local.h - bounds.triangle });
+	}
+
+	/*
+	 * @brief Widens every bound by the given amount, the same way the FEDES v2 relaxation passes did
+	 */
+	inline ContainmentBounds Relax(const ContainmentBounds& bounds, double amount) {
+		return ContainmentBounds{
+			.lower = { bounds.lower[0] - amount, bounds.lower[1] - amount, bounds.lower[2] - amount },
+			.upper = { bounds.upper[0] + amount, bounds.upper[1] + amount, bounds.upper[2] + amount },
+			.sum = bounds.sum + amount,
+			.triangle = bounds.triangle + amount
+		};
+	}
+
+	/*
+	 * @brief Projects local coordinates onto the reference element of the given type (i.e. clamps them to its boundary),
+	 * so that shape function weights remain within [0, 1] for points outside of the element
+	 */
+	inline MuesfData ProjectLocalCoordinates(MuesfData local, ElementType element_type) {
+		auto project_simplex = [](std::array<double*, 3> coordinates, uint_fast8_t n) {
+			double sum = 0.0;
+			for (uint_fast8_t i = 0; i < n; ++i) {
+				*coordinates[i] = std::max(0.0, *coordinates[i]);
+				sum += *coordinates[i];
+			}
+			if (sum > 1.0) {
+				for (uint_fast8_t i = 0; i < n; ++i) {
+					*coordinates[i] /= sum;
+				}
+			}
+		};
+
+		switch (element_type) {
+		case ElementType::Tetrahedron:
+			project_simplex({ &local.g, &local.h, &local.r }, 3);
+			break;
+		case ElementType::Wedge:
+			project_simplex({ &local.g, &local.h, nullptr }, 2);
+			local.r = std::clamp(local.r, -1.0, 1.0);
+			break;
+		case ElementType::Hexahedron:
+			local.g = std::clamp(local.g, -1.0, 1.0);
+			local.h = std::clamp(local.h, -1.0, 1.0);
+			local.r = std::clamp(local.r, -1.0, 1.0);
+			break;
+		}
+		return local;
+	}
+
+	inline constexpr size_t element_block_width = 4; // @brief: lanes per block, 4 doubles = one AVX2 register
+
+	/*
+	 * @brief Structure of arrays packing of up to `element_block_width` cached elements, so that a query point can be
+	 * tested against all lanes at once. Each coefficient array is one lane-wide register worth of doubles.
+	 * Unused lanes hold NaN coefficients, which fail every bound comparison and can therefore never report a hit.
+	 */
+	struct ElementBlock {
+	public:
+		std::array<size_t, element_block_width> ids;
+		alignas(32) std::array<std::array<double, element_block_width>, 9> inverse; // @brief: inverse[k][lane], row-major k
+		alignas(32) std::array<std::array<double, element_block_width>, 3> origin; // @brief: origin[axis][lane]
+		alignas(32) std::array<std::array<double, element_block_width>, 3> aabb_min; // @brief: aabb_min[axis][lane]
+		alignas(32) std::array<std::array<double, element_block_width>, 3> aabb_max;
+		uint_fast8_t count = 0;
+	};
+
+	/*
+	 * @brief Packs the given candidate elements (in order) into blocks of `element_block_width` lanes
+	 * @param candidates: element indexes, in the order they should be tested
+	 * @param cache: per-element inverse maps, as built by CacheElement
+	 */
+	inline std::vector<ElementBlock> PackElementBlocks(const std::vector<size_t>& candidates, const std::vector<ElementCache>& cache) {
+		std::vector<ElementBlock> blocks((candidates.size() + element_block_width - 1) / element_block_width);
+		for (size_t b = 0; b < blocks.size(); ++b) {
+			ElementBlock& block = blocks[b];
+			for (size_t lane = 0; lane < element_block_width; ++lane) {
+				size_t c = b * element_block_width + lane;
+				if (c < candidates.size()) {
+					const ElementCache& element = cache[candidates[c]];
+					block.ids[lane] = candidates[c];
+					for (uint_fast8_t k = 0; k < 9; ++k) {
+						block.inverse[k][lane] = element.inverse[k];
+					}
+					block.origin[0][lane] = element.origin.x;
+					block.origin[1][lane] = element.origin.y;
+					block.origin[2][lane] = element.origin.z;
+					block.aabb_min[0][lane] = element.aabb_min.x;
+					block.aabb_min[1][lane] = element.aabb_min.y;
+					block.aabb_min[2][lane] = element.aabb_min.z;
+					block.aabb_max[0][lane] = element.aabb_max.x;
+					block.aabb_max[1][lane] = element.aabb_max.y;
+					block.aabb_max[2][lane] = element.aabb_max.z;
+					block.count++;
+				} else {
+					block.ids[lane] = 0;
+					for (uint_fast8_t k = 0; k < 9; ++k) {
+						block.inverse[k][lane] = std::numeric_limits<double>::quiet_NaN();
+					}
+					for (uint_fast8_t k = 0; k < 3; ++k) {
+						block.origin[k][lane] = 0.0;
+						block.aabb_min[k][lane] = std::numeric_limits<double>::quiet_NaN();
+						block.aabb_max[k][lane] = std::numeric_limits<double>::quiet_NaN();
+					}
+				}
+			}
+		}
+		return blocks;
+	}
+
+	/*
+	 * @brief Local coordinates of a query point with respect to every lane of a block
+	 */
+	inline void BlockLocalCoordinates(const ElementBlock& block, const fedes::Vector3<double>& query_point,
+		                              std::array<std::array<double, element_block_width>, 3>& local) {
+		alignas(32) std::array<double, element_block_width> dx, dy, dz;
+		for (size_t lane = 0; lane < element_block_width; ++lane) {
+			dx[lane] = query_point.x - block.origin[0][lane];
+			dy[lane] = query_point.y - block.origin[1][lane];
+			dz[lane] = query_point.z - block.origin[2][lane];
+		}
+		for (uint_fast8_t axis = 0; axis < 3; ++axis) {
+			const std::array<double, element_block_width>& i0 = block.inverse[axis * 3];
+			const std::array<double, element_block_width>& i1 = block.inverse[axis * 3 + 1];
+			const std::array<double, element_block_width>& i2 = block.inverse[axis * 3 + 2];
+			for (size_t lane = 0; lane < element_block_width; ++lane) {
+				local[axis][lane] = i0[lane] * dx[lane] + i1[lane] * dy[lane] + i2[lane] * dz[lane];
+			}
+		}
+	}
+
+	/*
+	 * @brief Tests a query point against every lane of a block at once
+	 *
+	 * The lane loops are branch-free over fixed-width arrays, so that the compiler maps them onto SIMD registers
+	 * (SSE2/AVX2/NEON, depending on the target flags) without any intrinsics.
+	 * @param local: receives the local coordinates of every lane, local[axis][lane]
+	 * @return bit mask of the lanes containing the query point, bit 0 being the first lane
+	 */
+	inline uint_fast8_t BlockContainment(const ElementBlock& block, const fedes::Vector3<double>& query_point, const ContainmentBounds& bounds,
+		                                 std::array<std::array<double, element_block_width>, 3>& local) {
+		BlockLocalCoordinates(block, query_point, local);
+
+		uint_fast8_t mask = 0;
+		for (size_t lane = 0; lane < element_block_width; ++lane) {
+			const double g = local[0][lane];
+			const double h = local[1][lane];
+			const double r = local[2][lane];
+			bool hit = (g > bounds.lower[0]) & (g < bounds.upper[0]) & (h > bounds.lower[1]) & (h < bounds.upper[1]) &
+			           (r > bounds.lower[2]) & (r < bounds.upper[2]) & (g + h + r < bounds.sum) & (g + h < bounds.triangle);
+			mask |= static_cast<uint_fast8_t>(hit) << lane;
+		}
+		return mask;
+	}
+
+	/*
+	 * @brief Computes the BoundsViolation of every lane of a block at once
+	 * @param local: receives the local coordinates of every lane, local[axis][lane]
+	 * @param violation: receives the violation of every lane, NaN for unused lanes
+	 */
+	inline void BlockViolation(const ElementBlock& block, const fedes::Vector3<double>& query_point, const ContainmentBounds& bounds,
+		                       std::array<std::array<double, element_block_width>, 3>& local, std::array<double, element_block_width>& violation) {
+		BlockLocalCoordinates(block, query_point, local);
+		for (size_t lane = 0; lane < element_block_width; ++lane) {
+			const double g = local[0][lane];
+			const double h = local[1][lane];
+			const double r = local[2][lane];
+			double v = bounds.lower[0] - g;
+			v = std::max(v, g - bounds.upper[0]);
+			v = std::max(v, bounds.lower[1] - h);
+			v = std::max(v, h - bounds.upper[1]);
+			v = std::max(v, bounds.lower[2] - r);
+			v = std::max(v, r - bounds.upper[2]);
+			v = std::max(v, g + h + r - bounds.sum);
+			v = std::max(v, g + h - bounds.triangle);
+			violation[lane] = (lane < block.count) ? v : std::numeric_limits<double>::quiet_NaN();
+		}
+	}
+
+	/*
+	 * @brief Tests a query point against the bounding boxes of every lane of a block at once
+	 * @param padding: fraction of each box's range to pad every side by (see BoundingBoxPadding)
+	 * @return bit mask of the lanes whose padded box contains the query point
+	 */
+	inline uint_fast8_t BlockBoxContainment(const ElementBlock& block, const fedes::Vector3<double>& query_point, double padding) {
+		const std::array<double, 3> q = { query_point.x, query_point.y, query_point.z };
+		alignas(32) std::array<bool, element_block_width> inside;
+		inside.fill(true);
+		for (uint_fast8_t axis = 0; axis < 3; ++axis) {
+			const std::array<double, element_block_width>& lo = block.aabb_min[axis];
+			const std::array<double, element_block_width>& hi = block.aabb_max[axis];
+			for (size_t lane = 0; lane < element_block_width; ++lane) {
+				double pad = (hi[lane] - lo[lane]) * padding;
+				inside[lane] = inside[lane] & (q[axis] >= lo[lane] - pad) & (q[axis] <= hi[lane] + pad);
+			}
+		}
+
+		uint_fast8_t mask = 0;
+		for (size_t lane = 0; lane < element_block_width; ++lane) {
+			mask |= static_cast<uint_fast8_t>(inside[lane]) << lane;
+		}
+		return mask;
+	}
+
+	/*
+	 * @brief Returns the first element of the block containing the query point, if any, along with its local coordinates
+	 */
+	inline std::optional<std::pair<size_t, MuesfData>> FirstBlockContainment(const ElementBlock& block, const fedes::Vector3<double>& query_point,
+		                                                                     const ContainmentBounds& bounds) {
+		std::array<std::array<double, element_block_width>, 3> local;
+		uint_fast8_t mask = BlockContainment(block, query_point, bounds, local);
+		if (mask == 0) {
+			return {};
+		}
+		size_t lane = std::countr_zero(static_cast<unsigned int>(mask));
+		FEDES_INFO("[Geometry] Query point {} is contained inside cached Element {} (block lane {})", query_point, block.ids[lane], lane);
+		return { { block.ids[lane], MuesfData{.g = local[0][lane], .h = local[1][lane], .r = local[2][lane]} } };
+	}
+}
@@ -1,6 +1,7 @@
 #include "fedes/maths/element_type.h"
 
 #include <vector>
+#include <optional>
 #include <ostream>
 
 namespace fedes {
@@ -20,6 +21,21 @@ namespace fedes {
 		}
 	}
 
+	/*
+	 * @brief Type of an element from its number of nodes, empty for elements other than (linear) tetrahedra, wedges and hexahedra
+	 */
+	std::optional<ElementType> ElementTypeOf(size_t nodes_per_element) {
+		switch (nodes_per_element) {
+		case 4:
+			return ElementType::Tetrahedron;
+		case 6:
+			return ElementType::Wedge;
+		case 8:
+			return ElementType::Hexahedron;
+		}
+		return std::nullopt;
+	}
+
 	std::ostream& operator<<(std::ostream& os, const ElementType& et) {
 		switch (et) {
 		case ElementType::Tetrahedron:
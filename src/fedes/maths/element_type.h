@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <optional>
 #include <ostream>
 
 namespace fedes {
@@ -13,5 +14,6 @@ namespace fedes {
 	};
 
 	ElementType DetermineElementType(const std::vector<std::vector<size_t>>& elements);
+	std::optional<ElementType> ElementTypeOf(size_t nodes_per_element);
 	std::ostream& operator<<(std::ostream& os, const ElementType& et);
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <span>
+#include <vector>
+
+#include "fedes/maths/vector3.h"
+#include "fedes/maths/element_type.h"
+#include "fedes/maths/isoparametric.h"
+
+namespace fedes {
+
+	/*
+	 * @brief Gauss integration points in the local coordinates (g, h, r) of the ESF interpolation, i.e. barycentric
+	 * (1 - g - h - r, g, h, r) for tetrahedra, triangle (g, h) x line r for wedges and [-1, 1]^3 for hexahedra
+	 */
+	template <ElementType E>
+	struct GaussRule;
+
+	/*
+	 * @brief 4 point rule (degree 2), as used by 10 node tetrahedra
+	 */
+	template <>
+	struct GaussRule<ElementType::Tetrahedron> {
+		static constexpr double a = 0.5854101966249685;
+		static constexpr double b = 0.1381966011250105;
+		static constexpr std::array<std::array<double, 3>, 4> points = { {
+			{ b, b, b }, { a, b, b }, { b, a, b }, { b, b, a }
+		} };
+	};
+
+	/*
+	 * @brief 3 point triangle rule x 2 point Gauss-Legendre rule
+	 */
+	template <>
+	struct GaussRule<ElementType::Wedge> {
+		static constexpr double s = 0.5773502691896258; // 1 / sqrt(3)
+		static constexpr std::array<std::array<double, 3>, 6> points = { {
+			{ 1.0 / 6, 1.0 / 6, -s }, { 2.0 / 3, 1.0 / 6, -s }, { 1.0 / 6, 2.0 / 3, -s },
+			{ 1.0 / 6, 1.0 / 6,  s }, { 2.0 / 3, 1.0 / 6,  s }, { 1.0 / 6, 2.0 / 3,  s }
+		} };
+	};
+
+	/*
+	 * @brief 2 x 2 x 2 Gauss-Legendre rule, in the node order of the hexahedron
+	 */
+	template <>
+	struct GaussRule<ElementType::Hexahedron> {
+		static constexpr double s = 0.5773502691896258; // 1 / sqrt(3)
+		static constexpr std::array<std::array<double, 3>, 8> points = { {
+			{ -s, -s, -s }, { s, -s, -s }, { s, s, -s }, { -s, s, -s },
+			{ -s, -s,  s }, { s, -s,  s }, { s, s,  s }, { -s, s,  s }
+		} };
+	};
+
+	inline std::span<const std::array<double, 3>> GaussPoints(ElementType element_type) {
+		switch (element_type) {
+		case ElementType::Wedge:
+			return GaussRule<ElementType::Wedge>::points;
+		case ElementType::Hexahedron:
+			return GaussRule<ElementType::Hexahedron>::points;
+		case ElementType::Tetrahedron:
+		default:
+			return GaussRule<ElementType::Tetrahedron>::points;
+		}
+	}
+
+	/*
+	 * @brief Global position of the local coordinates (g, h, r) within the given element
+	 */
+	inline fedes::Vector3<double> LocalToGlobal(const std::vector<fedes::Vector3<double>>& nodes, const std::vector<size_t>& element,
+		                                        ElementType element_type, const std::array<double, 3>& local) {
+		const auto [g, h, r] = local;
+		fedes::Vector3<double> position;
+		switch (element_type) {
+		case ElementType::Wedge: {
+			std::array<double, 6> n = ShapeFunctions<ElementType::Wedge>::Values(g, h, r);
+			for (size_t i = 0; i < n.size(); ++i) {
+				position += nodes[element[i]] * n[i];
+			}
+			break;
+		}
+		case ElementType::Hexahedron: {
+			std::array<double, 8> n = ShapeFunctions<ElementType::Hexahedron>::Values(g, h, r);
+			for (size_t i = 0; i < n.size(); ++i) {
+				position += nodes[element[i]] * n[i];
+			}
+			break;
+		}
+		case ElementType::Tetrahedron:
+		default:
+			position = nodes[element[0]] * (1 - g - h - r) + nodes[element[1]] * g + nodes[element[2]] * h + nodes[element[3]] * r;
+			break;
+		}
+		return position;
+	}
+}
@@ -16,13 +16,16 @@ namespace fedes {
 		double g;
 		double h;
 		double r;
+		double relaxation = 0.0; // @brief: how far the containment bounds had to be relaxed for the element to contain the point
+		bool projected = false; // @brief: no element contained the point, (g, h, r) were projected onto the closest element
 	};
 
 	/*
+	 * @brief Local coordinates of a query point with respect to a tetrahedron, regardless of containment
 	 * @port From FEDES v2 
 	 */
-	inline std::optional<MuesfData> TetrahedronContainment(const std::span<fedes::Vector3<double>>& source_nodes, const std::vector<size_t>& element,
-		                                                   const fedes::Vector3<double> query_point, double g3, double h3, double r3, double g_h_r3) {
+	inline MuesfData TetrahedronLocalCoordinates(const std::span<fedes::Vector3<double>>& source_nodes, const std::vector<size_t>& element,
+		                                         const fedes::Vector3<double> query_point) {
 		const double& xn = query_point.x;
 		const double& yn = query_point.y;
 		const double& zn = query_point.z;
@@ -58,10 +61,22 @@ namespace fedes {
 		* cz2cz0
 		+ cz1cz0 * cx2cx0 * yncy0 - cz1cz0 * xncx0 * cy2cy0) / det;
 
+		return MuesfData{.g = g, .h = h, .r = r};
+	}
+
+	/*
+	 * @port From FEDES v2 
+	 */
+	inline std::optional<MuesfData> TetrahedronContainment(const std::span<fedes::Vector3<double>>& source_nodes, const std::vector<size_t>& element,
+		                                                   const fedes::Vector3<double> query_point, double g3, double h3, double r3, double g_h_r3) {
+		MuesfData local = TetrahedronLocalCoordinates(source_nodes, element, query_point);
+		const double& g = local.g;
+		const double& h = local.h;
+		const double& r = local.r;
 		if ((g > g3) && (h > h3) && (r > r3) && (g + h + r < g_h_r3)) {
 			FEDES_INFO("[Geometry] Query point {} is contained inside Tetrahedron Element of [1] ({}) [2] ({}) [3] ({}) [4] ({})", query_point,
 				source_nodes[element[0]], source_nodes[element[1]], source_nodes[element[2]], source_nodes[element[3]]);
-			return { MuesfData{.g = g, .h = h, .r = r} };
+			return { local };
 		} else {
 			return {};
 		}
@@ -69,11 +84,11 @@ namespace fedes {
 	}
 
 	/*
+	 * @brief Linearised local coordinates of a query point with respect to a wedge, regardless of containment
 	 * @port From FEDES v2
 	 */
-	inline std::optional<MuesfData> WedgeContainment(const std::span<fedes::Vector3<double>>& source_nodes, const std::vector<size_t>& elements,
-		                                             const fedes::Vector3<double> query_point, double g4, double h4, double r4, 
-		                                             double gg4, double hh4, double rr4) {
+	inline MuesfData WedgeLocalCoordinates(const std::span<fedes::Vector3<double>>& source_nodes, const std::vector<size_t>& elements,
+		                                   const fedes::Vector3<double> query_point) {
 		
 		const double& cx1 = source_nodes[elements[0]].x;
 		const double& cx2 = source_nodes[elements[1]].x;
@@ -111,10 +126,23 @@ namespace fedes {
 		double h = (f1g * f2 * f3r - f1g * f2r * f3 - f2g * f1 * f3r + f2g * f1r * f3 + f3g * f1 * f2r - f3g * f1r * f2) / det;
 		double r = (f1g * f2h * f3 - f1g * f2 * f3h - f2g * f1h * f3 + f2g * f1 * f3h + f3g * f1h * f2 - f3g * f1 * f2h) / det;
 
+		return MuesfData{.g = g, .h = h, .r = r};
+	}
+
+	/*
+	 * @port From FEDES v2
+	 */
+	inline std::optional<MuesfData> WedgeContainment(const std::span<fedes::Vector3<double>>& source_nodes, const std::vector<size_t>& elements,
+		                                             const fedes::Vector3<double> query_point, double g4, double h4, double r4, 
+		                                             double gg4, double hh4, double rr4) {
+		MuesfData local = WedgeLocalCoordinates(source_nodes, elements, query_point);
+		const double& g = local.g;
+		const double& h = local.h;
+		const double& r = local.r;
 
 		if ((g > g4) && (g < gg4) && (h > h4) && (h < hh4) && (r > r4) && (r < rr4)) {
 			FEDES_INFO("[Geometry] Found query point {} contained within Wedge Element element with nodes of:", query_point);
-			return { MuesfData{.g = g, .h = h, .r = r} };
+			return { local };
 		}
 		else {
 			return {};
@@ -123,11 +151,11 @@ namespace fedes {
 	}
 
 	/*
+	 * @brief Linearised local coordinates of a query point with respect to a hexahedron, regardless of containment
 	 * @port From FEDES v2
 	 */
-	inline std::optional<MuesfData> HexahedronContainment(const std::span<fedes::Vector3<double>>& source_nodes, const std::vector<size_t>& elements,
-		                                                  const fedes::Vector3<double> query_point, double g5, double h5, double r5,
-		                                                  double gg5, double hh5, double rr5) {
+	inline MuesfData HexahedronLocalCoordinates(const std::span<fedes::Vector3<double>>& source_nodes, const std::vector<size_t>& elements,
+		                                        const fedes::Vector3<double> query_point) {
 		const double& cx1 = source_nodes[elements[0]].x;
 		const double& cx2 = source_nodes[elements[1]].x;
 		const double& cx3 = source_nodes[elements[2]].x;
@@ -170,11 +198,24 @@ namespace fedes {
 		double h = (f1g * f2 * f3r - f1g * f2r * f3 - f2g * f1 * f3r + f2g * f1r * f3 + f3g * f1 * f2r - f3g * f1r * f2) / det;
 		double r = (f1g * f2h * f3 - f1g * f2 * f3h - f2g * f1h * f3 + f2g * f1 * f3h + f3g * f1h * f2 - f3g * f1 * f2h) / det;
 
+		return MuesfData{.g = g, .h = h, .r = r};
+	}
+
+	/*
+	 * @port From FEDES v2
+	 */
+	inline std::optional<MuesfData> HexahedronContainment(const std::span<fedes::Vector3<double>>& source_nodes, const std::vector<size_t>& elements,
+		                                                  const fedes::Vector3<double> query_point, double g5, double h5, double r5,
+		                                                  double gg5, double hh5, double rr5) {
+		MuesfData local = HexahedronLocalCoordinates(source_nodes, elements, query_point);
+		const double& g = local.g;
+		const double& h = local.h;
+		const double& r = local.r;
 		if ((g > g5) && (g < gg5) && (h > h5)  && (h < hh5) &&  (r > r5) &&  (r < rr5)) {
 			FEDES_INFO("[Geometry] Found query point {} contained within Hexahedron Element with nodes of: [1] ({}) [2] ({}) [3] ({}) [4] ({}) [5] ({}) [6] ({}) [7] ({}) [8] ({})", 
 				query_point, source_nodes[elements[0]], source_nodes[elements[1]], source_nodes[elements[2]], source_nodes[elements[3]], source_nodes[elements[4]],
 				source_nodes[elements[5]], source_nodes[elements[6]], source_nodes[elements[7]]);
-			return { MuesfData{.g = g, .h = h, .r = r} };
+			return { local };
 		} else {
 			return {};
 		}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <vector>
+#include <optional>
+
+#include "fedes/maths/vector3.h"
+#include "fedes/maths/geometry.h"
+#include "fedes/maths/element_type.h"
+#include "fedes/maths/element_cache.h"
+#include "fedes/common/log.h"
+
+namespace fedes {
+
+	/*
+	 * @brief Shape functions N_i(g, h, r) and their derivatives of the supported isoparametric elements, using the same
+	 * node ordering and local coordinate conventions as the ESF interpolation
+	 */
+	template <ElementType E>
+	struct ShapeFunctions;
+
+	/*
+	 * @brief 6 node wedge: triangle (g, h) in [0, 1] with g + h <= 1, extruded along r in [-1, 1]
+	 */
+	template <>
+	struct ShapeFunctions<ElementType::Wedge> {
+	public:
+		static constexpr size_t nodes = 6;
+
+		static std::array<double, nodes> Values(double g, double h, double r) {
+			double l = 1 - g - h;
+			return { 0.5 * l * (1 - r), 0.5 * g * (1 - r), 0.5 * h * (1 - r),
+			         0.5 * l * (1 + r), 0.5 * g * (1 + r), 0.5 * h * (1 + r) };
+		}
+
+		/*
+		 * @return dN_i/dg, dN_i/dh, dN_i/dr for every node i
+		 */
+		static std::array<std::array<double, 3>, nodes> Derivatives(double g, double h, double r) {
+			double l = 1 - g - h;
+			return { {
+				{ -0.5 * (1 - r), -0.5 * (1 - r), -0.5 * l },
+				{  0.5 * (1 - r),  0.0,           -0.5 * g },
+				{  0.0,            0.5 * (1 - r), -0.5 * h },
+				{ -0.5 * (1 + r), -0.5 * (1 + r),  0.5 * l },
+				{  0.5 * (1 + r),  0.0,            0.5 * g },
+				{  0.0,            0.5 * (1 + r),  0.5 * h }
+			} };
+		}
+
+		/*
+		 * @brief Upper bound of sum(|N_i|) over the local coordinates allowed by the given bounds. Since sum(N_i) = 1,
+		 * a mapped point lies within the nodal bounding box padded by (sum(|N_i|) - 1) / 2 of its range.
+		 */
+		static double AbsoluteSum(const ContainmentBounds& bounds) {
+			double triangle = 1 + 2 * (std::max(0.0, -bounds.lower[0]) + std::max(0.0, -bounds.lower[1]) + std::max(0.0, bounds.triangle - 1));
+			double line = std::max({ 1.0, std::abs(bounds.lower[2]), std::abs(bounds.upper[2]) });
+			return triangle * line;
+		}
+	};
+
+	/*
+	 * @brief 8 node trilinear hexahedron: (g, h, r) in [-1, 1]^3
+	 */
+	template <>
+	struct ShapeFunctions<ElementType::Hexahedron> {
+	public:
+		static constexpr size_t nodes = 8;
+		static constexpr std::array<double, 8> gs = { -1, 1, 1, -1, -1, 1, 1, -1 };
+		static constexpr std::array<double, 8> hs = { -1, -1, 1, 1, -1, -1, 1, 1 };
+		static constexpr std::array<double, 8> rs = { -1, -1, -1, -1, 1, 1, 1, 1 };
+
+		static std::array<double, nodes> Values(double g, double h, double r) {
+			std::array<double, nodes> n;
+			for (uint_fast8_t i = 0; i < nodes; ++i) {
+				n[i] = 0.125 * (1 + gs[i] * g) * (1 + hs[i] * h) * (1 + rs[i] * r);
+			}
+			return n;
+		}
+
+		static std::array<std::array<double, 3>, nodes> Derivatives(double g, double h, double r) {
+			std::array<std::array<double, 3>, nodes> d;
+			for (uint_fast8_t i = 0; i < nodes; ++i) {
+				d[i][0] = 0.125 * gs[i] * (1 + hs[i] * h) * (1 + rs[i] * r);
+				d[i][1] = 0.125 * hs[i] * (1 + gs[i] * g) * (1 + rs[i] * r);
+				d[i][2] = 0.125 * rs[i] * (1 + gs[i] * g) * (1 + hs[i] * h);
+			}
+			return d;
+		}
+
+		static double AbsoluteSum(const ContainmentBounds& bounds) {
+			double sum = 1.0;
+			for (uint_fast8_t k = 0; k < 3; ++k) {
+				sum *= std::max({ 1.0, std::abs(bounds.lower[k]), std::abs(bounds.upper[k]) });
+			}
+			return sum;
+		}
+	};
+
+	/*
+	 * @brief Fraction of an element's bounding box range by which it must be padded (per side), so that every point whose
+	 * local coordinates satisfy the given bounds lies within it
+	 */
+	template <ElementType E>
+	double BoundingBoxPadding(const ContainmentBounds& bounds) {
+		return 0.5 * (ShapeFunctions<E>::AbsoluteSum(bounds) - 1.0);
+	}
+
+	/*
+	 * @brief Inverse isoparametric mapping: solves x(g, h, r) = query for the local coordinates with Newton's method,
+	 * using the analytic Jacobian of the shape functions
+	 * @param nodes: source nodes
+	 * @param element: the node indexes of the element
+	 * @param initial: starting local coordinates, e.g. the linearised estimate of an ElementCache (exact for affine elements)
+	 * @param tolerance: early exit once the largest local coordinate update falls below it
+	 * @return local coordinates, or empty if the iteration diverged/the Jacobian is singular (i.e. the point is far outside)
+	 */
+	template <ElementType E>
+	std::optional<MuesfData> InverseMap(const std::span<fedes::Vector3<double>>& nodes, const std::vector<size_t>& element,
+		                                const fedes::Vector3<double>& query_point, MuesfData initial,
+		                                double tolerance = 1e-10, size_t max_iterations = 12) {
+		using Shape = ShapeFunctions<E>;
+		std::array<double, 3> local = { initial.g, initial.h, initial.r };
+
+		for (size_t it = 0; it < max_iterations; ++it) {
+			std::array<double, Shape::nodes> n = Shape::Values(local[0], local[1], local[2]);
+			std::array<std::array<double, 3>, Shape::nodes> d = Shape::Derivatives(local[0], local[1], local[2]);
+
+			fedes::Vector3<double> residual(-query_point.x, -query_point.y, -query_point.z);
+			fedes::Vector3<double> dg, dh, dr;
+			for (uint_fast8_t i = 0; i < Shape::nodes; ++i) {
+				const fedes::Vector3<double>& c = nodes[element[i]];
+				residual += c * n[i];
+				dg += c * d[i][0];
+				dh += c * d[i][1];
+				dr += c * d[i][2];
+			}
+
+			std::array<double, 9> inverse = ScaledInverse(dg, dh, dr, 1.0);
+			double step_g = inverse[0] * residual.x + inverse[1] * residual.y + inverse[2] * residual.z;
+			double step_h = inverse[3] * residual.x + inverse[4] * residual.y + inverse[5] * residual.z;
+			double step_r = inverse[6] * residual.x + inverse[7] * residual.y + inverse[8] * residual.z;
+			if (!std::isfinite(step_g) || !std::isfinite(step_h) || !std::isfinite(step_r)) {
+				return {};
+			}
+
+			local[0] -= step_g;
+			local[1] -= step_h;
+			local[2] -= step_r;
+
+			double step = std::max({ std::abs(step_g), std::abs(step_h), std::abs(step_r) });
+			if (step < tolerance) {
+				break;
+			}
+			// Beyond any sensible relaxation, no need to converge
+			if (std::abs(local[0]) > 10 || std::abs(local[1]) > 10 || std::abs(local[2]) > 10) {
+				return {};
+			}
+		}
+		return { MuesfData{.g = local[0], .h = local[1], .r = local[2]} };
+	}
+
+	/*
+	 * @brief Exact (non-linearised) counterpart of WedgeContainment/HexahedronContainment for an element of type E
+	 * @param cache: cached linear map of the element, used as the Newton initial guess
+	 */
+	template <ElementType E>
+	std::optional<MuesfData> IsoparametricContainment(const std::span<fedes::Vector3<double>>& nodes, const std::vector<size_t>& element,
+		                                              const ElementCache& cache, const fedes::Vector3<double>& query_point,
+		                                              const ContainmentBounds& bounds) {
+		std::optional<MuesfData> local = InverseMap<E>(nodes, element, query_point, cache.LocalCoordinates(query_point));
+		if (!local.has_value()) {
+			return {};
+		}
+		const double g = local->g;
+		const double h = local->h;
+		const double r = local->r;
+		if ((g > bounds.lower[0]) && (g < bounds.upper[0]) && (h > bounds.lower[1]) && (h < bounds.upper[1]) &&
+			(r > bounds.lower[2]) && (r < bounds.upper[2]) && (g + h + r < bounds.sum) && (g + h < bounds.triangle)) {
+			FEDES_INFO("[Geometry] Query point {} is contained inside {} Element (isoparametric)", query_point, E);
+			return local;
+		}
+		return {};
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <utility>
+
+namespace fedes {
+
+	/*
+	 * @brief In-place LU factorisation with partial pivoting of a small dense n x n matrix, PA = LU. Works purely on the given
+	 * buffers, so that the many small solves of a mapping do not allocate. The row updates run over contiguous memory and
+	 * are vectorised by the compiler.
+	 * @param a: row-major matrix, overwritten by L (unit diagonal, below) and U (on and above the diagonal)
+	 * @param n: matrix dimension
+	 * @param pivots: the row swapped with each row, at least n entries
+	 * @param tolerance: pivots smaller than tolerance * max|a_ij| are treated as zero
+	 * @return false if the matrix is (numerically) singular
+	 */
+	inline bool LUFactorize(std::span<double> a, size_t n, std::span<size_t> pivots, double tolerance = 1e-12) {
+		double scale = 0;
+		for (size_t i = 0; i < n * n; ++i) {
+			scale = std::max(scale, std::abs(a[i]));
+		}
+		if (scale == 0 || !std::isfinite(scale)) {
+			return false;
+		}
+		const double threshold = tolerance * scale;
+
+		for (size_t k = 0; k < n; ++k) {
+			size_t pivot = k;
+			double largest = std::abs(a[k * n + k]);
+			for (size_t i = k + 1; i < n; ++i) {
+				if (std::abs(a[i * n + k]) > largest) {
+					largest = std::abs(a[i * n + k]);
+					pivot = i;
+				}
+			}
+			if (!(largest > threshold)) {
+				return false;
+			}
+			pivots[k] = pivot;
+			if (pivot != k) {
+				for (size_t j = 0; j < n; ++j) {
+					std::swap(a[k * n + j], a[pivot * n + j]);
+				}
+			}
+
+			const double inverse = 1.0 / a[k * n + k];
+			const double* row_k = &a[k * n];
+			for (size_t i = k + 1; i < n; ++i) {
+				double* row_i = &a[i * n];
+				const double factor = row_i[k] * inverse;
+				row_i[k] = factor;
+				for (size_t j = k + 1; j < n; ++j) {
+					row_i[j] -= factor * row_k[j];
+				}
+			}
+		}
+		return true;
+	}
+
+	/*
+	 * @brief Solves Ax = b in place for a matrix factorised by LUFactorize
+	 * @param b: right-hand side, overwritten by the solution x
+	 */
+	inline void LUSolve(std::span<const double> lu, size_t n, std::span<const size_t> pivots, std::span<double> b) {
+		for (size_t k = 0; k < n; ++k) {
+			if (pivots[k] != k) {
+				std::swap(b[k], b[pivots[k]]);
+			}
+		}
+		// Forward substitution, L has a unit diagonal
+		for (size_t i = 1; i < n; ++i) {
+			double sum = b[i];
+			for (size_t j = 0; j < i; ++j) {
+				sum -= lu[i * n + j] * b[j];
+			}
+			b[i] = sum;
+		}
+		// Backward substitution
+		for (size_t i = n; i-- > 0;) {
+			double sum = b[i];
+			for (size_t j = i + 1; j < n; ++j) {
+				sum -= lu[i * n + j] * b[j];
+			}
+			b[i] = sum / lu[i * n + i];
+		}
+	}
+}
@@ -1,7 +1,10 @@
 #include "fedes/maths/z_ordering.h"
 
+#include <algorithm>
 #include <bitset>
+#include <limits>
 #include <tuple>
+#include <utility>
 
 #include <matchit.h>
 
@@ -45,7 +48,68 @@ namespace fedes {
 		);
 	}
 
+	/*
+	 * @brief Spreads the lowest 21 bits of v so that there are two zero bits between each of them
+	 */
+	static uint_fast64_t SpreadBits(uint_fast64_t v) {
+		v &= 0x1fffff;
+		v = (v | v << 32) & 0x1f00000000ffff;
+		v = (v | v << 16) & 0x1f0000ff0000ff;
+		v = (v | v << 8) & 0x100f00f00f00f00f;
+		v = (v | v << 4) & 0x10c30c30c30c30c3;
+		v = (v | v << 2) & 0x1249249249249249;
+		return v;
+	}
+
+	/* @brief Interleaves three quantised coordinates into a 63 bit Morton code. Every 3 bit group of the code is a direction
+	 * code as returned by DetermineDirection, with x as its most significant bit, from the coarsest level down.
+	 * @param x, y, z: quantised coordinates, only their lowest 21 bits are used
+	 */
+	[[nodiscard]] uint_fast64_t MortonCode(uint_fast32_t x, uint_fast32_t y, uint_fast32_t z) {
+		return (SpreadBits(x) << 2) | (SpreadBits(y) << 1) | SpreadBits(z);
+	}
+
+	/* @brief Sorts points along the Z-Order curve of their bounding cube, so that points close in the resulting order are
+	 * also close in space
+	 * @param points: 3-dimensional points to order
+	 * @returns permutation of the point indexes, i.e. the index of the point at each position along the curve
+	 */
+	template <std::floating_point T>
+	[[nodiscard]] std::vector<size_t> MortonOrder(const std::vector<fedes::Vector3<T>>& points) {
+		if (points.empty()) {
+			return {};
+		}
+
+		fedes::Vector3<T> min(std::numeric_limits<T>::max());
+		fedes::Vector3<T> max(std::numeric_limits<T>::lowest());
+		for (const fedes::Vector3<T>& p : points) {
+			min.x = std::min(min.x, p.x); min.y = std::min(min.y, p.y); min.z = std::min(min.z, p.z);
+			max.x = std::max(max.x, p.x); max.y = std::max(max.y, p.y); max.z = std::max(max.z, p.z);
+		}
+
+		// Quantise over a cube, as for the root octant, so that the curve is not stretched along the shorter axes
+		constexpr double cells = (1 << 21) - 1;
+		const double extent = std::max({ max.x - min.x, max.y - min.y, max.z - min.z });
+		const double scale = extent > 0 ? cells / extent : 0.0;
+
+		std::vector<std::pair<uint_fast64_t, size_t>> codes(points.size());
+		for (size_t i = 0; i < points.size(); ++i) {
+			codes[i] = { MortonCode(static_cast<uint_fast32_t>((points[i].x - min.x) * scale),
+				                    static_cast<uint_fast32_t>((points[i].y - min.y) * scale),
+				                    static_cast<uint_fast32_t>((points[i].z - min.z) * scale)), i };
+		}
+		std::sort(codes.begin(), codes.end());
+
+		std::vector<size_t> order(points.size());
+		for (size_t i = 0; i < codes.size(); ++i) {
+			order[i] = codes[i].second;
+		}
+		return order;
+	}
+
 	/* Explicit template instantiations */
 	template uint_fast8_t DetermineDirection(const fedes::Vector3<double>& origin, const fedes::Vector3<double>& p);
 	template uint_fast8_t DetermineDirection(const fedes::Vector3<float>& origin, const fedes::Vector3<float>& p);
+	template std::vector<size_t> MortonOrder(const std::vector<fedes::Vector3<double>>& points);
+	template std::vector<size_t> MortonOrder(const std::vector<fedes::Vector3<float>>& points);
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <concepts>
+#include <cstdint>
+#include <vector>
 
 #include "fedes/maths/vector3.h"
 
@@ -8,4 +10,9 @@ namespace fedes {
 	
 	template <std::floating_point T>
 	uint_fast8_t DetermineDirection(const fedes::Vector3<T>& origin, const fedes::Vector3<T>& p);
+
+	uint_fast64_t MortonCode(uint_fast32_t x, uint_fast32_t y, uint_fast32_t z);
+
+	template <std::floating_point T>
+	std::vector<size_t> MortonOrder(const std::vector<fedes::Vector3<T>>& points);
 }
\ No newline at end of file
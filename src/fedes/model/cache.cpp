@@ -0,0 +1,481 @@
+// cache.cpp -> native binary snapshot of a fedes::Model, read back instead of parsing its source files again
+
+#include "fedes/model/cache.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/model/model.h"
+#include "fedes/maths/vector3.h"
+#include "fedes/common/files.h"
+#include "fedes/common/mapped_file.h"
+#include "fedes/common/scheduling.h"
+#include "fedes/common/log.h"
+
+namespace fedes {
+
+	namespace {
+		constexpr std::array<char, 8> magic = { 'F', 'E', 'D', 'E', 'S', 'M', 'D', 'L' };
+		constexpr uint32_t version = 1;
+		constexpr uint32_t byte_order = 0x01020304; // @brief: Reads as 0x04030201 on a machine of the other byte order
+
+		/*
+		 * @brief Content of a section, ragged arrays (std::vector<std::vector<T>>) are stored as offsets and values
+		 */
+		enum class Tag : uint32_t {
+			Sources = 1, Nodes, ElementOffsets, Elements, DisplacementOffsets, Displacement, StressOffsets, Stress,
+			TotalStrainOffsets, TotalStrain, PlasticStrainOffsets, PlasticStrain, AccumulatedStrain, Integration,
+			IntegrationOffsets, NodeIds, ElementIds, NodeOrder, ElementOrder
+		};
+
+		struct Header {
+			std::array<char, 8> magic;
+			uint32_t version;
+			uint32_t byte_order;
+			uint64_t sections;
+			uint64_t checksum; // @brief: Of the table of sections
+		};
+
+		struct Entry {
+			uint32_t tag;
+			uint32_t width; // @brief: Bytes per value, e.g. 24 for the coordinates of a node
+			uint64_t offset; // @brief: From the start of the file, a multiple of 8
+			uint64_t size; // @brief: In bytes
+			uint64_t checksum;
+		};
+
+		static_assert(sizeof(Header) == 32 && sizeof(Entry) == 32);
+		static_assert(sizeof(fedes::Vector3<double>) == 3 * sizeof(double) && std::is_trivially_copyable_v<fedes::Vector3<double>>);
+
+		[[noreturn]] void InvalidCache(const std::string& what) {
+			throw std::invalid_argument("Invalid model cache: " + what);
+		}
+
+		/*
+		 * @brief 64 bit words mixed by a multiply-rotate, i.e. one multiplication per word so sections are checked at memory speed
+		 */
+		uint64_t Checksum(std::string_view bytes) {
+			constexpr uint64_t prime = 0xFF51AFD7ED558CCDull;
+			uint64_t hash = 0x9E3779B97F4A7C15ull ^ bytes.size();
+			size_t i = 0;
+			for (; i + sizeof(uint64_t) <= bytes.size(); i += sizeof(uint64_t)) {
+				uint64_t word;
+				std::memcpy(&word, bytes.data() + i, sizeof(uint64_t));
+				hash = std::rotl((hash ^ word) * prime, 31);
+			}
+			uint64_t tail = 0;
+			if (i < bytes.size()) {
+				std::memcpy(&tail, bytes.data() + i, bytes.size() - i);
+			}
+			hash = std::rotl((hash ^ tail) * prime, 31);
+			return hash ^ (hash >> 29);
+		}
+
+		/*
+		 * @brief File names of the sources, recorded so a cache is not reused for another combination of files
+		 */
+		std::string SourcesText(const std::vector<std::filesystem::path>& sources) {
+			std::string text;
+			for (const std::filesystem::path& source : sources) {
+				text += source.filename().string();
+				text += '\n';
+			}
+			return text;
+		}
+
+		/*
+		 * @brief Section to write, viewing the model's array or owning its flattened copy
+		 */
+		struct Section {
+			Tag tag;
+			uint32_t width;
+			std::vector<char> owned;
+			std::string_view bytes;
+		};
+
+		template <typename T>
+		void Put(char*& out, const T& value) {
+			if constexpr (std::is_same_v<T, size_t>) {
+				const uint64_t stored = value;
+				std::memcpy(out, &stored, sizeof(uint64_t));
+				out += sizeof(uint64_t);
+			} else {
+				std::memcpy(out, &value, sizeof(T));
+				out += sizeof(T);
+			}
+		}
+
+		template <typename T>
+		Section Flat(Tag tag, const std::vector<T>& values) {
+			if constexpr (std::is_same_v<T, size_t> && sizeof(size_t) != sizeof(uint64_t)) {
+				Section section{ tag, sizeof(uint64_t) };
+				section.owned.resize(values.size() * sizeof(uint64_t));
+				char* out = section.owned.data();
+				for (const size_t& value : values) {
+					Put(out, value);
+				}
+				section.bytes = { section.owned.data(), section.owned.size() };
+				return section;
+			} else {
+				return { tag, sizeof(T), {}, { reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T) } };
+			}
+		}
+
+		template <typename T>
+		void AddRagged(std::vector<Section>& sections, Tag offsets_tag, Tag values_tag, const std::vector<std::vector<T>>& values) {
+			if (values.empty()) {
+				return;
+			}
+			Section offsets{ offsets_tag, sizeof(uint64_t) };
+			offsets.owned.resize((values.size() + 1) * sizeof(uint64_t));
+			char* out = offsets.owned.data();
+			uint64_t offset = 0;
+			Put(out, offset);
+			for (const std::vector<T>& entry : values) {
+				offset += entry.size();
+				Put(out, offset);
+			}
+			offsets.bytes = { offsets.owned.data(), offsets.owned.size() };
+
+			Section flat{ values_tag, sizeof(uint64_t) };
+			flat.owned.resize(offset * sizeof(uint64_t));
+			out = flat.owned.data();
+			for (const std::vector<T>& entry : values) {
+				for (const T& value : entry) {
+					Put(out, value);
+				}
+			}
+			flat.bytes = { flat.owned.data(), flat.owned.size() };
+
+			sections.push_back(std::move(offsets));
+			sections.push_back(std::move(flat));
+		}
+
+		template <typename T>
+		void AddFlat(std::vector<Section>& sections, Tag tag, const std::vector<T>& values) {
+			if (!values.empty()) {
+				sections.push_back(Flat(tag, values));
+			}
+		}
+
+		/*
+		 * @brief Table of sections of a mapped cache, after checking the header, the table checksum and the section bounds
+		 */
+		std::vector<Entry> Table(std::string_view file) {
+			Header header;
+			if (file.size() < sizeof(Header)) {
+				InvalidCache("truncated header");
+			}
+			std::memcpy(&header, file.data(), sizeof(Header));
+			if (header.magic != magic) {
+				InvalidCache("not a fedes model cache");
+			}
+			if (header.byte_order != byte_order) {
+				InvalidCache("written on a machine of another byte order");
+			}
+			if (header.version != version) {
+				InvalidCache("version " + std::to_string(header.version) + ", expected " + std::to_string(version));
+			}
+			if (header.sections > (file.size() - sizeof(Header)) / sizeof(Entry)) {
+				InvalidCache("truncated table of sections");
+			}
+			const std::string_view table_bytes = file.substr(sizeof(Header), header.sections * sizeof(Entry));
+			if (Checksum(table_bytes) != header.checksum) {
+				InvalidCache("checksum mismatch of the table of sections");
+			}
+			std::vector<Entry> table(header.sections);
+			std::memcpy(table.data(), table_bytes.data(), table_bytes.size());
+			for (const Entry& entry : table) {
+				if (entry.offset > file.size() || entry.size > file.size() - entry.offset) {
+					InvalidCache("truncated section " + std::to_string(entry.tag));
+				}
+				if (entry.width == 0 || entry.size % entry.width != 0) {
+					InvalidCache("size of section " + std::to_string(entry.tag));
+				}
+			}
+			return table;
+		}
+
+		/*
+		 * @brief Values of a section, after checking their width
+		 */
+		template <typename T>
+		std::vector<T> Values(std::string_view file, const Entry& entry) {
+			const size_t width = std::is_same_v<T, size_t> ? sizeof(uint64_t) : sizeof(T);
+			if (entry.width != width) {
+				InvalidCache("width of section " + std::to_string(entry.tag));
+			}
+			std::vector<T> values(entry.size / width);
+			if constexpr (std::is_same_v<T, size_t> && sizeof(size_t) != sizeof(uint64_t)) {
+				for (size_t i = 0; i < values.size(); ++i) {
+					uint64_t value;
+					std::memcpy(&value, file.data() + entry.offset + i * width, width);
+					values[i] = static_cast<size_t>(value);
+				}
+			} else {
+				std::memcpy(values.data(), file.data() + entry.offset, entry.size);
+			}
+			return values;
+		}
+
+		/*
+		 * @brief Rebuilds a ragged array from its offsets and values, on the pool if given
+		 */
+		template <typename T>
+		void Unflatten(const std::vector<size_t>& offsets, const std::vector<T>& values, std::vector<std::vector<T>>& ragged,
+			std::optional<BS::thread_pool*> pool) {
+			if (offsets.empty() && values.empty()) {
+				return;
+			}
+			if (offsets.empty() || offsets.front() != 0 || offsets.back() != values.size()) {
+				InvalidCache("offsets do not match their values");
+			}
+			for (size_t i = 1; i < offsets.size(); ++i) {
+				if (offsets[i] < offsets[i - 1]) {
+					InvalidCache("offsets do not match their values");
+				}
+			}
+			ragged.resize(offsets.size() - 1);
+			auto fill = [&](const size_t& a, const size_t& b) {
+				for (size_t i = a; i < b; ++i) {
+					ragged[i].assign(values.begin() + offsets[i], values.begin() + offsets[i + 1]);
+				}
+			};
+			if (pool.has_value()) {
+				fedes::ParallelFor(*pool.value(), 0, ragged.size(), fill).get();
+			} else {
+				fill(0, ragged.size());
+			}
+		}
+
+		const Entry* Find(const std::vector<Entry>& table, Tag tag) {
+			for (const Entry& entry : table) {
+				if (entry.tag == static_cast<uint32_t>(tag)) {
+					return &entry;
+				}
+			}
+			return nullptr;
+		}
+	}
+
+	/*
+	 * @brief Writes the model to a cache file, through a temporary file renamed once complete so that a concurrent or
+	 * interrupted run never reads a partial cache
+	 * @param path: cache file, see ModelCachePath
+	 * @param model: model as parsed from the sources
+	 * @param sources: files the model was parsed from, checked by ModelCacheFresh
+	 * @exception Propagates std::ofstream::failure and std::filesystem::filesystem_error
+	 */
+	void ModelCacheWrite(const std::filesystem::path& path, const fedes::Model& model, const std::vector<std::filesystem::path>& sources) {
+		const std::string sources_text = SourcesText(sources);
+		std::vector<Section> sections;
+		sections.push_back({ Tag::Sources, 1, {}, sources_text });
+		AddFlat(sections, Tag::Nodes, model.nodes);
+		AddRagged(sections, Tag::ElementOffsets, Tag::Elements, model.elements);
+		AddRagged(sections, Tag::DisplacementOffsets, Tag::Displacement, model.displacement);
+		AddRagged(sections, Tag::StressOffsets, Tag::Stress, model.stress);
+		AddRagged(sections, Tag::TotalStrainOffsets, Tag::TotalStrain, model.total_strain);
+		AddRagged(sections, Tag::PlasticStrainOffsets, Tag::PlasticStrain, model.plastic_strain);
+		AddFlat(sections, Tag::AccumulatedStrain, model.accumulated_strain);
+		AddFlat(sections, Tag::Integration, model.integration);
+		AddFlat(sections, Tag::IntegrationOffsets, model.integration_offsets);
+		AddFlat(sections, Tag::NodeIds, model.node_ids);
+		AddFlat(sections, Tag::ElementIds, model.element_ids);
+		AddFlat(sections, Tag::NodeOrder, model.node_order);
+		AddFlat(sections, Tag::ElementOrder, model.element_order);
+
+		std::vector<Entry> table;
+		uint64_t offset = sizeof(Header) + sections.size() * sizeof(Entry);
+		for (const Section& section : sections) {
+			table.push_back({ static_cast<uint32_t>(section.tag), section.width, offset, section.bytes.size(), Checksum(section.bytes) });
+			offset = (offset + section.bytes.size() + 7) / 8 * 8;
+		}
+		const std::string_view table_bytes(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(Entry));
+		const Header header{ magic, version, byte_order, table.size(), Checksum(table_bytes) };
+
+		std::filesystem::path temporary = path;
+		temporary += ".tmp";
+		std::ofstream stream;
+		try {
+			fedes::SetOutputFileStream(temporary, stream, true);
+		} catch (const std::ofstream::failure& e) {
+			throw;
+		}
+		if (!stream.is_open()) {
+			throw std::ofstream::failure("Unable to write the model cache " + temporary.string());
+		}
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		stream.write(table_bytes.data(), table_bytes.size());
+		const std::array<char, 8> padding{};
+		for (size_t i = 0; i < sections.size(); ++i) {
+			stream.write(sections[i].bytes.data(), sections[i].bytes.size());
+			const size_t end = table[i].offset + table[i].size;
+			stream.write(padding.data(), (8 - end % 8) % 8);
+		}
+		try {
+			fedes::CloseOutputFileStream(stream);
+		} catch (const std::ofstream::failure& e) {
+			throw;
+		}
+		if (stream.fail()) {
+			throw std::ofstream::failure("Unable to write the model cache " + temporary.string());
+		}
+		std::filesystem::rename(temporary, path);
+	}
+
+	/*
+	 * @brief Replaces the model by the one of a cache file, which is memory mapped and copied section by section. The
+	 * checksums are verified, and the ragged arrays rebuilt, on the pool if given.
+	 * @param path: cache file written by ModelCacheWrite
+	 * @param model: left unchanged if the cache is invalid
+	 * @exception std::invalid_argument for a cache of another version or byte order, or a corrupted one, propagates
+	 * std::ifstream::failure
+	 */
+	void ModelCacheRead(const std::filesystem::path& path, fedes::Model& model, std::optional<BS::thread_pool*> pool) {
+		const fedes::MappedFile file(path);
+		const std::string_view bytes = file.view();
+		const std::vector<Entry> table = Table(bytes);
+
+		auto verify = [&](const size_t& a, const size_t& b) {
+			for (size_t i = a; i < b; ++i) {
+				if (Checksum(bytes.substr(table[i].offset, table[i].size)) != table[i].checksum) {
+					InvalidCache("checksum mismatch of section " + std::to_string(table[i].tag));
+				}
+			}
+		};
+		if (pool.has_value()) {
+			fedes::ParallelFor(*pool.value(), 0, table.size(), verify, 1).get();
+		} else {
+			verify(0, table.size());
+		}
+
+		auto flat = [&]<typename T>(Tag tag, std::vector<T>& values) {
+			const Entry* entry = Find(table, tag);
+			if (entry != nullptr) {
+				values = Values<T>(bytes, *entry);
+			}
+		};
+		auto ragged = [&]<typename T>(Tag offsets_tag, Tag values_tag, std::vector<std::vector<T>>& values) {
+			std::vector<size_t> offsets;
+			std::vector<T> flattened;
+			flat(offsets_tag, offsets);
+			flat(values_tag, flattened);
+			Unflatten(offsets, flattened, values, pool);
+		};
+		fedes::Model cached;
+		flat(Tag::Nodes, cached.nodes);
+		ragged(Tag::ElementOffsets, Tag::Elements, cached.elements);
+		ragged(Tag::DisplacementOffsets, Tag::Displacement, cached.displacement);
+		ragged(Tag::StressOffsets, Tag::Stress, cached.stress);
+		ragged(Tag::TotalStrainOffsets, Tag::TotalStrain, cached.total_strain);
+		ragged(Tag::PlasticStrainOffsets, Tag::PlasticStrain, cached.plastic_strain);
+		flat(Tag::AccumulatedStrain, cached.accumulated_strain);
+		flat(Tag::Integration, cached.integration);
+		flat(Tag::IntegrationOffsets, cached.integration_offsets);
+		flat(Tag::NodeIds, cached.node_ids);
+		flat(Tag::ElementIds, cached.element_ids);
+		flat(Tag::NodeOrder, cached.node_order);
+		flat(Tag::ElementOrder, cached.element_order);
+
+		for (const std::vector<size_t>& element : cached.elements) {
+			for (const size_t& node : element) {
+				if (node >= cached.nodes.size()) {
+					InvalidCache("element node out of range");
+				}
+			}
+		}
+		if (!cached.node_ids.empty() && cached.node_ids.size() != cached.nodes.size()) {
+			InvalidCache("node IDs do not match the nodes");
+		}
+		if (!cached.element_ids.empty() && cached.element_ids.size() != cached.elements.size()) {
+			InvalidCache("element IDs do not match the elements");
+		}
+		model = std::move(cached);
+	}
+
+	/*
+	 * @brief Whether the cache can stand in for parsing the sources: it is newer than every one of them and was written from
+	 * the same files
+	 */
+	bool ModelCacheFresh(const std::filesystem::path& path, const std::vector<std::filesystem::path>& sources) {
+		std::error_code error;
+		const std::filesystem::file_time_type cached = std::filesystem::last_write_time(path, error);
+		if (error) {
+			return false;
+		}
+		for (const std::filesystem::path& source : sources) {
+			const std::filesystem::file_time_type modified = std::filesystem::last_write_time(source, error);
+			if (error || modified >= cached) {
+				return false;
+			}
+		}
+		try {
+			const fedes::MappedFile file(path);
+			const std::string_view bytes = file.view();
+			const std::vector<Entry> table = Table(bytes);
+			const Entry* entry = Find(table, Tag::Sources);
+			if (entry == nullptr) {
+				return false;
+			}
+			const std::string_view recorded = bytes.substr(entry->offset, entry->size);
+			return Checksum(recorded) == entry->checksum && recorded == SourcesText(sources);
+		} catch (const std::exception& e) {
+			return false;
+		}
+	}
+
+	/*
+	 * @brief Cache file of a model, next to its first source, e.g. "model.inp.fedes"
+	 * @exception std::invalid_argument without sources
+	 */
+	std::filesystem::path ModelCachePath(const std::vector<std::filesystem::path>& sources) {
+		if (sources.empty()) {
+			throw std::invalid_argument("Model cache: no source files");
+		}
+		std::filesystem::path path = sources.front();
+		path += ".fedes";
+		return path;
+	}
+
+	/*
+	 * @brief Reads the model from its cache when it is fresh, otherwise parses the sources and writes the cache for the next
+	 * run. A cache which cannot be read or written is only logged, the model is then parsed as without one.
+	 * @param sources: files read by parse, the first one names the cache (see ModelCachePath)
+	 * @param parse: parses the sources into the model
+	 * @param pool: verifies and rebuilds the cached arrays on the thread pool if given
+	 */
+	void CachedRead(const std::vector<std::filesystem::path>& sources, fedes::Model& model,
+		const std::function<void(fedes::Model&)>& parse, std::optional<BS::thread_pool*> pool) {
+		const std::filesystem::path cache = ModelCachePath(sources);
+		if (fedes::ModelCacheFresh(cache, sources)) {
+			try {
+				fedes::ModelCacheRead(cache, model, pool);
+				FEDES_INFO("Model read from its cache {}", cache.string());
+				return;
+			} catch (const std::exception& e) {
+				FEDES_WARN("Model cache {} ignored: {}", cache.string(), e.what());
+			}
+		}
+		parse(model);
+		try {
+			fedes::ModelCacheWrite(cache, model, sources);
+		} catch (const std::exception& e) {
+			FEDES_WARN("Model cache {} not written: {}", cache.string(), e.what());
+		}
+	}
+}
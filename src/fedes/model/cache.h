@@ -0,0 +1,28 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/model/model.h"
+
+namespace fedes {
+
+	/*
+	 * @brief Native binary snapshot of a fedes::Model, so that the Ansys/Abaqus text files of a job are parsed once and later
+	 * runs read the arrays back as they are. The file holds a versioned header, a table of sections (one per array, ragged
+	 * arrays as offsets and values) and the 8 byte aligned sections, each with a 64 bit checksum. It is only meant as a local
+	 * cache: files of another version or byte order are rejected, and the caller parses the sources again.
+	 */
+	void ModelCacheWrite(const std::filesystem::path& path, const fedes::Model& model,
+		const std::vector<std::filesystem::path>& sources = {});
+	void ModelCacheRead(const std::filesystem::path& path, fedes::Model& model, std::optional<BS::thread_pool*> pool = std::nullopt);
+	[[nodiscard]] bool ModelCacheFresh(const std::filesystem::path& path, const std::vector<std::filesystem::path>& sources);
+	[[nodiscard]] std::filesystem::path ModelCachePath(const std::vector<std::filesystem::path>& sources);
+
+	void CachedRead(const std::vector<std::filesystem::path>& sources, fedes::Model& model,
+		const std::function<void(fedes::Model&)>& parse, std::optional<BS::thread_pool*> pool = std::nullopt);
+}
@@ -4,9 +4,15 @@
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <optional>
+#include <functional>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
 
 #include "fedes/model/parsers.h"
 #include "fedes/model/writers.h"
+#include "fedes/model/cache.h"
 #include "fedes/instrumentation/timer.h"
 #include "fedes/common/log.h"
 
@@ -17,33 +23,95 @@ namespace fedes {
 	 * @param source: starting model
 	 * @param target: model where data will/has been mapped to
 	 * @param id: dictates which example set to use (1, 2, 3, or 4). 
+	 * @param gauss_points: map stresses/strains to every Gauss point of the target elements instead of their centroids
+	 * @param pool: parses the meshes and prepares the target (integration points, FE data) on the thread pool if given
+	 * @param use_cache: read the parsed meshes from their binary caches (see CachedRead), written on the first run
 	 */
-	void SetExampleModels(fedes::Model& source, fedes::Model& target, size_t id) {
+	void SetExampleModels(fedes::Model& source, fedes::Model& target, size_t id, bool gauss_points, std::optional<BS::thread_pool*> pool,
+		bool use_cache) {
 #if (defined FEDES_VERBOSE == 1)
 		fedes::internal::Timer timer("Mesh Parsing");
 #endif
+		// Parses the meshes in parallel chunks when given a pool
+		auto abaqus_input = [&](const std::filesystem::path& path, fedes::Model& model) {
+			if (pool.has_value()) {
+				fedes::AbaqusInputReadParallel(path, model, *pool.value());
+			} else {
+				fedes::AbaqusInputReadMapped(path, model);
+			}
+		};
+		auto abaqus_output = [&](const std::filesystem::path& path, fedes::Model& model) {
+			if (pool.has_value()) {
+				fedes::AbaqusOutputReadParallel(path, model, *pool.value());
+			} else {
+				fedes::AbaqusOutputRead(path, model);
+			}
+		};
+		auto ansys_input = [&](const std::filesystem::path& path, fedes::Model& model) {
+			if (pool.has_value()) {
+				fedes::AnsysInputReadLisParallel(path, model, *pool.value());
+			} else {
+				fedes::AnsysInputReadLis(path, model);
+			}
+		};
+		// Each model is read from its binary cache next to its first source file, when newer than its sources
+		auto read = [&](const std::vector<std::filesystem::path>& sources, fedes::Model& model, const std::function<void(fedes::Model&)>& parse) {
+			if (use_cache) {
+				fedes::CachedRead(sources, model, parse, pool);
+			} else {
+				parse(model);
+			}
+		};
 		switch (id) {
-		case 1:
-			fedes::AnsysInputReadLis("../../models/Example1-Vane-big/Model1_Input-Ansys.txt", source);
-			fedes::AnsysOutputRead("../../models/Example1-Vane-big/Model1_output-Ansys.txt", source);
-			fedes::AbaqusInputRead("../../models/Example1-Vane-big/Model2-Input-Abaqus.inp", target);
+		case 1: {
+			const std::filesystem::path directory = "../../models/Example1-Vane-big";
+			read({ directory / "Model1_Input-Ansys.txt", directory / "Model1_output-Ansys.txt" }, source, [&](fedes::Model& model) {
+				ansys_input(directory / "Model1_Input-Ansys.txt", model);
+				fedes::AnsysOutputRead(directory / "Model1_output-Ansys.txt", model);
+			});
+			read({ directory / "Model2-Input-Abaqus.inp" }, target, [&](fedes::Model& model) {
+				abaqus_input(directory / "Model2-Input-Abaqus.inp", model);
+			});
 			break;
-		case 2:
-			fedes::AbaqusInputRead("../../models/Example-3D-medium/model1-input-Abaqus.inp", source);
-			fedes::AbaqusOutputRead("../../models/Example-3D-medium/model1-output-Abaqus.dat", source);
-			fedes::AbaqusInputRead("../../models/Example-3D-medium/Model-input-Abaqus.inp", target);
+		}
+		case 2: {
+			const std::filesystem::path directory = "../../models/Example-3D-medium";
+			read({ directory / "model1-input-Abaqus.inp", directory / "model1-output-Abaqus.dat" }, source, [&](fedes::Model& model) {
+				abaqus_input(directory / "model1-input-Abaqus.inp", model);
+				abaqus_output(directory / "model1-output-Abaqus.dat", model);
+			});
+			read({ directory / "Model-input-Abaqus.inp" }, target, [&](fedes::Model& model) {
+				abaqus_input(directory / "Model-input-Abaqus.inp", model);
+			});
 			break;
-		case 3:
-			fedes::MorpheoInputOutputRead("../../models/Example1-ManufacturingProcessChain-2ndLoop/Process1-HeatTreatment-XML-format.vtu", source);
-			fedes::AbaqusInputRead("../../models/Example1-ManufacturingProcessChain-2ndLoop/Process2-ShotPeening-Abaqus.inp", target);
+		}
+		case 3: {
+			const std::filesystem::path directory = "../../models/Example1-ManufacturingProcessChain-2ndLoop";
+			read({ directory / "Process1-HeatTreatment-XML-format.vtu" }, source, [&](fedes::Model& model) {
+				fedes::MorpheoInputOutputRead(directory / "Process1-HeatTreatment-XML-format.vtu", model);
+			});
+			read({ directory / "Process2-ShotPeening-Abaqus.inp" }, target, [&](fedes::Model& model) {
+				abaqus_input(directory / "Process2-ShotPeening-Abaqus.inp", model);
+			});
 			break;
-		case 4:
-			fedes::AbaqusInputRead("../../models/Example1-ManufacturingProcessChain-2ndLoop/Process-1-Abaqus-Input.inp", source);
-			fedes::AbaqusOutputRead("../../models/Example1-ManufacturingProcessChain-2ndLoop/Process-1-Abaqus-Output.dat", source);
-			fedes::MorpheoInputRead("../../models/Example1-ManufacturingProcessChain-2ndLoop/Process2-Machining-XML-input.vtu", target);
+		}
+		case 4: {
+			const std::filesystem::path directory = "../../models/Example1-ManufacturingProcessChain-2ndLoop";
+			read({ directory / "Process-1-Abaqus-Input.inp", directory / "Process-1-Abaqus-Output.dat" }, source, [&](fedes::Model& model) {
+				abaqus_input(directory / "Process-1-Abaqus-Input.inp", model);
+				abaqus_output(directory / "Process-1-Abaqus-Output.dat", model);
+			});
+			read({ directory / "Process2-Machining-XML-input.vtu" }, target, [&](fedes::Model& model) {
+				fedes::MorpheoInputRead(directory / "Process2-Machining-XML-input.vtu", model);
+			});
 			break;
 		}
-		target.SetTargetIndexes(source);
+		}
+		if (pool.has_value()) {
+			target.SetTargetIndexes(source, *pool.value(), gauss_points);
+		} else {
+			target.SetTargetIndexes(source, gauss_points);
+		}
 		FEDES_INFO("[Source mesh] Number of nodes: {}, Number of elements: {}", source.nodes.size(), source.elements.size());
 		FEDES_INFO("[Target mesh] Number of nodes: {}, Number of elements: {}, Number of integration points: {}", 
 			target.nodes.size(), target.elements.size(), target.integration.size());
@@ -2,10 +2,14 @@
 
 #include <filesystem>
 #include <string>
+#include <optional>
+
+#include <BS_thread_pool.hpp>
 
 #include "fedes/model/parsers.h"
 #include "fedes/model/writers.h"
 
 namespace fedes {
-	void SetExampleModels(fedes::Model& source, fedes::Model& target, size_t id);
+	void SetExampleModels(fedes::Model& source, fedes::Model& target, size_t id, bool gauss_points = false,
+	                      std::optional<BS::thread_pool*> pool = std::nullopt, bool use_cache = true);
 }
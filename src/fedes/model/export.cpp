@@ -4,6 +4,9 @@
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <optional>
+
+#include <BS_thread_pool.hpp>
 
 #include "fedes/model/parsers.h"
 #include "fedes/model/writers.h"
@@ -16,13 +19,19 @@ namespace fedes {
 	 * @param source: starting model
 	 * @param target: model where data will/has been mapped to
 	 * @param file_suffix: filename suffixes (before file extension) to "source" and "target". E.g. "oct-npm" = "target-oct-npm.xml"
+	 * Models renumbered with Model::Reorder() are first restored to their file order.
+	 * @param format: ascii, binary or compressed .vtu, see Model::Export
+	 * @param pool: formats ascii arrays, or compresses blocks, in parallel
 	 * @exception Propagtes std::ofstream::failure
 	 */
 	void ExportModels(fedes::Model& source, fedes::Model& target,
-		              const std::string& file_suffix_source, const std::string& file_suffix_target) {
+		              const std::string& file_suffix_source, const std::string& file_suffix_target, VtuFormat format,
+		              std::optional<BS::thread_pool*> pool) {
+		source.RestoreOrder();
+		target.RestoreOrder();
 		try {
-			source.Export("source-" + file_suffix_source, false, true, "../../exports");
-			target.Export("target-" + file_suffix_target, true, true, "../../exports");
+			source.Export("source-" + file_suffix_source, false, true, "../../exports", format, pool);
+			target.Export("target-" + file_suffix_target, true, true, "../../exports", format, pool);
 		} catch (const std::ofstream::failure& e) {
 			throw;
 		}
@@ -32,9 +41,10 @@ namespace fedes {
 	 * @brief Like ExportModels, but only takes one model & exports the raw model (with no FEA data)
 	 * @exception Propagtes std::ofstream::failure
 	 */
-	void ExportRawModel(fedes::Model& model, const std::string& file_suffix) {
+	void ExportRawModel(fedes::Model& model, const std::string& file_suffix, VtuFormat format, std::optional<BS::thread_pool*> pool) {
+		model.RestoreOrder();
 		try {
-			model.Export("target-raw-" + file_suffix, false, false, "../../exports");
+			model.Export("target-raw-" + file_suffix, false, false, "../../exports", format, pool);
 		} catch (const std::ofstream::failure& e) {
 			throw;
 		}
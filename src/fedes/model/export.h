@@ -2,6 +2,9 @@
 
 #include <filesystem>
 #include <string>
+#include <optional>
+
+#include <BS_thread_pool.hpp>
 
 #include "fedes/model/parsers.h"
 #include "fedes/model/writers.h"
@@ -9,8 +12,10 @@
 namespace fedes {
 
 	void ExportModels(fedes::Model& source, fedes::Model& target,
-		const std::string& file_source_suffix,  const std::string& file_target_suffix);
+		const std::string& file_source_suffix,  const std::string& file_target_suffix, VtuFormat format = VtuFormat::Ascii,
+		std::optional<BS::thread_pool*> pool = std::nullopt);
 
-	void ExportRawModel(fedes::Model& model, const std::string& file_suffix);
+	void ExportRawModel(fedes::Model& model, const std::string& file_suffix, VtuFormat format = VtuFormat::Ascii,
+		std::optional<BS::thread_pool*> pool = std::nullopt);
 
 }
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "fedes/model/id_map.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fedes {
+
+	namespace {
+		// Fibonacci hashing (top bits of the product) spreads the consecutive runs of IDs of every part over the whole table
+		size_t Hash(size_t id, size_t mask) {
+			const int bits = std::popcount(mask);
+			return static_cast<size_t>((static_cast<uint64_t>(id) * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+		}
+	}
+
+	IdMap::IdMap(const std::vector<size_t>& ids, size_t count) {
+		if (ids.empty()) {
+			count_ = count;
+			return;
+		}
+		Reserve(ids.size());
+		for (size_t id : ids) {
+			Insert(id);
+		}
+	}
+
+	/*
+	 * @brief Sizes the table for count IDs in total, should they turn out sparse
+	 */
+	void IdMap::Reserve(size_t count) {
+		reserved_ = std::max(reserved_, count);
+		if (!ids_.empty()) {
+			ids_.reserve(count);
+			Grow(count);
+		}
+	}
+
+	/*
+	 * @brief Adds the ID of the next index
+	 * @return the internal index of the ID, i.e. the number of IDs inserted before it
+	 * @exception std::invalid_argument for an ID inserted before (or the reserved value SIZE_MAX)
+	 */
+	size_t IdMap::Insert(size_t id) {
+		if (id == empty) {
+			throw std::invalid_argument("ID out of range");
+		}
+		const size_t index = count_;
+		if (dense()) {
+			if (id == count_ + 1) {
+				++count_;
+				return index;
+			}
+			if (id != 0 && id <= count_) {
+				throw std::invalid_argument("Duplicate ID " + std::to_string(id));
+			}
+			Sparsify();
+		}
+		if (Find(id).has_value()) {
+			throw std::invalid_argument("Duplicate ID " + std::to_string(id));
+		}
+		if (2 * (count_ + 1) > table_.size()) {
+			Grow(std::max(count_ + 1, reserved_));
+		}
+		Place(id, index);
+		ids_.push_back(id);
+		++count_;
+		return index;
+	}
+
+	/*
+	 * @brief Internal index of an external ID, empty if the ID was never inserted
+	 */
+	std::optional<size_t> IdMap::Find(size_t id) const {
+		if (ids_.empty()) {
+			if (id == 0 || id > count_) {
+				return std::nullopt;
+			}
+			return id - 1;
+		}
+		const size_t mask = table_.size() - 1;
+		for (size_t slot = Hash(id, mask); table_[slot].id != empty; slot = (slot + 1) & mask) {
+			if (table_[slot].id == id) {
+				return table_[slot].index;
+			}
+		}
+		return std::nullopt;
+	}
+
+	/*
+	 * @brief Like Find
+	 * @exception std::out_of_range if the ID was never inserted
+	 */
+	size_t IdMap::At(size_t id) const {
+		const std::optional<size_t> index = Find(id);
+		if (!index.has_value()) {
+			throw std::out_of_range("Unknown ID " + std::to_string(id));
+		}
+		return index.value();
+	}
+
+	/*
+	 * @brief External ID of an internal index
+	 */
+	size_t IdMap::Id(size_t index) const {
+		return ids_.empty() ? index + 1 : ids_[index];
+	}
+
+	/*
+	 * @brief Hands over the external IDs in index order, for fedes::Model::node_ids/element_ids: empty while dense
+	 */
+	std::vector<size_t> IdMap::Release() {
+		std::vector<size_t> ids = std::move(ids_);
+		*this = IdMap();
+		return ids;
+	}
+
+	/*
+	 * @brief Switches from the implicit 1, 2, 3, ... sequence to the table, once an ID breaks it
+	 */
+	void IdMap::Sparsify() {
+		ids_.reserve(std::max(reserved_, count_ + 1));
+		for (size_t i = 0; i < count_; ++i) {
+			ids_.push_back(i + 1);
+		}
+		Grow(std::max(count_ + 1, reserved_));
+	}
+
+	/*
+	 * @brief Rehashes into a table at most half full with count IDs
+	 */
+	void IdMap::Grow(size_t count) {
+		const size_t capacity = std::bit_ceil(std::max<size_t>(16, 2 * count));
+		if (capacity <= table_.size()) {
+			return;
+		}
+		table_.assign(capacity, Slot());
+		for (size_t i = 0; i < ids_.size(); ++i) {
+			Place(ids_[i], i);
+		}
+	}
+
+	void IdMap::Place(size_t id, size_t index) {
+		const size_t mask = table_.size() - 1;
+		size_t slot = Hash(id, mask);
+		while (table_[slot].id != empty) {
+			slot = (slot + 1) & mask;
+		}
+		table_[slot] = { id, index };
+	}
+}
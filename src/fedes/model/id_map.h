@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace fedes {
+
+	/*
+	 * @brief Maps the external IDs of a file (node/element numbers, possibly sparse or offset per assembly part) to dense
+	 * internal indexes, in the order the IDs are inserted. While the IDs are 1, 2, 3, ... (the common case) no table is kept
+	 * and lookups are arithmetic. The first ID breaking the sequence switches to an open addressing hash table (linear
+	 * probing, power of two capacity, at most half full), so memory grows with the number of IDs rather than the largest one.
+	 * Lookups are const and may run concurrently once the map is built.
+	 */
+	class IdMap {
+	public:
+		IdMap() = default;
+
+		/*
+		 * @brief Map of IDs kept as on fedes::Model (node_ids/element_ids): empty for the IDs 1 to count
+		 */
+		IdMap(const std::vector<size_t>& ids, size_t count);
+
+		void Reserve(size_t count);
+		size_t Insert(size_t id);
+		[[nodiscard]] std::optional<size_t> Find(size_t id) const;
+		[[nodiscard]] size_t At(size_t id) const;
+		[[nodiscard]] size_t Id(size_t index) const;
+
+		[[nodiscard]] size_t size() const {
+			return count_;
+		}
+
+		[[nodiscard]] bool dense() const {
+			return ids_.empty();
+		}
+
+		std::vector<size_t> Release();
+
+	private:
+		static constexpr size_t empty = std::numeric_limits<size_t>::max();
+
+		struct Slot {
+			size_t id = empty;
+			size_t index = 0;
+		};
+
+		size_t count_ = 0; // @brief: While dense, the IDs 1 to count_ were inserted in order
+		size_t reserved_ = 0;
+		std::vector<size_t> ids_; // @brief: External ID of every index, once sparse
+		std::vector<Slot> table_;
+
+		void Sparsify();
+		void Grow(size_t capacity);
+		void Place(size_t id, size_t index);
+	};
+}
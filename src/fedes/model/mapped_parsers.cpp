@@ -0,0 +1,788 @@
+// mapped_parsers.cpp -> parsers scanning memory mapped files, serially or in parallel chunks, equivalent to their FEDES v2
+// ports in parsers.cpp
+
+#include "fedes/model/parsers.h"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <initializer_list>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/model/model.h"
+#include "fedes/model/id_map.h"
+#include "fedes/model/streaming.h"
+#include "fedes/maths/element_type.h"
+#include "fedes/common/mapped_file.h"
+#include "fedes/common/scanning.h"
+#include "fedes/common/scheduling.h"
+
+namespace fedes {
+
+	namespace {
+		/*
+		 * @brief Byte range [begin, end) of the data lines of a keyword section
+		 */
+		struct Section {
+			size_t begin;
+			size_t end;
+		};
+
+		/*
+		 * @brief Data lines of the first *Node section and of every *Element section (except *Element Output), as read by
+		 * AbaqusInputRead. Any line containing a '*' (keywords, ** comments) ends a section.
+		 */
+		void AbaqusSections(std::string_view text, std::vector<Section>& node_sections, std::vector<Section>& element_sections) {
+			std::vector<Section>* open = nullptr;
+			size_t position = 0;
+			while (position < text.size()) {
+				const size_t line_begin = position;
+				const std::string_view line = NextLine(text, position);
+				if (line.find('*') == std::string_view::npos) {
+					continue;
+				}
+				if (open != nullptr) {
+					open->back().end = line_begin;
+					open = nullptr;
+				}
+				if (StartsWithLower(line, "*node") && node_sections.empty()) {
+					open = &node_sections;
+				} else if (StartsWithLower(line, "*element") && !StartsWithLower(line, "*element output")) {
+					open = &element_sections;
+				}
+				if (open != nullptr) {
+					open->push_back({ position, text.size() });
+				}
+			}
+		}
+
+		[[noreturn]] void InvalidLine(const char* what, std::string_view line) {
+			throw std::invalid_argument(std::string("Invalid ") + what + " line \"" + std::string(line) + "\"");
+		}
+
+		/*
+		 * @brief Parses "id, x, y, z" lines into nodes, a missing z coordinate is 0
+		 * @param on_node: called as on_node(id, node) for every non-blank line
+		 */
+		template <typename OnNode>
+		void ParseAbaqusNodes(std::string_view text, OnNode&& on_node) {
+			size_t position = 0;
+			while (position < text.size()) {
+				const std::string_view line = NextLine(text, position);
+				size_t p = 0;
+				size_t id;
+				if (AtEnd(line, p)) {
+					continue;
+				}
+				fedes::Vector3<double> node(0.0);
+				if (!ParseNumber(line, p, id) || !SkipSeparator(line, p, ',') || !ParseNumber(line, p, node.x) ||
+					!SkipSeparator(line, p, ',') || !ParseNumber(line, p, node.y)) {
+					InvalidLine("node", line);
+				}
+				if (SkipSeparator(line, p, ',') && !AtEnd(line, p) && !ParseNumber(line, p, node.z)) {
+					InvalidLine("node", line);
+				}
+				on_node(id, node);
+			}
+		}
+
+		/*
+		 * @brief Parses "id, n1, n2, ..." lines into elements, a line ending with a ',' continues on the next line
+		 * @param on_element: called as on_element(id, node ids) for every line not ending with a ','
+		 */
+		template <typename OnElement>
+		void ParseAbaqusElements(std::string_view text, OnElement&& on_element) {
+			std::vector<size_t> element;
+			size_t id = 0;
+			bool continued = false;
+			size_t position = 0;
+			while (position < text.size()) {
+				const std::string_view line = NextLine(text, position);
+				size_t p = 0;
+				if (AtEnd(line, p)) {
+					continue;
+				}
+				// A continuation line starts with a node, otherwise the element ID comes first
+				bool separator = !continued;
+				if (!continued) {
+					if (!ParseNumber(line, p, id)) {
+						InvalidLine("element", line);
+					}
+					element.clear();
+				}
+
+				continued = false;
+				while (true) {
+					if (separator && !SkipSeparator(line, p, ',')) {
+						if (!AtEnd(line, p)) {
+							InvalidLine("element", line);
+						}
+						break;
+					}
+					if (AtEnd(line, p)) {
+						continued = true;
+						break;
+					}
+					size_t node;
+					if (!ParseNumber(line, p, node) || node == 0) {
+						InvalidLine("element", line);
+					}
+					element.push_back(node);
+					separator = true;
+				}
+				if (!continued) {
+					on_element(id, std::span<const size_t>(element));
+				}
+			}
+		}
+
+		/*
+		 * @brief Whether the last non-blank character before position is a ',', i.e. position continues an element
+		 */
+		bool Continues(std::string_view text, size_t begin, size_t position) {
+			while (position > begin) {
+				const char c = text[--position];
+				if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+					return c == ',';
+				}
+			}
+			return false;
+		}
+
+		/*
+		 * @brief Number of records parsed from the text: non-blank lines, except those continued by the next line if
+		 * `continuations` is set (elements)
+		 */
+		size_t CountAbaqusRecords(std::string_view text, bool continuations) {
+			size_t count = 0;
+			size_t position = 0;
+			while (position < text.size()) {
+				const size_t begin = position;
+				const std::string_view line = NextLine(text, position);
+				if (!AtEnd(line, 0) && !(continuations && Continues(text, begin, begin + line.size()))) {
+					++count;
+				}
+			}
+			return count;
+		}
+
+		// Smallest chunk worth a task of its own, smaller sections are parsed as one chunk
+		constexpr size_t minimum_chunk = 1 << 16;
+
+		/*
+		 * @brief Splits a section into about `count` chunks of equal size, each starting at the beginning of a line. With
+		 * `continuations`, a chunk never starts on a line continuing the element of the line before it.
+		 */
+		void LineChunks(std::string_view text, Section section, size_t count, bool continuations, std::vector<Section>& chunks) {
+			count = std::clamp<size_t>((section.end - section.begin) / minimum_chunk, 1, count);
+			size_t begin = section.begin;
+			for (size_t c = 1; c <= count && begin < section.end; ++c) {
+				size_t end = std::max(begin, section.begin + (section.end - section.begin) * c / count);
+				const std::string_view view = text.substr(0, section.end);
+				if (end > section.begin && end < section.end && text[end - 1] != '\n') {
+					NextLine(view, end);
+				}
+				while (continuations && end < section.end && Continues(text, section.begin, end)) {
+					NextLine(view, end);
+				}
+				if (end > begin) {
+					chunks.push_back({ begin, end });
+				}
+				begin = end;
+			}
+		}
+
+		/*
+		 * @brief Line aligned chunks of all sections, about `chunks_per_section` each
+		 */
+		std::vector<Section> SectionChunks(std::string_view text, const std::vector<Section>& sections, size_t chunks_per_section,
+		                                   bool continuations) {
+			std::vector<Section> chunks;
+			for (const Section& section : sections) {
+				LineChunks(text, section, chunks_per_section, continuations, chunks);
+			}
+			return chunks;
+		}
+
+		/*
+		 * @brief Parses line aligned chunks concurrently into presized storage, in two phases: count(chunk) gives the number
+		 * of records of every chunk, whose prefix sums are the index of each chunk's first record, then resize(total) sizes
+		 * the outputs once, and parse(chunk, first) writes the chunk's records from that index on. Records keep the order
+		 * of the file.
+		 * @exception Rethrows the first exception of count or parse
+		 */
+		template <typename Count, typename Resize, typename Parse>
+		void ParallelParse(std::string_view text, const std::vector<Section>& chunks, BS::thread_pool& pool, Count&& count,
+		                   Resize&& resize, Parse&& parse) {
+			std::vector<size_t> offsets(chunks.size() + 1, 0);
+			fedes::ParallelFor(pool, 0, chunks.size(),
+				[&](const uint32_t& a, const uint32_t& b)
+				{
+					for (uint32_t c = a; c < b; c++) {
+						offsets[c + 1] = count(text.substr(chunks[c].begin, chunks[c].end - chunks[c].begin));
+					}
+				}, 1).get();
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+			resize(offsets.back());
+			fedes::ParallelFor(pool, 0, chunks.size(),
+				[&](const uint32_t& a, const uint32_t& b)
+				{
+					for (uint32_t c = a; c < b; c++) {
+						parse(text.substr(chunks[c].begin, chunks[c].end - chunks[c].begin), offsets[c]);
+					}
+				}, 1).get();
+		}
+
+		/*
+		 * @brief Map of the IDs read, in file order, which also rejects duplicates. The model keeps them (node_ids or
+		 * element_ids) unless they are simply 1, 2, 3, ...
+		 * @exception std::invalid_argument for duplicate IDs
+		 */
+		fedes::IdMap CompactIds(const std::vector<size_t>& ids, std::vector<size_t>& model_ids) {
+			fedes::IdMap map;
+			map.Reserve(ids.size());
+			for (size_t id : ids) {
+				map.Insert(id);
+			}
+			model_ids = map.dense() ? std::vector<size_t>() : ids;
+			return map;
+		}
+
+		/*
+		 * @brief Node indexes of an element from the node IDs of the file
+		 * @exception std::out_of_range for IDs of nodes which were not read
+		 */
+		std::vector<size_t> NodeIndexes(std::span<const size_t> ids, const fedes::IdMap& node_map) {
+			std::vector<size_t> indexes(ids.size());
+			std::transform(ids.begin(), ids.end(), indexes.begin(), [&](size_t id) { return node_map.At(id); });
+			return indexes;
+		}
+
+		/*
+		 * @brief Reads the nodes, then the elements, of a mesh file into an empty model, compacting their IDs
+		 * @param parse_nodes: called as parse_nodes(text, on_node), e.g. ParseAbaqusNodes
+		 * @param parse_elements: called as parse_elements(text, on_element), e.g. ParseAbaqusElements
+		 */
+		template <typename ParseNodes, typename ParseElements>
+		void ReadMesh(std::string_view text, const std::vector<Section>& node_sections, const std::vector<Section>& element_sections,
+		              fedes::Model& model, ParseNodes&& parse_nodes, ParseElements&& parse_elements) {
+			std::vector<size_t> ids;
+			for (const Section& section : node_sections) {
+				parse_nodes(text.substr(section.begin, section.end - section.begin), [&](size_t id, const fedes::Vector3<double>& node) {
+					model.nodes.push_back(node);
+					ids.push_back(id);
+				});
+			}
+			const fedes::IdMap node_map = CompactIds(ids, model.node_ids);
+
+			ids.clear();
+			for (const Section& section : element_sections) {
+				parse_elements(text.substr(section.begin, section.end - section.begin), [&](size_t id, std::span<const size_t> nodes) {
+					model.elements.push_back(NodeIndexes(nodes, node_map));
+					ids.push_back(id);
+				});
+			}
+			CompactIds(ids, model.element_ids);
+		}
+
+		/*
+		 * @brief Parallel counterpart of ReadMesh, parsing about `chunks_per_section` chunks of every section concurrently
+		 * @param count_nodes, count_elements: number of records in a chunk, see ParallelParse
+		 * @param continuations: whether an element may continue on the next line (Abaqus), see LineChunks
+		 */
+		template <typename CountNodes, typename ParseNodes, typename CountElements, typename ParseElements>
+		void ParallelReadMesh(std::string_view text, const std::vector<Section>& node_sections, const std::vector<Section>& element_sections,
+		                      bool continuations, fedes::Model& model, BS::thread_pool& pool, CountNodes&& count_nodes,
+		                      ParseNodes&& parse_nodes, CountElements&& count_elements, ParseElements&& parse_elements) {
+			const size_t chunks_per_section = 4 * std::max<size_t>(1, pool.get_thread_count());
+			std::vector<size_t> ids;
+			ParallelParse(text, SectionChunks(text, node_sections, chunks_per_section, false), pool, count_nodes,
+				[&](size_t count) {
+					model.nodes.resize(count);
+					ids.resize(count);
+				},
+				[&](std::string_view chunk, size_t i) {
+					parse_nodes(chunk, [&](size_t id, const fedes::Vector3<double>& node) {
+						model.nodes[i] = node;
+						ids[i++] = id;
+					});
+				});
+			const fedes::IdMap node_map = CompactIds(ids, model.node_ids);
+
+			ParallelParse(text, SectionChunks(text, element_sections, chunks_per_section, continuations), pool, count_elements,
+				[&](size_t count) {
+					model.elements.resize(count);
+					ids.resize(count);
+				},
+				[&](std::string_view chunk, size_t i) {
+					parse_elements(chunk, [&](size_t id, std::span<const size_t> nodes) {
+						model.elements[i] = NodeIndexes(nodes, node_map);
+						ids[i++] = id;
+					});
+				});
+			CompactIds(ids, model.element_ids);
+		}
+
+		/*
+		 * @brief Splits a line into its blank separated tokens
+		 * @return the number of tokens, of which only the first N are stored
+		 */
+		template <size_t N>
+		size_t Tokens(std::string_view line, std::array<std::string_view, N>& tokens) {
+			size_t count = 0;
+			size_t position = 0;
+			for (std::string_view token = NextToken(line, position); !token.empty(); token = NextToken(line, position)) {
+				if (count < N) {
+					tokens[count] = token;
+				}
+				++count;
+			}
+			return count;
+		}
+
+		/*
+		 * @brief Converts a whole token, as std::stod/std::stoul would in parsers.cpp
+		 */
+		template <typename T>
+		T Token(std::string_view token, const char* what, std::string_view line) {
+			size_t p = 0;
+			T value{};
+			if (!ParseNumber(token, p, value) || p != token.size()) {
+				InvalidLine(what, line);
+			}
+			return value;
+		}
+
+		bool Contains(std::string_view line, std::string_view text) {
+			return line.find(text) != std::string_view::npos;
+		}
+
+		bool ContainsLower(std::string_view line, std::string_view lowercase_text) {
+			for (size_t i = 0; i + lowercase_text.size() <= line.size(); ++i) {
+				if (StartsWithLower(line.substr(i), lowercase_text)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/*
+		 * @brief Tables of an Abaqus .dat file, as located by AbaqusOutputRead
+		 */
+		enum class AbaqusTable { Stress, Displacement, TotalStrain, PlasticStrain };
+
+		struct TableSection {
+			AbaqusTable table;
+			Section section;
+		};
+
+		/*
+		 * @brief Data lines of the nodal tables, from their header (S11 S22, U1 U2, E11 E22, PE11 PE22) to the next header or
+		 * MAXIMUM line
+		 */
+		void AbaqusTables(std::string_view text, std::vector<TableSection>& tables) {
+			bool open = false;
+			size_t position = 0;
+			while (position < text.size()) {
+				const size_t line_begin = position;
+				const std::string_view line = NextLine(text, position);
+				// Later matches win, e.g. a PE11 PE22 header also contains E11 E22
+				std::optional<AbaqusTable> table;
+				if (Contains(line, "S11") && Contains(line, "S22")) {
+					table = AbaqusTable::Stress;
+				}
+				if (Contains(line, "U1") && Contains(line, "U2")) {
+					table = AbaqusTable::Displacement;
+				}
+				if (Contains(line, "E11") && Contains(line, "E22")) {
+					table = AbaqusTable::TotalStrain;
+				}
+				if (Contains(line, "PE11") && Contains(line, "PE22")) {
+					table = AbaqusTable::PlasticStrain;
+				}
+				if (!table.has_value() && !Contains(line, "MAXIMUM")) {
+					continue;
+				}
+				if (open) {
+					tables.back().section.end = line_begin;
+					open = false;
+				}
+				if (table.has_value()) {
+					tables.push_back({ table.value(), { position, text.size() } });
+					open = true;
+				}
+			}
+		}
+
+		/*
+		 * @brief Field name of a table's rows, as in fedes::Model
+		 */
+		std::string_view FieldName(AbaqusTable table) {
+			switch (table) {
+			case AbaqusTable::Stress:
+				return "stress";
+			case AbaqusTable::Displacement:
+				return "displacement";
+			case AbaqusTable::TotalStrain:
+				return "total_strain";
+			case AbaqusTable::PlasticStrain:
+				return "plastic_strain";
+			}
+			return "";
+		}
+
+		/*
+		 * @brief Parses the "node value value ..." rows of a table like AbaqusOutputRead: rows are told apart by their number
+		 * of columns, and rows of any other length are ignored
+		 * @param on_field: called as on_field(name, node id, values) for every row, plastic strain rows also report their
+		 * "accumulated_strain"
+		 */
+		template <typename OnField>
+		void ParseAbaqusTable(std::string_view text, AbaqusTable table, OnField&& on_field) {
+			const std::string_view name = FieldName(table);
+			std::array<std::string_view, 10> tokens;
+			size_t position = 0;
+			while (position < text.size()) {
+				const std::string_view line = NextLine(text, position);
+				if (Contains(line, "NOTE") || (table == AbaqusTable::PlasticStrain && ContainsLower(line, "all"))) {
+					continue;
+				}
+				const size_t count = Tokens(line, tokens);
+				auto value = [&](size_t i) { return Token<double>(tokens[i], "table", line); };
+				auto emit = [&](std::string_view field, std::initializer_list<double> values) {
+					on_field(field, Token<size_t>(tokens[0], "table", line), std::span<const double>(values.begin(), values.size()));
+				};
+				if (table == AbaqusTable::Displacement) {
+					if (count == 4) {
+						emit(name, { value(1), value(2), value(3) });
+					} else if (count == 3) {
+						emit(name, { value(1), value(2) });
+					}
+					continue;
+				}
+				// The plastic strain rows end with the accumulated strain (and a further column for 3D elements)
+				const size_t columns = table == AbaqusTable::PlasticStrain ? count - 2 : count;
+				if (columns == 7) {
+					emit(name, { value(1), value(2), value(3), value(4), value(6), value(5) });
+				} else if (columns == 5) {
+					emit(name, { value(1), value(2), value(3), value(4) });
+				} else if (columns == 4) {
+					emit(name, { value(1), value(2), 0.0, value(3) });
+				} else {
+					continue;
+				}
+				if (table == AbaqusTable::PlasticStrain) {
+					emit("accumulated_strain", { value(count == 9 ? 7 : count - 2) });
+				}
+			}
+		}
+
+		/*
+		 * @brief Node and element listings of an Ansys .lis file, as located by AnsysInputReadLis
+		 */
+		void AnsysSections(std::string_view text, std::vector<Section>& node_sections, std::vector<Section>& element_sections) {
+			std::vector<Section>* open = nullptr;
+			size_t position = 0;
+			while (position < text.size()) {
+				const size_t line_begin = position;
+				const std::string_view line = NextLine(text, position);
+				std::vector<Section>* header = nullptr;
+				if (Contains(line, "NODE") && Contains(line, "X")) {
+					header = &node_sections;
+				} else if (Contains(line, "ELEM") && Contains(line, "MAT") && Contains(line, "TYP")) {
+					header = &element_sections;
+				}
+				if (header == nullptr) {
+					continue;
+				}
+				if (open != nullptr) {
+					open->back().end = line_begin;
+				}
+				open = header;
+				open->push_back({ position, text.size() });
+			}
+		}
+
+		/*
+		 * @brief Whether a line of a listing holds data rather than a (repeated page) header, `keyword` being NODE or ELEM
+		 */
+		bool AnsysDataLine(std::string_view line, std::string_view keyword) {
+			return !Contains(line, keyword) && !AtEnd(line, 0) && !Contains(line, "LIST") && !Contains(line, "SORT");
+		}
+
+		size_t CountAnsysLines(std::string_view text, std::string_view keyword) {
+			size_t count = 0;
+			size_t position = 0;
+			while (position < text.size()) {
+				count += AnsysDataLine(NextLine(text, position), keyword);
+			}
+			return count;
+		}
+
+		/*
+		 * @brief Parses "id x y z ..." rows of the node listing
+		 * @param on_node: called as on_node(id, node) for every row
+		 */
+		template <typename OnNode>
+		void ParseAnsysNodes(std::string_view text, OnNode&& on_node) {
+			std::array<std::string_view, 4> tokens;
+			size_t position = 0;
+			while (position < text.size()) {
+				const std::string_view line = NextLine(text, position);
+				if (!AnsysDataLine(line, "NODE")) {
+					continue;
+				}
+				if (Tokens(line, tokens) < 4) {
+					InvalidLine("node", line);
+				}
+				on_node(Token<size_t>(tokens[0], "node", line), fedes::Vector3<double>(Token<double>(tokens[1], "node", line),
+					Token<double>(tokens[2], "node", line), Token<double>(tokens[3], "node", line)));
+			}
+		}
+
+		/*
+		 * @brief Parses element rows like AnsysInputReadLis: repeated trailing nodes tell tetrahedra and wedges from hexahedra
+		 * @param on_element: called as on_element(id, node ids) for every row
+		 */
+		template <typename OnElement>
+		void ParseAnsysElements(std::string_view text, OnElement&& on_element) {
+			std::array<std::string_view, 32> tokens;
+			size_t position = 0;
+			while (position < text.size()) {
+				const std::string_view line = NextLine(text, position);
+				if (!AnsysDataLine(line, "ELEM")) {
+					continue;
+				}
+				const size_t count = Tokens(line, tokens);
+				if (count < 13 || count > tokens.size()) {
+					InvalidLine("element", line);
+				}
+				auto node = [&](size_t i) {
+					const size_t id = Token<size_t>(tokens[i], "element", line);
+					if (id == 0) {
+						InvalidLine("element", line);
+					}
+					return id;
+				};
+				const size_t id = Token<size_t>(tokens[0], "element", line);
+				const size_t last = count - 1;
+				if (tokens[last] != tokens[last - 1]) { // Hex
+					const std::array<size_t, 8> nodes{ node(5), node(6), node(7), node(8), node(9), node(10), node(11), node(12) };
+					on_element(id, std::span<const size_t>(nodes));
+				} else if (tokens[last] == tokens[last - 2]) { // Tetrahedron
+					const std::array<size_t, 4> nodes{ node(6), node(7), node(8), node(10) };
+					on_element(id, std::span<const size_t>(nodes));
+				} else { // Wedge
+					const std::array<size_t, 6> nodes{ node(5), node(6), node(7), node(9), node(10), node(11) };
+					on_element(id, std::span<const size_t>(nodes));
+				}
+			}
+		}
+	}
+
+	/*
+	 * @brief Maps nodes and elements to fedes::Model from an Abaqus .inp file, like AbaqusInputRead but scanning the memory
+	 * mapped file without copying, lowercasing or splitting any line. The sections are located first, so that the node and
+	 * element arrays are reserved once, then the numbers are converted in place with std::from_chars. Elements continued
+	 * over several lines (trailing ',') are joined. Node IDs are compacted (see IdMap), so that elements refer to node
+	 * indexes however sparse the numbering of the file is, the IDs of the file are kept in node_ids/element_ids.
+	 * @param path: Path to the file
+	 * @param model: Empty model which will be updated by reference
+	 * @exception std::ifstream::failure if the file cannot be mapped, std::invalid_argument for malformed node/element lines
+	 * or duplicate IDs, std::out_of_range for elements referring to unknown nodes
+	 */
+	void AbaqusInputReadMapped(const std::filesystem::path& path, fedes::Model& model) {
+		const fedes::MappedFile file(path);
+		const std::string_view text = file.view();
+
+		std::vector<Section> node_sections, element_sections;
+		AbaqusSections(text, node_sections, element_sections);
+
+		size_t node_lines = 0, element_lines = 0;
+		for (const Section& section : node_sections) {
+			node_lines += CountLines(text.substr(section.begin, section.end - section.begin));
+		}
+		for (const Section& section : element_sections) {
+			element_lines += CountLines(text.substr(section.begin, section.end - section.begin));
+		}
+		model.nodes.reserve(node_lines);
+		model.elements.reserve(element_lines);
+
+		ReadMesh(text, node_sections, element_sections, model,
+			[](std::string_view chunk, auto&& on_node) { ParseAbaqusNodes(chunk, on_node); },
+			[](std::string_view chunk, auto&& on_element) { ParseAbaqusElements(chunk, on_element); });
+	}
+
+	/*
+	 * @brief Parallel counterpart of AbaqusInputReadMapped: a serial scan locates the *Node and *Element sections, which are
+	 * then split into line aligned chunks (never between an element and its continuation lines) that are counted and then
+	 * parsed concurrently into the presized node and element arrays.
+	 * @param path: Path to the file
+	 * @param model: Empty model which will be updated by reference
+	 * @param pool: thread pool parsing the chunks
+	 * @exception std::ifstream::failure if the file cannot be mapped, std::invalid_argument for malformed node/element lines
+	 * or duplicate IDs, std::out_of_range for elements referring to unknown nodes
+	 */
+	void AbaqusInputReadParallel(const std::filesystem::path& path, fedes::Model& model, BS::thread_pool& pool) {
+		const fedes::MappedFile file(path);
+		const std::string_view text = file.view();
+
+		std::vector<Section> node_sections, element_sections;
+		AbaqusSections(text, node_sections, element_sections);
+
+		ParallelReadMesh(text, node_sections, element_sections, true, model, pool,
+			[](std::string_view chunk) { return CountAbaqusRecords(chunk, false); },
+			[](std::string_view chunk, auto&& on_node) { ParseAbaqusNodes(chunk, on_node); },
+			[](std::string_view chunk) { return CountAbaqusRecords(chunk, true); },
+			[](std::string_view chunk, auto&& on_element) { ParseAbaqusElements(chunk, on_element); });
+	}
+
+	/*
+	 * @brief Parallel counterpart of AbaqusOutputRead: a serial scan locates the nodal tables (S11 S22, U1 U2, E11 E22, PE11
+	 * PE22 headers), the fields present are sized to the nodes, then the chunks of every table are parsed concurrently.
+	 * Rows address the entry of their node, so a table's rows are independent as long as each node is listed once per table;
+	 * tables are parsed one after the other, since the same node's entries are appended by every table listing it.
+	 * @param path: Path to the file
+	 * @param model: Model which will be updated by reference, assumes nodes (and node_ids) set prior
+	 * @param pool: thread pool parsing the chunks
+	 * @exception std::ifstream::failure if the file cannot be mapped, std::invalid_argument for malformed rows,
+	 * std::out_of_range for rows of unknown nodes
+	 */
+	void AbaqusOutputReadParallel(const std::filesystem::path& path, fedes::Model& model, BS::thread_pool& pool) {
+		const fedes::MappedFile file(path);
+		const std::string_view text = file.view();
+
+		std::vector<TableSection> tables;
+		AbaqusTables(text, tables);
+
+		const size_t length = model.nodes.size();
+		auto present = [&](AbaqusTable table) {
+			return std::any_of(tables.begin(), tables.end(), [&](const TableSection& t) { return t.table == table; });
+		};
+		if (present(AbaqusTable::Stress)) {
+			model.stress.resize(length);
+		}
+		if (present(AbaqusTable::Displacement)) {
+			model.displacement.resize(length);
+		}
+		if (present(AbaqusTable::TotalStrain)) {
+			model.total_strain.resize(length);
+		}
+		if (present(AbaqusTable::PlasticStrain)) {
+			model.accumulated_strain.resize(length);
+			model.plastic_strain.resize(length);
+		}
+
+		// The fields are sized above, so the builder only looks up the node and appends to its (distinct) existing entry
+		fedes::ModelBuilder builder(model);
+		auto on_field = [&](std::string_view name, size_t id, std::span<const double> values) { builder.OnField(name, id, values); };
+		const size_t chunks_per_table = 4 * std::max<size_t>(1, pool.get_thread_count());
+		for (const TableSection& table : tables) {
+			std::vector<Section> chunks;
+			LineChunks(text, table.section, chunks_per_table, false, chunks);
+			fedes::ParallelFor(pool, 0, chunks.size(),
+				[&](const uint32_t& a, const uint32_t& b)
+				{
+					for (uint32_t c = a; c < b; c++) {
+						ParseAbaqusTable(text.substr(chunks[c].begin, chunks[c].end - chunks[c].begin), table.table, on_field);
+					}
+				}, 1).get();
+		}
+	}
+
+	/*
+	 * @brief Parallel counterpart of AnsysInputReadLis: a serial scan locates the node (NODE X Y Z) and element (ELEM MAT
+	 * TYP) listings, whose line aligned chunks are counted and then parsed concurrently into the presized arrays. Repeated
+	 * page headers (NODE/ELEM, LIST, SORT lines) and blank lines are skipped.
+	 * @param path: Path to the file
+	 * @param model: Empty model which will be updated by reference
+	 * @param pool: thread pool parsing the chunks
+	 * @exception std::ifstream::failure if the file cannot be mapped, std::invalid_argument for malformed node/element lines
+	 * or duplicate IDs, std::out_of_range for elements referring to unknown nodes
+	 */
+	void AnsysInputReadLisParallel(const std::filesystem::path& path, fedes::Model& model, BS::thread_pool& pool) {
+		const fedes::MappedFile file(path);
+		const std::string_view text = file.view();
+
+		std::vector<Section> node_sections, element_sections;
+		AnsysSections(text, node_sections, element_sections);
+
+		ParallelReadMesh(text, node_sections, element_sections, false, model, pool,
+			[](std::string_view chunk) { return CountAnsysLines(chunk, "NODE"); },
+			[](std::string_view chunk, auto&& on_node) { ParseAnsysNodes(chunk, on_node); },
+			[](std::string_view chunk) { return CountAnsysLines(chunk, "ELEM"); },
+			[](std::string_view chunk, auto&& on_element) { ParseAnsysElements(chunk, on_element); });
+	}
+
+	/*
+	 * @brief Streams the nodes and elements of an Abaqus .inp file to the handler, nodes first then elements, without
+	 * materializing them, see AbaqusInputReadMapped for the accepted format
+	 * @param path: Path to the file
+	 * @param handler: receives OnNode and OnElement events, with the IDs of the file
+	 * @exception std::ifstream::failure if the file cannot be mapped, std::invalid_argument for malformed node/element lines
+	 */
+	void AbaqusInputStream(const std::filesystem::path& path, fedes::ModelHandler& handler) {
+		const fedes::MappedFile file(path);
+		const std::string_view text = file.view();
+
+		std::vector<Section> node_sections, element_sections;
+		AbaqusSections(text, node_sections, element_sections);
+		for (const Section& section : node_sections) {
+			ParseAbaqusNodes(text.substr(section.begin, section.end - section.begin),
+				[&](size_t id, const fedes::Vector3<double>& node) { handler.OnNode(id, node); });
+		}
+		for (const Section& section : element_sections) {
+			ParseAbaqusElements(text.substr(section.begin, section.end - section.begin),
+				[&](size_t id, std::span<const size_t> nodes) { handler.OnElement(id, fedes::ElementTypeOf(nodes.size()), nodes); });
+		}
+	}
+
+	/*
+	 * @brief Streams the rows of the nodal tables of an Abaqus .dat file to the handler, one OnField event per row (plus an
+	 * "accumulated_strain" event for plastic strain rows), with the values ordered as AbaqusOutputRead stores them
+	 * @param path: Path to the file
+	 * @param handler: receives OnField events named after the fields of fedes::Model, with the node IDs of the file
+	 * @exception std::ifstream::failure if the file cannot be mapped, std::invalid_argument for malformed rows
+	 */
+	void AbaqusOutputStream(const std::filesystem::path& path, fedes::ModelHandler& handler) {
+		const fedes::MappedFile file(path);
+		const std::string_view text = file.view();
+
+		std::vector<TableSection> tables;
+		AbaqusTables(text, tables);
+		for (const TableSection& table : tables) {
+			ParseAbaqusTable(text.substr(table.section.begin, table.section.end - table.section.begin), table.table,
+				[&](std::string_view name, size_t id, std::span<const double> values) { handler.OnField(name, id, values); });
+		}
+	}
+
+	/*
+	 * @brief Streams the nodes and elements of an Ansys .lis file to the handler, see AnsysInputReadLisParallel
+	 * @param path: Path to the file
+	 * @param handler: receives OnNode and OnElement events, with the IDs of the file
+	 * @exception std::ifstream::failure if the file cannot be mapped, std::invalid_argument for malformed node/element lines
+	 */
+	void AnsysInputStreamLis(const std::filesystem::path& path, fedes::ModelHandler& handler) {
+		const fedes::MappedFile file(path);
+		const std::string_view text = file.view();
+
+		std::vector<Section> node_sections, element_sections;
+		AnsysSections(text, node_sections, element_sections);
+		for (const Section& section : node_sections) {
+			ParseAnsysNodes(text.substr(section.begin, section.end - section.begin),
+				[&](size_t id, const fedes::Vector3<double>& node) { handler.OnNode(id, node); });
+		}
+		for (const Section& section : element_sections) {
+			ParseAnsysElements(text.substr(section.begin, section.end - section.begin),
+				[&](size_t id, std::span<const size_t> nodes) { handler.OnElement(id, fedes::ElementTypeOf(nodes.size()), nodes); });
+		}
+	}
+}
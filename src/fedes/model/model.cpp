@@ -3,9 +3,16 @@
 #include <string>
 #include <filesystem>
 #include <fstream>
+#include <optional>
+#include <utility>
+
+#include <BS_thread_pool.hpp>
 
 #include "fedes/model/writers.h"
 #include "fedes/maths/element_type.h"
+#include "fedes/maths/z_ordering.h"
+#include "fedes/maths/gauss.h"
+#include "fedes/common/scheduling.h"
 
 namespace fedes {
 	
@@ -14,17 +21,98 @@ namespace fedes {
 	 * @param file_name: the file name to be used without the file extension
 	 * @param by_integration: whether or not FE like stress is by integration point or by node
 	 * @param path: the directory to write to. @Default: ""../../../exports"
+	 * @param format: ascii (CreateXML), binary (CreateAppendedXML) or compressed (CreateCompressedXML) arrays
+	 * @param pool: formats ascii arrays, or compresses blocks, in parallel
 	 * @exception Propagates std::ofstream::failure
 	 */
-	void Model::Export(const std::string& file_name, bool by_integration, bool has_fea_data, const std::filesystem::path& path) {
+	void Model::Export(const std::string& file_name, bool by_integration, bool has_fea_data, const std::filesystem::path& path,
+		VtuFormat format, std::optional<BS::thread_pool*> pool) {
 		try {
 			std::string file_name_with_ext = file_name + ".vtu";
-			fedes::CreateXML(path / file_name_with_ext, *this, by_integration, has_fea_data);
+			if (format == VtuFormat::Appended) {
+				fedes::CreateAppendedXML(path / file_name_with_ext, *this, by_integration, has_fea_data);
+				return;
+			}
+			if (format == VtuFormat::Compressed) {
+				fedes::CreateCompressedXML(path / file_name_with_ext, *this, by_integration, has_fea_data, pool);
+				return;
+			}
+			fedes::CreateXML(path / file_name_with_ext, *this, by_integration, has_fea_data, pool);
 		} catch (const std::ofstream::failure& e) {
 			throw;
 		}
 	}
 
+	/*
+	 * @brief Element type of the Gauss rule for an element, empty for node counts without one (integrated at the centroid)
+	 */
+	static std::optional<ElementType> GaussElementType(const std::vector<size_t>& element) {
+		switch (element.size()) {
+		case 4:
+			return ElementType::Tetrahedron;
+		case 6:
+			return ElementType::Wedge;
+		case 8:
+			return ElementType::Hexahedron;
+		default:
+			return {};
+		}
+	}
+
+	static fedes::Vector3<double> Centroid(const std::vector<fedes::Vector3<double>>& nodes, const std::vector<size_t>& element) {
+		double x = 0;
+		double y = 0;
+		double z = 0;
+		size_t element_count = element.size();
+		for (size_t j = 0; j < element_count; j++) {
+			x += nodes[element[j]].x;
+			y += nodes[element[j]].y;
+			z += nodes[element[j]].z;
+		}
+		return { x / element_count, y / element_count, z / element_count };
+	}
+
+	/*
+	 * @brief Writes the Gauss points of an element to consecutive integration points, starting from the given one
+	 */
+	static void WriteGaussPoints(const std::vector<fedes::Vector3<double>>& nodes, const std::vector<size_t>& element,
+		                         fedes::Vector3<double>* integration) {
+		std::optional<ElementType> element_type = GaussElementType(element);
+		if (!element_type.has_value()) {
+			*integration = Centroid(nodes, element);
+			return;
+		}
+		for (const std::array<double, 3>& local : fedes::GaussPoints(*element_type)) {
+			*integration++ = fedes::LocalToGlobal(nodes, element, *element_type, local);
+		}
+	}
+
+	/*
+	 * @brief Prefix sum of the Gauss point counts of the elements
+	 */
+	static std::vector<size_t> GaussOffsets(const std::vector<std::vector<size_t>>& elements) {
+		std::vector<size_t> offsets(elements.size() + 1, 0);
+		for (size_t e = 0; e < elements.size(); ++e) {
+			std::optional<ElementType> element_type = GaussElementType(elements[e]);
+			offsets[e + 1] = offsets[e] + (element_type.has_value() ? fedes::GaussPoints(*element_type).size() : 1);
+		}
+		return offsets;
+	}
+
+	/*
+	 * @brief Presizes the field and allocates its entries on the thread pool
+	 */
+	static void ParallelResize(std::vector<std::vector<double>>& field, size_t count, size_t components, BS::thread_pool& pool) {
+		field.resize(count);
+		fedes::ParallelFor(pool, 0, count,
+			[&](size_t a, size_t b)
+			{
+				for (size_t i = a; i < b; ++i) {
+					field[i].assign(components, 0.0);
+				}
+			}).wait();
+	}
+
 	/* 
 	 * @brief  For the target mesh: resizes and pre-allocates all target indexes for FE data,
 	 * allowing arbitrary use of operator[] + assigns integration data (see: AssignIntegration).
@@ -33,24 +121,57 @@ namespace fedes {
 	 * Integration points are only calculated if the source model has data that needs mapping via integration points.
 	 * 
 	 * @param source: the source model so that target FE indexes can be set correctly corresponding to the source model
+	 * @param gauss_points: map to every Gauss point of the elements (see AssignGaussIntegration) instead of their centroids
 	 */
-	void Model::SetTargetIndexes(const fedes::Model& source) {
+	void Model::SetTargetIndexes(const fedes::Model& source, bool gauss_points) {
 		if (!source.displacement.empty()) {
 			displacement.resize(this->nodes.size(), std::vector<double>(3));
 		}
 		if (!source.stress.empty() || !source.total_strain.empty() || !source.plastic_strain.empty() || !source.accumulated_strain.empty()) {
-			AssignIntegration();
+			if (gauss_points) {
+				AssignGaussIntegration();
+			} else {
+				AssignIntegration();
+			}
+			if (!source.stress.empty()) {
+				stress.resize(this->integration.size(), std::vector<double>(6));
+			}
+			if (!source.total_strain.empty()) {
+				total_strain.resize(this->integration.size(), std::vector<double>(6));
+			}
+			if (!source.plastic_strain.empty()) {
+				plastic_strain.resize(this->integration.size(),std::vector<double>(6));
+			}
+			if (!source.accumulated_strain.empty()) {
+				accumulated_strain.resize(this->integration.size());
+			}
+		}
+	}
+
+	/*
+	 * @brief Parallel SetTargetIndexes: the integration points and the FE data entries are computed/allocated on the thread pool
+	 */
+	void Model::SetTargetIndexes(const fedes::Model& source, BS::thread_pool& pool, bool gauss_points) {
+		if (!source.displacement.empty()) {
+			ParallelResize(displacement, this->nodes.size(), 3, pool);
+		}
+		if (!source.stress.empty() || !source.total_strain.empty() || !source.plastic_strain.empty() || !source.accumulated_strain.empty()) {
+			if (gauss_points) {
+				ParallelAssignGaussIntegration(pool);
+			} else {
+				ParallelAssignIntegration(pool);
+			}
 			if (!source.stress.empty()) {
-				stress.resize(this->elements.size(), std::vector<double>(6));
+				ParallelResize(stress, this->integration.size(), 6, pool);
 			}
 			if (!source.total_strain.empty()) {
-				total_strain.resize(this->elements.size(), std::vector<double>(6));
+				ParallelResize(total_strain, this->integration.size(), 6, pool);
 			}
 			if (!source.plastic_strain.empty()) {
-				plastic_strain.resize(this->elements.size(),std::vector<double>(6));
+				ParallelResize(plastic_strain, this->integration.size(), 6, pool);
 			}
 			if (!source.accumulated_strain.empty()) {
-				accumulated_strain.resize(this->elements.size());
+				accumulated_strain.resize(this->integration.size());
 			}
 		}
 	}
@@ -69,17 +190,191 @@ namespace fedes {
 		}
 		integration.reserve(elements.size());
 		for (size_t i = 0; i < elements.size(); i++) {
-			double x = 0;
-			double y = 0;
-			double z = 0;
-			size_t element_count = elements[i].size();
-			for (size_t j = 0; j < element_count; j++) {
-				x += nodes[elements[i][j]].x;
-				y += nodes[elements[i][j]].y;
-				z += nodes[elements[i][j]].z;
+			integration.push_back(Centroid(nodes, elements[i]));
+		}
+	}
+
+	/*
+	 * @brief AssignIntegration on the thread pool, writing into the presized integration points
+	 */
+	void Model::ParallelAssignIntegration(BS::thread_pool& pool) {
+		if (!integration.empty()) {
+			return;
+		}
+		integration.resize(elements.size());
+		fedes::ParallelFor(pool, 0, elements.size(),
+			[&](size_t a, size_t b)
+			{
+				for (size_t i = a; i < b; ++i) {
+					integration[i] = Centroid(nodes, elements[i]);
+				}
+			}).wait();
+	}
+
+	/*
+	 * @brief Provides every Gauss point of every element as integration data, in a flat array (in element order) indexed by
+	 * integration_offsets: 4 points for tetrahedra, 6 for wedges and 8 for hexahedra (see GaussRule), elements of any other
+	 * node count keep their centroid. Mapped stresses and strains are then given per Gauss point.
+	 */
+	void Model::AssignGaussIntegration() {
+		if (!integration.empty()) {
+			return;
+		}
+		integration_offsets = GaussOffsets(elements);
+		integration.resize(integration_offsets.back());
+		for (size_t e = 0; e < elements.size(); ++e) {
+			WriteGaussPoints(nodes, elements[e], &integration[integration_offsets[e]]);
+		}
+	}
+
+	/*
+	 * @brief AssignGaussIntegration on the thread pool: the offsets are a serial prefix sum, the points are then written to
+	 * their presized slots in parallel
+	 */
+	void Model::ParallelAssignGaussIntegration(BS::thread_pool& pool) {
+		if (!integration.empty()) {
+			return;
+		}
+		integration_offsets = GaussOffsets(elements);
+		integration.resize(integration_offsets.back());
+		fedes::ParallelFor(pool, 0, elements.size(),
+			[&](size_t a, size_t b)
+			{
+				for (size_t e = a; e < b; ++e) {
+					WriteGaussPoints(nodes, elements[e], &integration[integration_offsets[e]]);
+				}
+			}).wait();
+	}
+
+	/*
+	 * @brief Moves every entry of data to its new position, i.e. data[i] becomes data[order[i]]
+	 */
+	template <typename T>
+	static void Permute(std::vector<T>& data, const std::vector<size_t>& order) {
+		std::vector<T> permuted;
+		permuted.reserve(data.size());
+		for (size_t i = 0; i < order.size(); ++i) {
+			permuted.emplace_back(std::move(data[order[i]]));
+		}
+		data = std::move(permuted);
+	}
+
+	/*
+	 * @brief Inverse of a permutation: the new index of every original index
+	 */
+	static std::vector<size_t> Invert(const std::vector<size_t>& order) {
+		std::vector<size_t> inverse(order.size());
+		for (size_t i = 0; i < order.size(); ++i) {
+			inverse[order[i]] = i;
+		}
+		return inverse;
+	}
+
+	/*
+	 * @brief Permutes nodes, elements and FE data in place, renumbering the element node indexes accordingly
+	 * @param nodes_by: new position -> current node index
+	 * @param elements_by: new position -> current element index
+	 */
+	static void Renumber(fedes::Model& model, const std::vector<size_t>& nodes_by, const std::vector<size_t>& elements_by) {
+		const size_t node_count = model.nodes.size();
+		const size_t element_count = model.elements.size();
+		const std::vector<size_t> new_node_index = Invert(nodes_by);
+
+		Permute(model.nodes, nodes_by);
+		for (std::vector<size_t>& element : model.elements) {
+			for (size_t& node : element) {
+				node = new_node_index[node];
+			}
+		}
+		Permute(model.elements, elements_by);
+		if (!model.node_ids.empty()) {
+			Permute(model.node_ids, nodes_by);
+		}
+		if (!model.element_ids.empty()) {
+			Permute(model.element_ids, elements_by);
+		}
+
+		// The integration points move along with their element
+		std::vector<size_t> points_by = elements_by;
+		if (!model.integration_offsets.empty()) {
+			const std::vector<size_t> offsets = model.integration_offsets;
+			points_by.clear();
+			points_by.reserve(model.integration.size());
+			for (size_t e = 0; e < elements_by.size(); ++e) {
+				for (size_t p = offsets[elements_by[e]]; p < offsets[elements_by[e] + 1]; ++p) {
+					points_by.push_back(p);
+				}
+				model.integration_offsets[e + 1] = points_by.size();
+			}
+		}
+		const size_t point_count = model.integration.empty() ? element_count : model.integration.size();
+		if (!model.integration.empty()) {
+			Permute(model.integration, points_by);
+		}
+
+		// Source stresses and strains are given per node, mapped target ones per integration point. Should the counts
+		// coincide, the field is taken to be per node, as for a source model.
+		auto permute_field = [&](auto& field) {
+			if (field.size() == node_count) {
+				Permute(field, nodes_by);
+			} else if (field.size() == point_count) {
+				Permute(field, points_by);
+			}
+		};
+		permute_field(model.displacement);
+		permute_field(model.stress);
+		permute_field(model.total_strain);
+		permute_field(model.plastic_strain);
+		permute_field(model.accumulated_strain);
+	}
+
+	/*
+	 * @brief Renumbers the model for memory locality: nodes along the Morton (Z-Order) curve of their coordinates and elements
+	 * along the curve of their centroids, so neighbouring nodes/elements are also neighbours in memory. This benefits the
+	 * octree leaf scans, the node to element walks and the FE data gathers of the interpolations.
+	 *
+	 * All FE data is permuted consistently, the original indexes are kept in node_order/element_order so that
+	 * RestoreOrder() can return to the file order (e.g. prior to exporting).
+	 */
+	void Model::Reorder() {
+		if (nodes.empty()) {
+			return;
+		}
+		std::vector<size_t> nodes_by = fedes::MortonOrder(nodes);
+
+		std::vector<fedes::Vector3<double>> centroids;
+		centroids.reserve(elements.size());
+		for (const std::vector<size_t>& element : elements) {
+			fedes::Vector3<double> centroid;
+			for (size_t node : element) {
+				centroid += nodes[node];
 			}
-			integration.emplace_back(x / element_count, y / element_count, z / element_count);
+			centroids.push_back(element.empty() ? centroid : centroid / static_cast<double>(element.size()));
+		}
+		std::vector<size_t> elements_by = fedes::MortonOrder(centroids);
+
+		Renumber(*this, nodes_by, elements_by);
+
+		// Compose with any earlier reordering, so that the original indexes are kept
+		if (!node_order.empty()) {
+			Permute(node_order, nodes_by);
+			Permute(element_order, elements_by);
+		} else {
+			node_order = std::move(nodes_by);
+			element_order = std::move(elements_by);
+		}
+	}
+
+	/*
+	 * @brief Undoes Reorder(), returning nodes, elements and FE data (including any mapped since) to the file order
+	 */
+	void Model::RestoreOrder() {
+		if (node_order.empty()) {
+			return;
 		}
+		Renumber(*this, Invert(node_order), Invert(element_order));
+		node_order.clear();
+		element_order.clear();
 	}
 
 	/*
@@ -5,11 +5,23 @@
 #include <iostream>
 #include <filesystem>
 #include <string>
+#include <optional>
+
+#include <BS_thread_pool.hpp>
 
 #include "fedes/maths/vector3.h"
 
 namespace fedes {
 
+	/*
+	 * @brief Encoding of the arrays of an exported .vtu file
+	 */
+	enum class VtuFormat {
+		Ascii, // @brief: CreateXML, human readable
+		Appended, // @brief: CreateAppendedXML, raw binary
+		Compressed // @brief: CreateCompressedXML, zlib compressed binary (requires zlib)
+	};
+
 	struct Model {
 	public:
 		std::vector<fedes::Vector3<double>> nodes;
@@ -20,11 +32,28 @@ namespace fedes {
 		std::vector<std::vector<double>> plastic_strain;
 		std::vector<double> accumulated_strain;
 		std::vector<fedes::Vector3<double>> integration;
+		// Integration points of element e are [integration_offsets[e], integration_offsets[e + 1]), empty for one centroid per element
+		std::vector<size_t> integration_offsets;
+
+		// External (file) ID of every node/element, see IdMap; empty when the file numbers them 1, 2, 3, ...
+		std::vector<size_t> node_ids;
+		std::vector<size_t> element_ids;
+
+		// Original index of every node/element after Reorder(), empty while in file order
+		std::vector<size_t> node_order;
+		std::vector<size_t> element_order;
 	public:
-		void SetTargetIndexes(const fedes::Model& source);
+		void SetTargetIndexes(const fedes::Model& source, bool gauss_points = false);
+		void SetTargetIndexes(const fedes::Model& source, BS::thread_pool& pool, bool gauss_points = false);
 		void AssignIntegration();
+		void ParallelAssignIntegration(BS::thread_pool& pool);
+		void AssignGaussIntegration();
+		void ParallelAssignGaussIntegration(BS::thread_pool& pool);
+		void Reorder();
+		void RestoreOrder();
 		void Export(const std::string& file_name, bool by_integration,
-			bool has_fea_data, const std::filesystem::path& path = "../../../exports");
+			bool has_fea_data, const std::filesystem::path& path = "../../../exports", VtuFormat format = VtuFormat::Ascii,
+			std::optional<BS::thread_pool*> pool = std::nullopt);
 
 		bool ByNode() const;
 		bool ByIntegration() const;
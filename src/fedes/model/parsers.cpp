@@ -9,6 +9,7 @@
 #include <string>
 
 #include "fedes/model/model.h"
+#include "fedes/model/id_map.h"
 #include "fedes/common/files.h"
 #include "fedes/common/strings.h"
 
@@ -254,13 +255,16 @@ namespace fedes {
 	* @brief Maps Abaqus Output data file (.dat) for a model which has its input data pre-set
 	* @port - Port of code from FEDES v2
 	* @param path: Path to the file
-	* @param model: Model which will be updated by reference, assumes nodes set prior (uses nodes.size)
-	* @exception Propagates std::ifstream::failure
+	* @param model: Model which will be updated by reference, assumes nodes set prior (uses nodes.size and node_ids)
+	* @exception Propagates std::ifstream::failure, std::out_of_range for rows of unknown nodes
 	*/
 	void AbaqusOutputRead(const std::filesystem::path& path, fedes::Model& model) {
 		int br = -1, br_1 = -1, br_2 = -1, br_3 = -1, action = 5, AnzTokens = 0;
 		std::vector<std::string> operating_str_arr, A, A1;
 		size_t length = model.nodes.size();
+		// Rows are looked up by node ID, however sparse the numbering of the input file (see IdMap)
+		const fedes::IdMap node_map(model.node_ids, length);
+		auto node = [&](const std::string& id) { return node_map.At(std::stoul(id)); };
 		std::string line;
 		std::ifstream stream;
 		try {
@@ -328,24 +332,24 @@ namespace fedes {
 					}
 				}
 				if (A1.size() == 7) {
-					model.stress[stoi(A1[0]) - 1].emplace_back(stod(A1[1]));
-					model.stress[stoi(A1[0]) - 1].emplace_back(stod(A1[2]));
-					model.stress[stoi(A1[0]) - 1].emplace_back(stod(A1[3]));
-					model.stress[stoi(A1[0]) - 1].emplace_back(stod(A1[4]));
-					model.stress[stoi(A1[0]) - 1].emplace_back(stod(A1[6]));
-					model.stress[stoi(A1[0]) - 1].emplace_back(stod(A1[5]));
+					model.stress[node(A1[0])].emplace_back(stod(A1[1]));
+					model.stress[node(A1[0])].emplace_back(stod(A1[2]));
+					model.stress[node(A1[0])].emplace_back(stod(A1[3]));
+					model.stress[node(A1[0])].emplace_back(stod(A1[4]));
+					model.stress[node(A1[0])].emplace_back(stod(A1[6]));
+					model.stress[node(A1[0])].emplace_back(stod(A1[5]));
 				}
 				if (A1.size() == 5) {
-					model.stress[stoi(A1[0]) - 1].emplace_back(stod(A1[1]));
-					model.stress[stoi(A1[0]) - 1].emplace_back(stod(A1[2]));
-					model.stress[stoi(A1[0]) - 1].emplace_back(stod(A1[3]));
-					model.stress[stoi(A1[0]) - 1].emplace_back(stod(A1[4]));
+					model.stress[node(A1[0])].emplace_back(stod(A1[1]));
+					model.stress[node(A1[0])].emplace_back(stod(A1[2]));
+					model.stress[node(A1[0])].emplace_back(stod(A1[3]));
+					model.stress[node(A1[0])].emplace_back(stod(A1[4]));
 				}
 				if (A1.size() == 4) {
-					model.stress[stoi(A1[0]) - 1].emplace_back(stod(A1[1]));
-					model.stress[stoi(A1[0]) - 1].emplace_back(stod(A1[2]));
-					model.stress[stoi(A1[0]) - 1].emplace_back();
-					model.stress[stoi(A1[0]) - 1].emplace_back(stod(A1[3]));
+					model.stress[node(A1[0])].emplace_back(stod(A1[1]));
+					model.stress[node(A1[0])].emplace_back(stod(A1[2]));
+					model.stress[node(A1[0])].emplace_back();
+					model.stress[node(A1[0])].emplace_back(stod(A1[3]));
 				}
 				A.clear();
 				A1.clear();
@@ -358,14 +362,14 @@ namespace fedes {
 					}
 				}
 				if (A1.size() == 4) {
-					model.displacement[stoi(A1[0]) - 1].emplace_back(stod(A1[1]));
-					model.displacement[stoi(A1[0]) - 1].emplace_back(stod(A1[2]));
-					model.displacement[stoi(A1[0]) - 1].emplace_back(stod(A1[3]));
+					model.displacement[node(A1[0])].emplace_back(stod(A1[1]));
+					model.displacement[node(A1[0])].emplace_back(stod(A1[2]));
+					model.displacement[node(A1[0])].emplace_back(stod(A1[3]));
 				}
 
 				if (A1.size() == 3) {
-					model.displacement[stoi(A1[0]) - 1].emplace_back(stod(A1[1]));
-					model.displacement[stoi(A1[0]) - 1].emplace_back(stod(A1[2]));
+					model.displacement[node(A1[0])].emplace_back(stod(A1[1]));
+					model.displacement[node(A1[0])].emplace_back(stod(A1[2]));
 				}
 				A.clear();
 				A1.clear();
@@ -378,24 +382,24 @@ namespace fedes {
 					}
 				}
 				if (A1.size() == 7) {
-					model.total_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[1]));
-					model.total_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[2]));
-					model.total_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[3]));
-					model.total_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[4]));
-					model.total_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[6]));
-					model.total_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[5]));
+					model.total_strain[node(A1[0])].emplace_back(stod(A1[1]));
+					model.total_strain[node(A1[0])].emplace_back(stod(A1[2]));
+					model.total_strain[node(A1[0])].emplace_back(stod(A1[3]));
+					model.total_strain[node(A1[0])].emplace_back(stod(A1[4]));
+					model.total_strain[node(A1[0])].emplace_back(stod(A1[6]));
+					model.total_strain[node(A1[0])].emplace_back(stod(A1[5]));
 				}
 				if (A1.size() == 5) {
-					model.total_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[1]));
-					model.total_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[2]));
-					model.total_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[3]));
-					model.total_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[4]));
+					model.total_strain[node(A1[0])].emplace_back(stod(A1[1]));
+					model.total_strain[node(A1[0])].emplace_back(stod(A1[2]));
+					model.total_strain[node(A1[0])].emplace_back(stod(A1[3]));
+					model.total_strain[node(A1[0])].emplace_back(stod(A1[4]));
 				}
 				if (A1.size() == 4) {
-					model.total_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[1]));
-					model.total_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[2]));
-					model.total_strain[stoi(A1[0]) - 1].emplace_back();
-					model.total_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[3]));
+					model.total_strain[node(A1[0])].emplace_back(stod(A1[1]));
+					model.total_strain[node(A1[0])].emplace_back(stod(A1[2]));
+					model.total_strain[node(A1[0])].emplace_back();
+					model.total_strain[node(A1[0])].emplace_back(stod(A1[3]));
 				}
 				A.clear();
 				A1.clear();
@@ -409,32 +413,32 @@ namespace fedes {
 					}
 				}
 				if (A1.size() == 9) {
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[1]));
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[2]));
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[3]));
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[4]));
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[6]));
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[5]));
+					model.plastic_strain[node(A1[0])].emplace_back(stod(A1[1]));
+					model.plastic_strain[node(A1[0])].emplace_back(stod(A1[2]));
+					model.plastic_strain[node(A1[0])].emplace_back(stod(A1[3]));
+					model.plastic_strain[node(A1[0])].emplace_back(stod(A1[4]));
+					model.plastic_strain[node(A1[0])].emplace_back(stod(A1[6]));
+					model.plastic_strain[node(A1[0])].emplace_back(stod(A1[5]));
 
-					model.accumulated_strain[stoi(A1[0]) - 1] = stod(A1[7]);
+					model.accumulated_strain[node(A1[0])] = stod(A1[7]);
 				}
 
 				if (A1.size() == 7) {
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[1]));
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[2]));
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[3]));
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[4]));
+					model.plastic_strain[node(A1[0])].emplace_back(stod(A1[1]));
+					model.plastic_strain[node(A1[0])].emplace_back(stod(A1[2]));
+					model.plastic_strain[node(A1[0])].emplace_back(stod(A1[3]));
+					model.plastic_strain[node(A1[0])].emplace_back(stod(A1[4]));
 
-					model.accumulated_strain[stoi(A1[0]) - 1] = stod(A1[5]);
+					model.accumulated_strain[node(A1[0])] = stod(A1[5]);
 				}
 
 				if (A1.size() == 6) {
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[1]));
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[2]));
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back();
-					model.plastic_strain[stoi(A1[0]) - 1].emplace_back(stod(A1[3]));
+					model.plastic_strain[node(A1[0])].emplace_back(stod(A1[1]));
+					model.plastic_strain[node(A1[0])].emplace_back(stod(A1[2]));
+					model.plastic_strain[node(A1[0])].emplace_back();
+					model.plastic_strain[node(A1[0])].emplace_back(stod(A1[3]));
 
-					model.accumulated_strain[stoi(A1[0]) - 1] = stod(A1[4]);
+					model.accumulated_strain[node(A1[0])] = stod(A1[4]);
 				}
 				A.clear();
 				A1.clear();
@@ -2,16 +2,24 @@
 
 #include <filesystem>
 
+#include <BS_thread_pool.hpp>
+
 #include "fedes/model/model.h"
 
 namespace fedes {
 
 	void AbaqusInputRead(const std::filesystem::path& path, fedes::Model& model);
+	void AbaqusInputReadMapped(const std::filesystem::path& path, fedes::Model& model);
+	void AbaqusInputReadParallel(const std::filesystem::path& path, fedes::Model& model, BS::thread_pool& pool);
 	void AbaqusOutputRead(const std::filesystem::path& path, fedes::Model& model);
+	void AbaqusOutputReadParallel(const std::filesystem::path& path, fedes::Model& model, BS::thread_pool& pool);
 	
 	void AnsysInputReadLis(const std::filesystem::path& path, fedes::Model& model);
+	void AnsysInputReadLisParallel(const std::filesystem::path& path, fedes::Model& model, BS::thread_pool& pool);
 	void AnsysOutputRead(const std::filesystem::path& path, fedes::Model& model);
 	
 	void MorpheoInputRead(const std::filesystem::path& path, fedes::Model& model);
 	void MorpheoInputOutputRead(const std::filesystem::path& path, fedes::Model& model);
+
+	void VtuRead(const std::filesystem::path& path, fedes::Model& model);
 }
\ No newline at end of file
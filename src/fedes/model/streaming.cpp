@@ -0,0 +1,90 @@
+#include "fedes/model/streaming.h"
+
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "fedes/model/model.h"
+#include "fedes/model/id_map.h"
+
+namespace fedes {
+
+	namespace {
+		/*
+		 * @brief Keeps the model's IDs in step with the map: none while dense, all of them once an ID breaks the sequence
+		 */
+		void KeepIds(const fedes::IdMap& map, std::vector<size_t>& ids) {
+			if (map.dense()) {
+				return;
+			}
+			while (ids.size() < map.size()) {
+				ids.push_back(map.Id(ids.size()));
+			}
+		}
+	}
+
+	/*
+	 * @brief Builds into the given model, which may already hold nodes and elements (e.g. a mesh to stream results onto)
+	 */
+	ModelBuilder::ModelBuilder(fedes::Model& model)
+		: model_(model), node_map_(model.node_ids, model.nodes.size()), element_map_(model.element_ids, model.elements.size()) {}
+
+	/*
+	 * @exception std::invalid_argument for duplicate IDs
+	 */
+	void ModelBuilder::OnNode(size_t id, const fedes::Vector3<double>& xyz) {
+		node_map_.Insert(id);
+		model_.nodes.push_back(xyz);
+		KeepIds(node_map_, model_.node_ids);
+	}
+
+	/*
+	 * @exception std::invalid_argument for duplicate IDs, std::out_of_range for unknown nodes
+	 */
+	void ModelBuilder::OnElement(size_t id, std::optional<fedes::ElementType> type, std::span<const size_t> nodes) {
+		std::vector<size_t> element(nodes.size());
+		std::transform(nodes.begin(), nodes.end(), element.begin(), [&](size_t node) { return node_map_.At(node); });
+		element_map_.Insert(id);
+		model_.elements.push_back(std::move(element));
+		KeepIds(element_map_, model_.element_ids);
+	}
+
+	/*
+	 * @brief Fields are sized to the nodes on their first value, like AbaqusOutputRead. Values of fields which fedes::Model
+	 * does not hold are ignored.
+	 * @exception std::out_of_range for unknown nodes
+	 */
+	void ModelBuilder::OnField(std::string_view name, size_t id, std::span<const double> values) {
+		if (name == "accumulated_strain") {
+			const size_t node = node_map_.At(id);
+			if (model_.accumulated_strain.size() < model_.nodes.size()) {
+				model_.accumulated_strain.resize(model_.nodes.size());
+			}
+			if (!values.empty()) {
+				model_.accumulated_strain[node] = values.front();
+			}
+			return;
+		}
+
+		std::vector<std::vector<double>>* field = nullptr;
+		if (name == "displacement") {
+			field = &model_.displacement;
+		} else if (name == "stress") {
+			field = &model_.stress;
+		} else if (name == "total_strain") {
+			field = &model_.total_strain;
+		} else if (name == "plastic_strain") {
+			field = &model_.plastic_strain;
+		} else {
+			return;
+		}
+		const size_t node = node_map_.At(id);
+		if (field->size() < model_.nodes.size()) {
+			field->resize(model_.nodes.size());
+		}
+		std::vector<double>& entry = (*field)[node];
+		entry.insert(entry.end(), values.begin(), values.end());
+	}
+}
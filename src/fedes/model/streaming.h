@@ -0,0 +1,63 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "fedes/maths/vector3.h"
+#include "fedes/maths/element_type.h"
+#include "fedes/model/model.h"
+#include "fedes/model/id_map.h"
+
+namespace fedes {
+
+	/*
+	 * @brief Receives the contents of a mesh or results file while it is parsed, instead of a fedes::Model holding all of it,
+	 * so that a consumer can build an index, renumber, or write an output file as the records arrive. IDs are those of the
+	 * file (Abaqus and Ansys number from 1), spans are only valid during the call. Events not overridden are ignored.
+	 */
+	class ModelHandler {
+	public:
+		virtual ~ModelHandler() = default;
+
+		/*
+		 * @brief A node and its coordinates
+		 */
+		virtual void OnNode(size_t id, const fedes::Vector3<double>& xyz) {}
+
+		/*
+		 * @brief An element and its node IDs, type is empty for elements other than linear tetrahedra, wedges and hexahedra
+		 */
+		virtual void OnElement(size_t id, std::optional<fedes::ElementType> type, std::span<const size_t> nodes) {}
+
+		/*
+		 * @brief Values of the field `name` (named after the members of fedes::Model, e.g. "stress") at node `id`
+		 */
+		virtual void OnField(std::string_view name, size_t id, std::span<const double> values) {}
+	};
+
+	/*
+	 * @brief Handler materializing the events into a fedes::Model, as the parsers in parsers.h do: nodes and elements are
+	 * appended in the order they arrive, and field values are appended to the entry of their node (accumulated_strain, a
+	 * scalar, is assigned). IDs are compacted with an IdMap, so element nodes and fields are looked up by node ID however
+	 * sparse the numbering is, and the IDs are kept in node_ids/element_ids unless they are 1, 2, 3, ...
+	 */
+	class ModelBuilder : public ModelHandler {
+	public:
+		explicit ModelBuilder(fedes::Model& model);
+
+		void OnNode(size_t id, const fedes::Vector3<double>& xyz) override;
+		void OnElement(size_t id, std::optional<fedes::ElementType> type, std::span<const size_t> nodes) override;
+		void OnField(std::string_view name, size_t id, std::span<const double> values) override;
+
+	private:
+		fedes::Model& model_;
+		fedes::IdMap node_map_;
+		fedes::IdMap element_map_;
+	};
+
+	void AbaqusInputStream(const std::filesystem::path& path, fedes::ModelHandler& handler);
+	void AbaqusOutputStream(const std::filesystem::path& path, fedes::ModelHandler& handler);
+	void AnsysInputStreamLis(const std::filesystem::path& path, fedes::ModelHandler& handler);
+}
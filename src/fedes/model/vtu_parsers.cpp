@@ -0,0 +1,431 @@
+// vtu_parsers.cpp -> reader of VTK XML unstructured grid (.vtu) files in any of their encodings: ascii, inline base64
+// (format="binary") and appended raw or base64 data, each optionally zlib compressed
+
+#include "fedes/model/parsers.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "fedes/model/model.h"
+#include "fedes/common/base64.h"
+#include "fedes/common/compression.h"
+#include "fedes/common/mapped_file.h"
+#include "fedes/common/scanning.h"
+
+namespace fedes {
+
+	namespace {
+		[[noreturn]] void InvalidVtu(const std::string& what) {
+			throw std::invalid_argument("Invalid VTU file: " + what);
+		}
+
+		/*
+		 * @brief Encoding of the arrays, from the VTKFile and AppendedData elements
+		 */
+		struct VtuLayout {
+			bool header_64 = false; // @brief: header_type="UInt64", otherwise UInt32
+			bool compressed = false; // @brief: compressor="vtkZLibDataCompressor"
+			bool swap = false; // @brief: byte_order="BigEndian"
+			bool appended_base64 = false;
+			std::string_view appended; // @brief: appended data, after its leading '_'
+		};
+
+		struct DataArray {
+			std::string_view tag; // @brief: the opening tag, for its attributes
+			std::string_view content; // @brief: inline values, empty for appended arrays
+			size_t offset = 0; // @brief: start in the appended data
+			size_t end = 0; // @brief: end in the appended data (start of the next array), for base64 decoding
+		};
+
+		/*
+		 * @brief Value of the attribute `name` of a tag, empty if the tag does not have it
+		 */
+		std::string_view Attribute(std::string_view tag, std::string_view name) {
+			size_t position = 0;
+			while ((position = tag.find(name, position)) != std::string_view::npos) {
+				const size_t quote = position + name.size() + 1;
+				const bool whole = position > 0 && std::isspace(static_cast<unsigned char>(tag[position - 1])) &&
+					quote < tag.size() && tag[quote - 1] == '=' && (tag[quote] == '"' || tag[quote] == '\'');
+				if (whole) {
+					const size_t end = tag.find(tag[quote], quote + 1);
+					if (end == std::string_view::npos) {
+						InvalidVtu("unterminated attribute " + std::string(name));
+					}
+					return tag.substr(quote + 1, end - quote - 1);
+				}
+				position += name.size();
+			}
+			return {};
+		}
+
+		size_t SizeAttribute(std::string_view tag, std::string_view name, size_t fallback) {
+			const std::string_view value = Attribute(tag, name);
+			if (value.empty()) {
+				return fallback;
+			}
+			size_t position = 0, number = 0;
+			if (!ParseNumber(value, position, number) || !AtEnd(value, position)) {
+				InvalidVtu(std::string(name) + "=\"" + std::string(value) + "\"");
+			}
+			return number;
+		}
+
+		bool ContainsLower(std::string_view text, std::string_view lower) {
+			auto equal = [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; };
+			return std::search(text.begin(), text.end(), lower.begin(), lower.end(), equal) != text.end();
+		}
+
+		/*
+		 * @brief Reads the value of type S at bytes, in the byte order of the file
+		 */
+		template <typename S>
+		S Load(const char* bytes, bool swap) {
+			std::array<char, sizeof(S)> raw;
+			std::memcpy(raw.data(), bytes, sizeof(S));
+			if (swap) {
+				std::reverse(raw.begin(), raw.end());
+			}
+			return std::bit_cast<S>(raw);
+		}
+
+		template <typename S, typename T>
+		void ConvertFrom(std::string_view bytes, bool swap, std::vector<T>& values) {
+			const size_t count = bytes.size() / sizeof(S);
+			const size_t first = values.size();
+			values.resize(first + count);
+			if constexpr (std::is_same_v<S, T>) {
+				if (!swap) {
+					std::memcpy(values.data() + first, bytes.data(), count * sizeof(S));
+					return;
+				}
+			}
+			for (size_t i = 0; i < count; ++i) {
+				values[first + i] = static_cast<T>(Load<S>(bytes.data() + i * sizeof(S), swap));
+			}
+		}
+
+		/*
+		 * @brief Appends the binary values of a VTK type (e.g. Float32, Int64) to values, converted to T
+		 */
+		template <typename T>
+		void Convert(std::string_view type, std::string_view bytes, bool swap, std::vector<T>& values) {
+			if (type == "Float64") {
+				ConvertFrom<double>(bytes, swap, values);
+			} else if (type == "Float32") {
+				ConvertFrom<float>(bytes, swap, values);
+			} else if (type == "Int64") {
+				ConvertFrom<int64_t>(bytes, swap, values);
+			} else if (type == "UInt64") {
+				ConvertFrom<uint64_t>(bytes, swap, values);
+			} else if (type == "Int32") {
+				ConvertFrom<int32_t>(bytes, swap, values);
+			} else if (type == "UInt32") {
+				ConvertFrom<uint32_t>(bytes, swap, values);
+			} else if (type == "Int16") {
+				ConvertFrom<int16_t>(bytes, swap, values);
+			} else if (type == "UInt16") {
+				ConvertFrom<uint16_t>(bytes, swap, values);
+			} else if (type == "Int8") {
+				ConvertFrom<int8_t>(bytes, swap, values);
+			} else if (type == "UInt8") {
+				ConvertFrom<uint8_t>(bytes, swap, values);
+			} else {
+				InvalidVtu("unsupported type " + std::string(type));
+			}
+		}
+
+		/*
+		 * @brief Word `index` of a binary header (UInt32 or UInt64 words)
+		 */
+		size_t HeaderWord(std::string_view bytes, size_t index, const VtuLayout& layout) {
+			const size_t size = layout.header_64 ? 8 : 4;
+			if ((index + 1) * size > bytes.size()) {
+				InvalidVtu("truncated binary header");
+			}
+			const char* word = bytes.data() + index * size;
+			return layout.header_64 ? static_cast<size_t>(Load<uint64_t>(word, layout.swap)) : Load<uint32_t>(word, layout.swap);
+		}
+
+		/*
+		 * @brief The values of a binary array, given its header and data: uncompressed arrays are a view of `bytes` (so
+		 * raw appended data is used in place), compressed ones are uncompressed block by block into buffer. The blocks
+		 * follow the header [blocks, block size, size of the last block (0 if full), compressed size of each block].
+		 */
+		std::string_view Payload(std::string_view bytes, const VtuLayout& layout, std::vector<char>& buffer) {
+			const size_t word = layout.header_64 ? 8 : 4;
+			if (!layout.compressed) {
+				const size_t size = HeaderWord(bytes, 0, layout);
+				if (size > bytes.size() - word) {
+					InvalidVtu("array of " + std::to_string(size) + " bytes exceeds the data");
+				}
+				return bytes.substr(word, size);
+			}
+			const size_t blocks = HeaderWord(bytes, 0, layout);
+			const size_t block_size = HeaderWord(bytes, 1, layout);
+			const size_t last_size = HeaderWord(bytes, 2, layout);
+			if (blocks == 0) {
+				return {};
+			}
+			const size_t size = (blocks - 1) * block_size + (last_size != 0 ? last_size : block_size);
+			buffer.resize(size);
+			size_t position = (3 + blocks) * word;
+			for (size_t block = 0; block < blocks; ++block) {
+				const size_t compressed = HeaderWord(bytes, 3 + block, layout);
+				if (position > bytes.size() || compressed > bytes.size() - position) {
+					InvalidVtu("compressed block exceeds the data");
+				}
+				const size_t uncompressed = block + 1 < blocks || last_size == 0 ? block_size : last_size;
+				ZlibUncompress(bytes.substr(position, compressed), buffer.data() + block * block_size, uncompressed);
+				position += compressed;
+			}
+			return { buffer.data(), size };
+		}
+
+		/*
+		 * @brief Appends the values of a DataArray, in whichever format it is stored, converted to T
+		 */
+		template <typename T>
+		void Values(const DataArray& array, const VtuLayout& layout, std::vector<T>& values) {
+			const std::string_view type = Attribute(array.tag, "type");
+			const std::string_view format = Attribute(array.tag, "format");
+			if (format == "ascii") {
+				const std::string_view text = array.content;
+				size_t position = 0;
+				while (true) {
+					while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position]))) {
+						++position;
+					}
+					if (position >= text.size()) {
+						return;
+					}
+					T value;
+					if (!ParseNumber(text, position, value)) {
+						InvalidVtu("ascii value \"" + std::string(text.substr(position, 32)) + "\"");
+					}
+					values.push_back(value);
+				}
+			}
+
+			if (format == "appended" && array.offset > layout.appended.size()) {
+				InvalidVtu("appended offset " + std::to_string(array.offset) + " exceeds the data");
+			}
+			std::vector<char> decoded, uncompressed;
+			std::string_view bytes;
+			if (format == "binary" || (format == "appended" && layout.appended_base64)) {
+				const std::string_view text = format == "binary" ? array.content : layout.appended.substr(array.offset, array.end - array.offset);
+				decoded.resize(Base64DecodedSize(text));
+				decoded.resize(Base64Decode(text, decoded.data()));
+				bytes = { decoded.data(), decoded.size() };
+			} else if (format == "appended") {
+				bytes = layout.appended.substr(array.offset);
+			} else {
+				InvalidVtu("unsupported format " + std::string(format));
+			}
+			Convert(type, Payload(bytes, layout, uncompressed), layout.swap, values);
+		}
+
+		/*
+		 * @brief Reads an array of `components` values per entry into rows, as the fields of fedes::Model are stored
+		 */
+		void Rows(const DataArray& array, const VtuLayout& layout, std::vector<std::vector<double>>& rows) {
+			const size_t components = SizeAttribute(array.tag, "NumberOfComponents", 1);
+			std::vector<double> values;
+			Values(array, layout, values);
+			if (components == 0 || values.size() % components != 0) {
+				InvalidVtu(std::to_string(values.size()) + " values of " + std::to_string(components) + " components");
+			}
+			rows.reserve(rows.size() + values.size() / components);
+			for (size_t i = 0; i < values.size(); i += components) {
+				rows.emplace_back(values.begin() + i, values.begin() + i + components);
+			}
+		}
+
+		/*
+		 * @brief Field of fedes::Model an array is read into, from its name like MorpheoInputOutputRead (case insensitive,
+		 * e.g. Stress, displacement, TotalStrain, PlasticStrain, AccumulatedStrain, accumulated_plastic_strain)
+		 */
+		std::vector<std::vector<double>>* Field(fedes::Model& model, std::string_view name) {
+			if (ContainsLower(name, "stress")) {
+				return &model.stress;
+			}
+			if (ContainsLower(name, "displacement")) {
+				return &model.displacement;
+			}
+			if (ContainsLower(name, "plastic") && !ContainsLower(name, "accumulated")) {
+				return &model.plastic_strain;
+			}
+			if (ContainsLower(name, "strain") && !ContainsLower(name, "accumulated")) {
+				return &model.total_strain;
+			}
+			return nullptr;
+		}
+	}
+
+	/*
+	 * @brief Maps nodes, elements and nodal fields (stress, displacement, total, plastic and accumulated strain, the NodeId
+	 * and ElementId arrays written by CreateXML) to fedes::Model from a .vtu file, in the ascii, binary (base64) or
+	 * appended (raw or base64) format, zlib compressed or not. The file is memory mapped, raw appended arrays are
+	 * converted from the mapping straight into the model, and base64 is decoded a quad at a time, so binary files load
+	 * without any text parsing. Pieces are concatenated. Cell data other than ElementId is ignored, as the fields of
+	 * fedes::Model are nodal.
+	 * @param path: Path to the file
+	 * @param model: Model which will be updated by reference
+	 * @exception std::ifstream::failure if the file cannot be read, std::invalid_argument for malformed or unsupported
+	 * contents, std::runtime_error for compressed files if FEDES is built without zlib
+	 */
+	void VtuRead(const std::filesystem::path& path, fedes::Model& model) {
+		const fedes::MappedFile file(path);
+		const std::string_view text = file.view();
+
+		VtuLayout layout;
+		size_t markup_end = text.size();
+		const size_t appended = text.find("<AppendedData");
+		if (appended != std::string_view::npos) {
+			markup_end = appended;
+			const size_t close = text.find('>', appended);
+			const size_t underscore = text.find('_', close);
+			if (close == std::string_view::npos || underscore == std::string_view::npos) {
+				InvalidVtu("AppendedData without data");
+			}
+			const std::string_view tag = text.substr(appended, close - appended);
+			layout.appended_base64 = Attribute(tag, "encoding") == "base64";
+			layout.appended = text.substr(underscore + 1);
+			if (layout.appended_base64) {
+				layout.appended = layout.appended.substr(0, layout.appended.find("</AppendedData>"));
+			}
+		}
+
+		enum class Section { None, Points, Cells, PointData, CellData };
+		Section section = Section::None;
+		using Piece = std::vector<std::pair<Section, DataArray>>;
+		std::vector<Piece> pieces;
+
+		size_t position = 0;
+		while ((position = text.find('<', position)) < markup_end) {
+			if (text.substr(position, 4) == "<!--") {
+				position = text.find("-->", position);
+				continue;
+			}
+			const size_t close = text.find('>', position);
+			if (close == std::string_view::npos) {
+				InvalidVtu("unterminated tag");
+			}
+			const std::string_view tag = text.substr(position, close + 1 - position);
+			position = close + 1;
+
+			const size_t name_end = std::min(tag.find_first_of(" \t\r\n/>", 1), tag.size());
+			const std::string_view name = tag.substr(1, name_end - 1);
+			if (name == "VTKFile") {
+				const std::string_view type = Attribute(tag, "type");
+				if (!type.empty() && type != "UnstructuredGrid") {
+					InvalidVtu("type " + std::string(type));
+				}
+				layout.header_64 = Attribute(tag, "header_type") == "UInt64";
+				layout.swap = (Attribute(tag, "byte_order") == "BigEndian") != (std::endian::native == std::endian::big);
+				const std::string_view compressor = Attribute(tag, "compressor");
+				layout.compressed = !compressor.empty();
+				if (layout.compressed && compressor != "vtkZLibDataCompressor") {
+					InvalidVtu("compressor " + std::string(compressor));
+				}
+			} else if (name == "Piece") {
+				pieces.emplace_back();
+			} else if (name == "Points") {
+				section = Section::Points;
+			} else if (name == "Cells") {
+				section = Section::Cells;
+			} else if (name == "PointData") {
+				section = Section::PointData;
+			} else if (name == "CellData") {
+				section = Section::CellData;
+			} else if (name == "/Points" || name == "/Cells" || name == "/PointData" || name == "/CellData") {
+				section = Section::None;
+			} else if (name == "DataArray") {
+				if (pieces.empty()) {
+					InvalidVtu("DataArray outside of a Piece");
+				}
+				DataArray array{ tag };
+				if (tag[tag.size() - 2] != '/') {
+					const size_t end = text.find("</DataArray>", position);
+					if (end == std::string_view::npos) {
+						InvalidVtu("unterminated DataArray");
+					}
+					array.content = text.substr(position, end - position);
+					position = end + 12;
+				}
+				array.offset = SizeAttribute(tag, "offset", 0);
+				pieces.back().emplace_back(section, array);
+			}
+		}
+
+		// Base64 appended arrays run to the next offset
+		std::vector<size_t> starts;
+		for (const Piece& piece : pieces) {
+			for (const auto& [section, array] : piece) {
+				starts.push_back(array.offset);
+			}
+		}
+		std::sort(starts.begin(), starts.end());
+		for (Piece& piece : pieces) {
+			for (auto& [section, array] : piece) {
+				const auto next = std::upper_bound(starts.begin(), starts.end(), array.offset);
+				array.end = std::min(next != starts.end() ? *next : layout.appended.size(), layout.appended.size());
+			}
+		}
+
+		for (const Piece& piece : pieces) {
+			const size_t first_node = model.nodes.size();
+			std::vector<size_t> connectivity, offsets;
+			for (const auto& [section, array] : piece) {
+				const std::string_view name = Attribute(array.tag, "Name");
+				if (section == Section::Points) {
+					std::vector<double> values;
+					Values(array, layout, values);
+					if (SizeAttribute(array.tag, "NumberOfComponents", 3) != 3 || values.size() % 3 != 0) {
+						InvalidVtu("points are not 3D");
+					}
+					model.nodes.reserve(model.nodes.size() + values.size() / 3);
+					for (size_t i = 0; i < values.size(); i += 3) {
+						model.nodes.emplace_back(values[i], values[i + 1], values[i + 2]);
+					}
+				} else if (section == Section::Cells && name == "connectivity") {
+					Values(array, layout, connectivity);
+				} else if (section == Section::Cells && name == "offsets") {
+					Values(array, layout, offsets);
+				} else if (section == Section::PointData && name == "NodeId") {
+					Values(array, layout, model.node_ids);
+				} else if (section == Section::CellData && name == "ElementId") {
+					Values(array, layout, model.element_ids);
+				} else if (section == Section::PointData && ContainsLower(name, "accumulated")) {
+					Values(array, layout, model.accumulated_strain);
+				} else if (section == Section::PointData) {
+					if (std::vector<std::vector<double>>* field = Field(model, name); field != nullptr) {
+						Rows(array, layout, *field);
+					}
+				}
+			}
+
+			model.elements.reserve(model.elements.size() + offsets.size());
+			size_t begin = 0;
+			for (size_t end : offsets) {
+				if (end < begin || end > connectivity.size()) {
+					InvalidVtu("cell offset " + std::to_string(end));
+				}
+				std::vector<size_t>& element = model.elements.emplace_back(connectivity.begin() + begin, connectivity.begin() + end);
+				for (size_t& node : element) {
+					node += first_node;
+				}
+				begin = end;
+			}
+		}
+	}
+}
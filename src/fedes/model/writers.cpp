@@ -2,29 +2,192 @@
 
 #include "fedes/model/writers.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
-#include <format>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
 
 #include "fedes/common/files.h"
+#include "fedes/common/compression.h"
 #include "fedes/maths/vector3.h"
 #include "fedes/model/model.h"
+#include "fedes/maths/z_ordering.h"
+#include "fedes/common/scheduling.h"
 
 namespace fedes {
 
+	/*
+	 * @brief Average of the values of every element's integration points, as cell data holds one value per element
+	 * @param offsets: Model::integration_offsets
+	 */
+	template <typename T>
+	static std::vector<T> ElementAverage(const std::vector<T>& field, const std::vector<size_t>& offsets) {
+		std::vector<T> averaged;
+		if (field.empty()) {
+			return averaged;
+		}
+		averaged.reserve(offsets.size() - 1);
+		for (size_t e = 0; e + 1 < offsets.size(); ++e) {
+			T sum = field[offsets[e]];
+			for (size_t p = offsets[e] + 1; p < offsets[e + 1]; ++p) {
+				if constexpr (std::is_arithmetic_v<T>) {
+					sum += field[p];
+				} else {
+					for (size_t k = 0; k < sum.size(); ++k) {
+						sum[k] += field[p][k];
+					}
+				}
+			}
+			const double count = static_cast<double>(offsets[e + 1] - offsets[e]);
+			if constexpr (std::is_arithmetic_v<T>) {
+				sum /= count;
+			} else {
+				for (auto& v : sum) {
+					v /= count;
+				}
+			}
+			averaged.push_back(std::move(sum));
+		}
+		return averaged;
+	}
+
+	namespace {
+		/*
+		 * @brief The stresses and strains written: the model's, or their averages per element (cell data holds one value per
+		 * element) when by integration point
+		 */
+		struct FeFields {
+			FeFields(const fedes::Model& model, bool by_integration)
+				: average(by_integration && !model.integration_offsets.empty()),
+				stress_average(average ? ElementAverage(model.stress, model.integration_offsets) : std::vector<std::vector<double>>()),
+				total_strain_average(average ? ElementAverage(model.total_strain, model.integration_offsets) : std::vector<std::vector<double>>()),
+				plastic_strain_average(average ? ElementAverage(model.plastic_strain, model.integration_offsets) : std::vector<std::vector<double>>()),
+				accumulated_strain_average(average ? ElementAverage(model.accumulated_strain, model.integration_offsets) : std::vector<double>()),
+				stress(average ? stress_average : model.stress),
+				total_strain(average ? total_strain_average : model.total_strain),
+				plastic_strain(average ? plastic_strain_average : model.plastic_strain),
+				accumulated_strain(average ? accumulated_strain_average : model.accumulated_strain) {}
+
+			const bool average;
+			const std::vector<std::vector<double>> stress_average, total_strain_average, plastic_strain_average;
+			const std::vector<double> accumulated_strain_average;
+			const std::vector<std::vector<double>>& stress;
+			const std::vector<std::vector<double>>& total_strain;
+			const std::vector<std::vector<double>>& plastic_strain;
+			const std::vector<double>& accumulated_strain;
+		};
+	}
+
+	static bool HasFeFields(const fedes::Model& model) {
+		return !model.stress.empty() || !model.plastic_strain.empty() || !model.total_strain.empty() || !model.accumulated_strain.empty();
+	}
+
+	/*
+	 * @brief VTK cell type of an element from its number of nodes, empty if unsupported. Linear cells of planar models
+	 * (all z = 0) are 2D: a 4 node element is then a quad rather than a tetrahedron.
+	 */
+	static std::optional<uint8_t> CellType(size_t nodes, bool planar) {
+		switch (nodes) {
+		case 3:
+			return 5;
+		case 4:
+			return planar ? 9 : 10;
+		case 6:
+			return planar ? 22 : 13;
+		case 8:
+			return planar ? 23 : 12;
+		case 10:
+			return 24;
+		case 15:
+			return 13;
+		case 20:
+			return 25;
+		default:
+			return {};
+		}
+	}
+
+	namespace {
+		constexpr size_t ascii_chunk = 1 << 14; // @brief: rows formatted per task
+
+		/*
+		 * @brief Appends the shortest representation that reads back to the same value, as std::format("{}") and
+		 * std::to_string write them, without allocating
+		 */
+		template <typename T>
+		void AppendNumber(std::string& buffer, T value) {
+			std::array<char, 32> digits;
+			char* end = std::to_chars(digits.data(), digits.data() + digits.size(), value).ptr;
+			buffer.append(digits.data(), end);
+		}
+
+		/*
+		 * @brief Writes the rows [0, count) of an ascii array, each formatted by format(buffer, row). Rows are formatted in
+		 * chunks into reused buffers, a batch of chunks at a time, concurrently when a pool is given, and the buffers are
+		 * written in order, so the output does not depend on the pool.
+		 */
+		template <typename F>
+		void WriteAscii(std::ostream& stream, size_t count, std::optional<BS::thread_pool*> pool, F&& format) {
+			const size_t threads = pool.has_value() ? std::max<size_t>(1, pool.value()->get_thread_count()) : 1;
+			std::vector<std::string> buffers(4 * threads);
+			auto format_chunk = [&](size_t first, size_t chunk) {
+				std::string& buffer = buffers[chunk];
+				buffer.clear();
+				const size_t begin = first + chunk * ascii_chunk;
+				const size_t end = std::min(begin + ascii_chunk, count);
+				for (size_t i = begin; i < end; ++i) {
+					format(buffer, i);
+				}
+			};
+			for (size_t first = 0; first < count; first += buffers.size() * ascii_chunk) {
+				const size_t chunks = std::min(buffers.size(), (count - first + ascii_chunk - 1) / ascii_chunk);
+				if (pool.has_value() && chunks > 1) {
+					fedes::ParallelFor(*pool.value(), 0, chunks, [&](const size_t& a, const size_t& b) {
+						for (size_t chunk = a; chunk < b; ++chunk) {
+							format_chunk(first, chunk);
+						}
+					}, 1).get();
+				} else {
+					for (size_t chunk = 0; chunk < chunks; ++chunk) {
+						format_chunk(first, chunk);
+					}
+				}
+				for (size_t chunk = 0; chunk < chunks; ++chunk) {
+					stream.write(buffers[chunk].data(), static_cast<std::streamsize>(buffers[chunk].size()));
+				}
+			}
+		}
+	}
+
 	/*
 	 * @brief CreateXML will export an XML file with data that can be visualised with ParaView or Morpheo by providing a model and output file path.
 	 * @port This function is ported from FEDES v2
 	 * @param path: Path to write file to, e.g. "dir/a.xml" or "b.vtu"
 	 * @param model: Model that will be used to write data to the file from
 	 * @param by_integration: differentiates whether or not we are dealing with certain values by integration or node points,
-	 * in FEDES v2, this corresponds to the difference between createXML1 and create XML2
+	 * in FEDES v2, this corresponds to the difference between createXML1 and create XML2. Values of multiple integration
+	 * points per element (Model::AssignGaussIntegration) are averaged per element. The external IDs of sparsely numbered
+	 * input files (Model::node_ids/element_ids) are written as the NodeId/ElementId arrays.
+	 * @param pool: formats the arrays in parallel chunks, written in order, so that the file is the same as without it
 	 * @exception Propagates std::ofstream failure
 	 */
-	void CreateXML(const std::filesystem::path& output_file_path, fedes::Model& model, bool by_integration, bool has_fe_data) {
-		int num = 0;
+	void CreateXML(const std::filesystem::path& output_file_path, fedes::Model& model, bool by_integration, bool has_fe_data,
+		std::optional<BS::thread_pool*> pool) {
 		double z_coord = 0.00;
-		std::string str;
 		std::ofstream stream;
 		try {
 			fedes::SetOutputFileStream(output_file_path, stream);
@@ -37,137 +200,581 @@ namespace fedes {
 		stream << "<UnstructuredGrid>\n";
 		stream << "<Piece NumberOfPoints=\"" << model.nodes.size() << "\" NumberOfCells=\"" << model.elements.size() << "\" >\n";
 
-		if (!model.displacement.empty() && has_fe_data) {
-			stream << "<PointData Tensors=\"Vector\" >\n";
-			stream << "<DataArray type=\"Float64\" Name=\"displacement\" NumberOfComponents=\"3\" format=\"ascii\" >\n";
-			for (auto& d : model.displacement) {	
-				stream << std::format("{} {} {}", d[0], d[1], d[2]) << '\n';
-			}
-			stream << "</DataArray>\n";
-		}
-		if (by_integration && has_fe_data) {
-			stream << "</PointData>\n";
-		}
-		if (has_fe_data && (!model.stress.empty()) || (!model.plastic_strain.empty()) || (!model.total_strain.empty()) || (!model.accumulated_strain.empty())) {
-			if (by_integration) {
-				stream << "<CellData Tensors=\"stress\" >\n";
-			}
+		const FeFields fields(model, by_integration);
+		auto write_rows = [&](const std::vector<std::vector<double>>& rows, size_t components) {
+			WriteAscii(stream, rows.size(), pool, [&](std::string& buffer, size_t i) {
+				for (size_t k = 0; k < components; ++k) {
+					if (k != 0) {
+						buffer += ' ';
+					}
+					AppendNumber(buffer, rows[i][k]);
+				}
+				buffer += '\n';
+			});
+		};
+		auto write_scalars = [&](const auto& values) {
+			WriteAscii(stream, values.size(), pool, [&](std::string& buffer, size_t i) {
+				AppendNumber(buffer, values[i]);
+				buffer += '\n';
+			});
+		};
+
+		// Stresses and strains are cell data when by integration point, point data otherwise
+		const bool fe_fields = has_fe_data && HasFeFields(model);
+		auto write_fe_fields = [&]() {
 			if (!model.stress.empty()) {
 				stream << "<DataArray type=\"Float64\" Name=\"Stress\" NumberOfComponents=\"6\" format=\"ascii\" >\n";
-				for (auto& s : model.stress) {
-					stream << std::format("{} {} {} {} {} {}", s[0], s[1], s[2], s[3], s[4], s[5]) << "\n";
-				}
+				write_rows(fields.stress, 6);
 				stream << "</DataArray>\n";
 			}
 			if (!model.total_strain.empty()) {
 				stream << "<DataArray type=\"Float64\" Name=\"TotalStrain\" NumberOfComponents=\"6\" format=\"ascii\" >\n";
-				for (auto& s : model.total_strain) {
-					stream << std::format("{} {} {} {} {} {}", s[0], s[1], s[2], s[3], s[4], s[5]) << "\n";
-				}
+				write_rows(fields.total_strain, 6);
 				stream << "</DataArray>\n";
 			}
 			if (!model.plastic_strain.empty()) {
 				stream << "<DataArray type=\"Float64\" Name=\"PlasticStrain\" NumberOfComponents=\"6\" format=\"ascii\" >\n";
-				for (auto& s : model.plastic_strain) {
-					stream << std::format("{} {} {} {} {} {}", s[0], s[1], s[2], s[3], s[4], s[5]) << "\n";
-				}
+				write_rows(fields.plastic_strain, 6);
 				stream << "</DataArray>\n";
 			}
 			if (!model.accumulated_strain.empty()) {
 				stream << "<DataArray type=\"Float64\" Name=\"AccumulatedStrain\" NumberOfComponents=\"1\" format=\"ascii\" >\n";
-				for (auto& s : model.accumulated_strain) {
-					stream << std::format("{}", s) << "\n";
-				}
+				write_scalars(fields.accumulated_strain);
 				stream << "</DataArray>\n";
 			}
-			if (by_integration) {
-				stream << "</CellData>\n";
+		};
+		// External IDs of the input file (see IdMap), only kept when not simply 1, 2, 3, ...
+		auto write_ids = [&](const char* name, const std::vector<size_t>& ids) {
+			stream << "<DataArray type=\"Int64\" Name=\"" << name << "\" NumberOfComponents=\"1\" format=\"ascii\" >\n";
+			write_scalars(ids);
+			stream << "</DataArray>\n";
+		};
+
+		const bool displacement = !model.displacement.empty() && has_fe_data;
+		if (displacement || (fe_fields && !by_integration) || !model.node_ids.empty()) {
+			stream << "<PointData Tensors=\"Vector\" >\n";
+			if (displacement) {
+				stream << "<DataArray type=\"Float64\" Name=\"displacement\" NumberOfComponents=\"3\" format=\"ascii\" >\n";
+				write_rows(model.displacement, 3);
+				stream << "</DataArray>\n";
+			}
+			if (fe_fields && !by_integration) {
+				write_fe_fields();
+			}
+			if (!model.node_ids.empty()) {
+				write_ids("NodeId", model.node_ids);
 			}
-		}
-		if (!by_integration && has_fe_data) {
 			stream << "</PointData>\n";
 		}
+		if ((fe_fields && by_integration) || !model.element_ids.empty()) {
+			stream << "<CellData Tensors=\"stress\" >\n";
+			if (fe_fields && by_integration) {
+				write_fe_fields();
+			}
+			if (!model.element_ids.empty()) {
+				write_ids("ElementId", model.element_ids);
+			}
+			stream << "</CellData>\n";
+		}
 		stream << "<Cells>\n";
 		stream << "<DataArray type=\"UInt32\" Name=\"connectivity\" NumberOfComponents=\"1\" format=\"ascii\" >\n";
-
-		for (auto& e : model.elements) {
-			for (auto& j : e) {
-				str = str + std::to_string(j) + ' ';
+		WriteAscii(stream, model.elements.size(), pool, [&](std::string& buffer, size_t e) {
+			for (size_t node : model.elements[e]) {
+				AppendNumber(buffer, node);
+				buffer += ' ';
 			}
-			stream << str << '\n';
-			str = "";
-		}
+			buffer += '\n';
+		});
 		stream << "</DataArray>\n";
 		stream << "<DataArray type=\"UInt32\" Name=\"offsets\" NumberOfComponents=\"1\" format=\"ascii\" >\n";
-
-		for (auto& e : model.elements) {
-			num = num + e.size();
-			stream << num << '\n';
+		std::vector<size_t> offsets(model.elements.size());
+		size_t num = 0;
+		for (size_t e = 0; e < model.elements.size(); ++e) {
+			num += model.elements[e].size();
+			offsets[e] = num;
 		}
+		write_scalars(offsets);
 		stream << "</DataArray>\n";
 		stream << "<DataArray type=\"UInt8\" Name=\"types\" NumberOfComponents=\"1\" format=\"ascii\" >\n";
 
 		for (auto& n : model.nodes) {
 			z_coord += n.z;
 		}
+		WriteAscii(stream, model.elements.size(), pool, [&](std::string& buffer, size_t e) {
+			if (const std::optional<uint8_t> type = CellType(model.elements[e].size(), z_coord == 0); type.has_value()) {
+				AppendNumber(buffer, static_cast<int>(type.value()));
+				buffer += '\n';
+			}
+		});
+		stream << "</DataArray>\n";
+		stream << "</Cells>\n";
 
-		for (auto& e : model.elements) {
-			if (e.size() == 8) {
-				if (z_coord != 0) {
-					stream << "12\n";
+		stream << "<Points>\n";
+		stream << "<DataArray type=\"Float64\" Name=\"coordinates\" NumberOfComponents=\"3\" format=\"ascii\" >\n";
+		WriteAscii(stream, model.nodes.size(), pool, [&](std::string& buffer, size_t i) {
+			const fedes::Vector3<double>& n = model.nodes[i];
+			AppendNumber(buffer, n.x);
+			buffer += ' ';
+			AppendNumber(buffer, n.y);
+			buffer += ' ';
+			AppendNumber(buffer, n.z);
+			buffer += '\n';
+		});
+		stream << "</DataArray>\n";
+		stream << "</Points>\n";
+
+		stream << "</Piece>\n";
+		stream << "</UnstructuredGrid>\n";
+		stream << "</VTKFile>\n";
+
+		try {
+			fedes::CloseOutputFileStream(stream);
+		}
+		catch (const std::ofstream::failure& e) {
+			throw;
+		}
+	}
+
+	namespace {
+		/*
+		 * @brief An array of a binary .vtu file, whose bytes are only produced when written, so that one array at a time
+		 * is held in memory on top of the model
+		 */
+		struct BinaryArray {
+			std::string section; // @brief: PointData, CellData, Points or Cells
+			std::string name;
+			std::string type; // @brief: VTK type of the values, e.g. Float64
+			size_t components;
+			size_t size; // @brief: in bytes
+			std::function<std::vector<char>()> bytes;
+		};
+
+		template <typename T, typename F>
+		std::vector<char> Pack(size_t count, F&& value) {
+			std::vector<char> bytes(count * sizeof(T));
+			for (size_t i = 0; i < count; ++i) {
+				const T v = value(i);
+				std::memcpy(bytes.data() + i * sizeof(T), &v, sizeof(T));
+			}
+			return bytes;
+		}
+
+		BinaryArray RowsArray(std::string section, std::string name, const std::vector<std::vector<double>>& rows, size_t components) {
+			return { std::move(section), std::move(name), "Float64", components, rows.size() * components * sizeof(double), [&rows, components]() {
+				return Pack<double>(rows.size() * components, [&](size_t i) {
+					const std::vector<double>& row = rows[i / components];
+					return i % components < row.size() ? row[i % components] : 0.0;
+				});
+			} };
+		}
+
+		BinaryArray ScalarsArray(std::string section, std::string name, const std::vector<double>& values) {
+			return { std::move(section), std::move(name), "Float64", 1, values.size() * sizeof(double), [&values]() {
+				return Pack<double>(values.size(), [&](size_t i) { return values[i]; });
+			} };
+		}
+
+		BinaryArray IdsArray(std::string section, std::string name, const std::vector<size_t>& ids) {
+			return { std::move(section), std::move(name), "Int64", 1, ids.size() * sizeof(int64_t), [&ids]() {
+				return Pack<int64_t>(ids.size(), [&](size_t i) { return static_cast<int64_t>(ids[i]); });
+			} };
+		}
+
+		/*
+		 * @brief The arrays CreateXML writes, in the order of a VTK piece: point data, cell data, points, cells
+		 */
+		std::vector<BinaryArray> BinaryArrays(const fedes::Model& model, const FeFields& fields, bool by_integration, bool has_fe_data) {
+			std::vector<BinaryArray> arrays;
+			auto fe_fields = [&](const std::string& section) {
+				if (!has_fe_data) {
+					return;
+				}
+				if (!model.stress.empty()) {
+					arrays.push_back(RowsArray(section, "Stress", fields.stress, 6));
 				}
-				else {
-					stream << "23\n";
+				if (!model.total_strain.empty()) {
+					arrays.push_back(RowsArray(section, "TotalStrain", fields.total_strain, 6));
 				}
+				if (!model.plastic_strain.empty()) {
+					arrays.push_back(RowsArray(section, "PlasticStrain", fields.plastic_strain, 6));
+				}
+				if (!model.accumulated_strain.empty()) {
+					arrays.push_back(ScalarsArray(section, "AccumulatedStrain", fields.accumulated_strain));
+				}
+			};
+
+			if (has_fe_data && !model.displacement.empty()) {
+				arrays.push_back(RowsArray("PointData", "displacement", model.displacement, 3));
+			}
+			if (!by_integration) {
+				fe_fields("PointData");
+			}
+			if (!model.node_ids.empty()) {
+				arrays.push_back(IdsArray("PointData", "NodeId", model.node_ids));
+			}
+			if (by_integration) {
+				fe_fields("CellData");
+			}
+			if (!model.element_ids.empty()) {
+				arrays.push_back(IdsArray("CellData", "ElementId", model.element_ids));
+			}
+
+			arrays.push_back({ "Points", "coordinates", "Float64", 3, model.nodes.size() * 3 * sizeof(double), [&model]() {
+				return Pack<double>(model.nodes.size() * 3, [&](size_t i) {
+					const fedes::Vector3<double>& node = model.nodes[i / 3];
+					return i % 3 == 0 ? node.x : (i % 3 == 1 ? node.y : node.z);
+				});
+			} });
+
+			size_t connectivity = 0;
+			for (const std::vector<size_t>& element : model.elements) {
+				connectivity += element.size();
 			}
-			if (e.size() == 6) {
-				if (z_coord != 0) {
-					stream << "13\n";
+			arrays.push_back({ "Cells", "connectivity", "Int64", 1, connectivity * sizeof(int64_t), [&model, connectivity]() {
+				std::vector<char> bytes(connectivity * sizeof(int64_t));
+				char* out = bytes.data();
+				for (const std::vector<size_t>& element : model.elements) {
+					for (size_t node : element) {
+						const int64_t v = static_cast<int64_t>(node);
+						std::memcpy(out, &v, sizeof(v));
+						out += sizeof(v);
+					}
 				}
-				else {
-					stream << "22\n";
+				return bytes;
+			} });
+			arrays.push_back({ "Cells", "offsets", "Int64", 1, model.elements.size() * sizeof(int64_t), [&model]() {
+				int64_t offset = 0;
+				return Pack<int64_t>(model.elements.size(), [&](size_t e) { return offset += static_cast<int64_t>(model.elements[e].size()); });
+			} });
+			arrays.push_back({ "Cells", "types", "UInt8", 1, model.elements.size(), [&model]() {
+				double z_coord = 0.00;
+				for (auto& n : model.nodes) {
+					z_coord += n.z;
 				}
+				// VTK_EMPTY_CELL (0) for node counts without a type, as every cell needs one
+				return Pack<uint8_t>(model.elements.size(), [&](size_t e) { return CellType(model.elements[e].size(), z_coord == 0).value_or(0); });
+			} });
+			return arrays;
+		}
+
+		/*
+		 * @brief Writes the XML of a piece whose arrays are appended, at the given offsets into the appended data
+		 */
+		void WriteAppendedPiece(std::ostream& stream, const fedes::Model& model, const std::vector<BinaryArray>& arrays,
+			const std::vector<size_t>& offsets) {
+			stream << "<Piece NumberOfPoints=\"" << model.nodes.size() << "\" NumberOfCells=\"" << model.elements.size() << "\" >\n";
+			std::string section;
+			for (size_t i = 0; i < arrays.size(); ++i) {
+				if (arrays[i].section != section) {
+					if (!section.empty()) {
+						stream << "</" << section << ">\n";
+					}
+					section = arrays[i].section;
+					stream << "<" << section << ">\n";
+				}
+				stream << "<DataArray type=\"" << arrays[i].type << "\" Name=\"" << arrays[i].name << "\" NumberOfComponents=\"" <<
+					arrays[i].components << "\" format=\"appended\" offset=\"" << offsets[i] << "\" />\n";
 			}
-			if (e.size() == 4) {
-				if (z_coord != 0) {
-					stream << "10\n";
+			stream << "</" << section << ">\n";
+			stream << "</Piece>\n";
+		}
+
+		const char* ByteOrder() {
+			return std::endian::native == std::endian::little ? "LittleEndian" : "BigEndian";
+		}
+
+		constexpr size_t compressed_block = 1 << 15; // @brief: uncompressed bytes per block, as vtkZLibDataCompressor
+
+		template <typename T>
+		void AppendWord(std::vector<char>& bytes, T word) {
+			const size_t position = bytes.size();
+			bytes.resize(position + sizeof(T));
+			std::memcpy(bytes.data() + position, &word, sizeof(T));
+		}
+
+		/*
+		 * @brief An array as vtkZLibDataCompressor lays it out: a UInt64 header [blocks, block size, size of the last block
+		 * (0 if full), compressed size of every block], then the zlib streams of the blocks, which are compressed
+		 * concurrently when a pool is given
+		 */
+		std::vector<char> CompressedPayload(const std::vector<char>& bytes, std::optional<BS::thread_pool*> pool) {
+			const size_t blocks = (bytes.size() + compressed_block - 1) / compressed_block;
+			std::vector<std::vector<char>> compressed(blocks);
+			auto compress = [&](const size_t& a, const size_t& b) {
+				for (size_t block = a; block < b; ++block) {
+					compressed[block] = fedes::ZlibCompress(std::string_view(bytes.data(), bytes.size()).substr(block * compressed_block, compressed_block));
 				}
-				else {
-					stream << "9\n";
+			};
+			if (pool.has_value() && blocks > 1) {
+				fedes::ParallelFor(*pool.value(), 0, blocks, compress, 1).get();
+			} else {
+				compress(0, blocks);
+			}
+
+			std::vector<char> payload;
+			size_t size = (3 + blocks) * sizeof(uint64_t);
+			for (const std::vector<char>& block : compressed) {
+				size += block.size();
+			}
+			payload.reserve(size);
+			AppendWord<uint64_t>(payload, blocks);
+			AppendWord<uint64_t>(payload, compressed_block);
+			AppendWord<uint64_t>(payload, bytes.size() % compressed_block);
+			for (const std::vector<char>& block : compressed) {
+				AppendWord<uint64_t>(payload, block.size());
+			}
+			for (const std::vector<char>& block : compressed) {
+				payload.insert(payload.end(), block.begin(), block.end());
+			}
+			return payload;
+		}
+
+		/*
+		 * @brief Writes a .vtu file with the arrays appended as raw data, uncompressed or zlib compressed. Uncompressed
+		 * arrays are produced one at a time while writing; compressed ones are all compressed first, as their offsets in the
+		 * XML depend on their compressed sizes.
+		 */
+		void WriteAppendedXML(const std::filesystem::path& output_file_path, const fedes::Model& model, bool by_integration,
+			bool has_fe_data, bool compressed, std::optional<BS::thread_pool*> pool) {
+			const FeFields fields(model, by_integration);
+			const std::vector<BinaryArray> arrays = BinaryArrays(model, fields, by_integration, has_fe_data);
+			std::vector<std::vector<char>> payloads;
+			if (compressed) {
+				for (const BinaryArray& array : arrays) {
+					payloads.push_back(CompressedPayload(array.bytes(), pool));
 				}
 			}
-			if (e.size() == 3) {
-				stream << "5\n";
+			std::vector<size_t> offsets;
+			size_t offset = 0;
+			for (size_t i = 0; i < arrays.size(); ++i) {
+				offsets.push_back(offset);
+				offset += compressed ? payloads[i].size() : sizeof(uint64_t) + arrays[i].size;
 			}
-			if (e.size() == 10) {
-				stream << "24\n";
+
+			std::ofstream stream;
+			try {
+				fedes::SetOutputFileStream(output_file_path, stream, true);
+			} catch (const std::ofstream::failure& e) {
+				throw;
 			}
-			if (e.size() == 15) {
-				stream << "13\n";
+			stream << "<?xml version=\"1.0\"?>\n";
+			stream << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"" << ByteOrder() << "\" header_type=\"UInt64\"" <<
+				(compressed ? " compressor=\"vtkZLibDataCompressor\"" : "") << " >\n";
+			stream << "<UnstructuredGrid>\n";
+			WriteAppendedPiece(stream, model, arrays, offsets);
+			stream << "</UnstructuredGrid>\n";
+			stream << "<AppendedData encoding=\"raw\" >\n_";
+			for (size_t i = 0; i < arrays.size(); ++i) {
+				if (compressed) {
+					stream.write(payloads[i].data(), static_cast<std::streamsize>(payloads[i].size()));
+					std::vector<char>().swap(payloads[i]);
+					continue;
+				}
+				const uint64_t size = arrays[i].size;
+				const std::vector<char> bytes = arrays[i].bytes();
+				stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+				stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
 			}
-			if (e.size() == 20) {
-				stream << "25\n";
+			stream << "\n</AppendedData>\n";
+			stream << "</VTKFile>\n";
+
+			try {
+				fedes::CloseOutputFileStream(stream);
+			} catch (const std::ofstream::failure& e) {
+				throw;
 			}
 		}
-		stream << "</DataArray>\n";
-		stream << "</Cells>\n";
+	}
 
-		stream << "<Points>\n";
-		stream << "<DataArray type=\"Float64\" Name=\"coordinates\" NumberOfComponents=\"3\" format=\"ascii\" >\n";
-		for (auto& n : model.nodes) {
-			stream << std::format("{} {} {}", n.x, n.y, n.z) << '\n';
+	/*
+	 * @brief Like CreateXML, but with the arrays written in binary as raw data appended to the XML (UInt64 sizes before
+	 * every array), which is several times smaller than ascii, needs no number formatting, and is written with one large
+	 * write per array. Connectivity, offsets and IDs are Int64, cell types UInt8 and every field Float64. Read by ParaView
+	 * and VtuRead.
+	 * @param path: Path to write file to, e.g. "b.vtu"
+	 * @param model: Model that will be used to write data to the file from
+	 * @param by_integration: stresses and strains as cell data (averaged per element) rather than point data, see CreateXML
+	 * @exception Propagates std::ofstream failure
+	 */
+	void CreateAppendedXML(const std::filesystem::path& output_file_path, const fedes::Model& model, bool by_integration, bool has_fe_data) {
+		WriteAppendedXML(output_file_path, model, by_integration, has_fe_data, false, std::nullopt);
+	}
+
+	/*
+	 * @brief Like CreateAppendedXML, with every array zlib compressed in 32 KiB blocks (compressor="vtkZLibDataCompressor"),
+	 * typically a further several times smaller. The blocks of an array are compressed in parallel on the pool, if given.
+	 * @exception Propagates std::ofstream failure, std::runtime_error if FEDES is built without zlib (see HasZlib)
+	 */
+	void CreateCompressedXML(const std::filesystem::path& output_file_path, const fedes::Model& model, bool by_integration, bool has_fe_data,
+		std::optional<BS::thread_pool*> pool) {
+		WriteAppendedXML(output_file_path, model, by_integration, has_fe_data, true, pool);
+	}
+
+	namespace {
+		/*
+		 * @brief Copies the rows of the given entries (nodes or elements), if the field has any
+		 */
+		template <typename T>
+		std::vector<T> Select(const std::vector<T>& field, const std::vector<size_t>& entries) {
+			std::vector<T> selected;
+			if (field.empty()) {
+				return selected;
+			}
+			selected.reserve(entries.size());
+			for (size_t entry : entries) {
+				selected.push_back(field[entry]);
+			}
+			return selected;
 		}
-		stream << "</DataArray>\n";
-		stream << "</Points>\n";
 
-		stream << "</Piece>\n";
-		stream << "</UnstructuredGrid>\n";
+		/*
+		 * @brief Copies the values of the integration points of the given elements
+		 * @param offsets: Model::integration_offsets
+		 */
+		template <typename T>
+		std::vector<T> SelectIntegration(const std::vector<T>& field, const std::vector<size_t>& elements, const std::vector<size_t>& offsets) {
+			std::vector<T> selected;
+			if (field.empty()) {
+				return selected;
+			}
+			for (size_t e : elements) {
+				selected.insert(selected.end(), field.begin() + offsets[e], field.begin() + offsets[e + 1]);
+			}
+			return selected;
+		}
+
+		/*
+		 * @brief The elements [first, last) of the given order as a model of their own: the nodes they use (shared nodes are
+		 * in every piece using them), renumbered, with the fields as the writers read them (per node, or per element or
+		 * integration point when by integration)
+		 */
+		fedes::Model Piece(const fedes::Model& model, const std::vector<size_t>& order, size_t first, size_t last, bool by_integration) {
+			fedes::Model piece;
+			const std::vector<size_t> elements(order.begin() + first, order.begin() + last);
+			std::vector<size_t> nodes;
+			for (size_t e : elements) {
+				nodes.insert(nodes.end(), model.elements[e].begin(), model.elements[e].end());
+			}
+			std::sort(nodes.begin(), nodes.end());
+			nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+			piece.nodes = Select(model.nodes, nodes);
+			piece.elements.reserve(elements.size());
+			for (size_t e : elements) {
+				std::vector<size_t>& element = piece.elements.emplace_back(model.elements[e]);
+				for (size_t& node : element) {
+					node = static_cast<size_t>(std::lower_bound(nodes.begin(), nodes.end(), node) - nodes.begin());
+				}
+			}
+			piece.node_ids = Select(model.node_ids, nodes);
+			piece.element_ids = Select(model.element_ids, elements);
+			piece.displacement = Select(model.displacement, nodes);
+
+			if (!by_integration) {
+				piece.stress = Select(model.stress, nodes);
+				piece.total_strain = Select(model.total_strain, nodes);
+				piece.plastic_strain = Select(model.plastic_strain, nodes);
+				piece.accumulated_strain = Select(model.accumulated_strain, nodes);
+			} else if (model.integration_offsets.empty()) {
+				piece.stress = Select(model.stress, elements);
+				piece.total_strain = Select(model.total_strain, elements);
+				piece.plastic_strain = Select(model.plastic_strain, elements);
+				piece.accumulated_strain = Select(model.accumulated_strain, elements);
+			} else {
+				const std::vector<size_t>& offsets = model.integration_offsets;
+				piece.stress = SelectIntegration(model.stress, elements, offsets);
+				piece.total_strain = SelectIntegration(model.total_strain, elements, offsets);
+				piece.plastic_strain = SelectIntegration(model.plastic_strain, elements, offsets);
+				piece.accumulated_strain = SelectIntegration(model.accumulated_strain, elements, offsets);
+				piece.integration_offsets.push_back(0);
+				for (size_t e : elements) {
+					piece.integration_offsets.push_back(piece.integration_offsets.back() + offsets[e + 1] - offsets[e]);
+				}
+			}
+			return piece;
+		}
+	}
+
+	/*
+	 * @brief Exports the model as a partitioned .vtu: `pieces` .vtu files (name_0.vtu, name_1.vtu, ...) next to a .pvtu
+	 * index referencing them, which ParaView loads in parallel. Pieces are equal ranges of the elements along the Morton
+	 * curve of their centroids, so each covers a compact region, and are extracted and written concurrently, one task per
+	 * piece, through their own streams. Nodes used by no element are in no piece.
+	 * @param path: Path of the .pvtu index, e.g. "dir/target.pvtu"
+	 * @param by_integration: stresses and strains as cell data, see CreateXML
+	 * @param pieces: number of pieces, at most one per element
+	 * @param format: encoding of the pieces, see Model::Export
+	 * @exception Propagates std::ofstream failure, and std::runtime_error for VtuFormat::Compressed without zlib
+	 */
+	void CreatePartitionedXML(const std::filesystem::path& output_file_path, const fedes::Model& model, bool by_integration, bool has_fe_data,
+		size_t pieces, VtuFormat format, BS::thread_pool& pool) {
+		pieces = std::max<size_t>(1, std::min(pieces, model.elements.size()));
+		std::vector<fedes::Vector3<double>> centroids(model.elements.size());
+		fedes::ParallelFor(pool, 0, model.elements.size(), [&](const size_t& a, const size_t& b) {
+			for (size_t e = a; e < b; ++e) {
+				fedes::Vector3<double> sum(0.0);
+				for (size_t node : model.elements[e]) {
+					sum += model.nodes[node];
+				}
+				centroids[e] = model.elements[e].empty() ? sum : sum / static_cast<double>(model.elements[e].size());
+			}
+		}).get();
+		const std::vector<size_t> order = model.elements.empty() ? std::vector<size_t>() : fedes::MortonOrder(centroids);
+
+		const std::string stem = output_file_path.stem().string();
+		auto piece_path = [&](size_t p) {
+			return stem + "_" + std::to_string(p) + ".vtu";
+		};
+		fedes::ParallelFor(pool, 0, pieces, [&](const size_t& a, const size_t& b) {
+			for (size_t p = a; p < b; ++p) {
+				fedes::Model piece = Piece(model, order, p * order.size() / pieces, (p + 1) * order.size() / pieces, by_integration);
+				const std::filesystem::path path = output_file_path.parent_path() / piece_path(p);
+				if (format == VtuFormat::Ascii) {
+					CreateXML(path, piece, by_integration, has_fe_data);
+				} else if (format == VtuFormat::Appended) {
+					CreateAppendedXML(path, piece, by_integration, has_fe_data);
+				} else {
+					CreateCompressedXML(path, piece, by_integration, has_fe_data);
+				}
+			}
+		}, 1).get();
+
+		// The arrays of a piece, for their names and types, which are the same in every piece and format
+		const fedes::Model first = Piece(model, order, 0, order.size() / pieces, by_integration);
+		const FeFields fields(first, by_integration);
+		std::ofstream stream;
+		try {
+			fedes::SetOutputFileStream(output_file_path, stream);
+		} catch (const std::ofstream::failure& e) {
+			throw;
+		}
+		stream << "<?xml version=\"1.0\"?>\n";
+		stream << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\"" << ByteOrder() << "\" header_type=\"UInt64\" >\n";
+		stream << "<PUnstructuredGrid GhostLevel=\"0\" >\n";
+		std::string section;
+		for (const BinaryArray& array : BinaryArrays(first, fields, by_integration, has_fe_data)) {
+			if (array.section == "Cells") {
+				break;
+			}
+			if (array.section != section) {
+				if (!section.empty()) {
+					stream << "</P" << section << ">\n";
+				}
+				section = array.section;
+				stream << "<P" << section << ">\n";
+			}
+			stream << "<PDataArray type=\"" << array.type << "\" Name=\"" << array.name << "\" NumberOfComponents=\"" << array.components << "\" />\n";
+		}
+		stream << "</P" << section << ">\n";
+		for (size_t p = 0; p < pieces; ++p) {
+			stream << "<Piece Source=\"" << piece_path(p) << "\" />\n";
+		}
+		stream << "</PUnstructuredGrid>\n";
 		stream << "</VTKFile>\n";
 
 		try {
 			fedes::CloseOutputFileStream(stream);
-		}
-		catch (const std::ofstream::failure& e) {
+		} catch (const std::ofstream::failure& e) {
 			throw;
 		}
 	}
@@ -1,11 +1,20 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
+
+#include <BS_thread_pool.hpp>
 
 #include "fedes/model/model.h"
 
 namespace fedes {
 
-	void CreateXML(const std::filesystem::path& output_file_path, fedes::Model& model, bool by_integration, bool has_fe_data);
+	void CreateXML(const std::filesystem::path& output_file_path, fedes::Model& model, bool by_integration, bool has_fe_data,
+		std::optional<BS::thread_pool*> pool = std::nullopt);
+	void CreateAppendedXML(const std::filesystem::path& output_file_path, const fedes::Model& model, bool by_integration, bool has_fe_data);
+	void CreateCompressedXML(const std::filesystem::path& output_file_path, const fedes::Model& model, bool by_integration, bool has_fe_data,
+		std::optional<BS::thread_pool*> pool = std::nullopt);
+	void CreatePartitionedXML(const std::filesystem::path& output_file_path, const fedes::Model& model, bool by_integration, bool has_fe_data,
+		size_t pieces, VtuFormat format, BS::thread_pool& pool);
 
 }
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include "fedes/verification/quality.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/common/scheduling.h"
+
+namespace fedes {
+
+	namespace {
+		/*
+		 * @brief Partial statistics of a chunk, merged into the result under a lock once per chunk
+		 */
+		struct Accumulator {
+			size_t count = 0;
+			size_t non_finite = 0;
+			std::vector<double> min;
+			std::vector<double> max;
+			std::vector<double> sum;
+			std::vector<double> sum_sq;
+
+			explicit Accumulator(size_t components)
+				: min(components, std::numeric_limits<double>::max()), max(components, std::numeric_limits<double>::lowest()),
+				  sum(components, 0.0), sum_sq(components, 0.0) {}
+
+			void Add(size_t component, double value) {
+				min[component] = std::min(min[component], value);
+				max[component] = std::max(max[component], value);
+				sum[component] += value;
+				sum_sq[component] += value * value;
+			}
+
+			void Merge(const Accumulator& other) {
+				count += other.count;
+				non_finite += other.non_finite;
+				for (size_t c = 0; c < min.size(); ++c) {
+					min[c] = std::min(min[c], other.min[c]);
+					max[c] = std::max(max[c], other.max[c]);
+					sum[c] += other.sum[c];
+					sum_sq[c] += other.sum_sq[c];
+				}
+			}
+
+			FieldStatistics Statistics(const std::string& name) const {
+				FieldStatistics statistics{ name, count, non_finite };
+				statistics.min = min;
+				statistics.max = max;
+				statistics.mean.resize(sum.size());
+				statistics.l2.resize(sum.size());
+				for (size_t c = 0; c < sum.size(); ++c) {
+					statistics.mean[c] = count != 0 ? sum[c] / count : 0.0;
+					statistics.l2[c] = std::sqrt(sum_sq[c]);
+					if (count == 0) {
+						statistics.min[c] = statistics.max[c] = 0.0;
+					}
+				}
+				return statistics;
+			}
+		};
+
+		/*
+		 * @brief Sums of squared differences and of squared expected values, plus the largest absolute difference
+		 */
+		struct ErrorAccumulator {
+			double max = 0;
+			double difference_sq = 0;
+			double expected_sq = 0;
+			size_t count = 0;
+
+			void Add(double expected, double actual) {
+				const double difference = actual - expected;
+				max = std::max(max, std::abs(difference));
+				difference_sq += difference * difference;
+				expected_sq += expected * expected;
+				++count;
+			}
+
+			void Merge(const ErrorAccumulator& other) {
+				max = std::max(max, other.max);
+				difference_sq += other.difference_sq;
+				expected_sq += other.expected_sq;
+				count += other.count;
+			}
+
+			FieldError Error(const std::string& name) const {
+				FieldError error{ name, max };
+				error.rms = count != 0 ? std::sqrt(difference_sq / count) : 0.0;
+				error.relative_l2 = expected_sq != 0 ? std::sqrt(difference_sq / expected_sq) : std::sqrt(difference_sq);
+				return error;
+			}
+		};
+
+		void WriteComponents(std::ostream& output_stream, const char* label, const std::vector<double>& values) {
+			output_stream << "    " << std::left << std::setw(6) << label << std::right;
+			for (const double& value : values) {
+				output_stream << ' ' << std::setw(13) << value;
+			}
+			output_stream << '\n';
+		}
+
+		void WritePoints(std::ostream& output_stream, const char* label, const PointQuality& quality) {
+			if (quality.count == 0) {
+				return;
+			}
+			output_stream << label << ": " << quality.count << " points, distance to nearest source node mean " << quality.mean_distance
+				<< ", max " << quality.max_distance << '\n';
+			quality.distance.Write(output_stream);
+			if (quality.relaxed != 0 || quality.projected != 0) {
+				output_stream << "  relaxed " << quality.relaxed << ", outside of the source (projected) " << quality.projected
+					<< ", relaxation:\n";
+				quality.relaxation.Write(output_stream);
+			}
+		}
+	}
+
+	/*
+	 * @brief Per component statistics of a field in one parallel pass, every chunk reduces its values before merging them
+	 * @param name: field name to report the statistics under
+	 */
+	FieldStatistics ParallelFieldStatistics(const std::string& name, const std::vector<std::vector<double>>& field, BS::thread_pool& pool) {
+		const size_t components = field.empty() ? 0 : field.front().size();
+		Accumulator result(components);
+		std::mutex mutex;
+		fedes::ParallelFor(pool, 0, field.size(),
+			[&](const uint32_t& a, const uint32_t& b)
+			{
+				Accumulator chunk(components);
+				for (uint32_t i = a; i < b; i++) {
+					const std::vector<double>& value = field[i];
+					if (!std::all_of(value.begin(), value.end(), [](double v) { return std::isfinite(v); })) {
+						++chunk.non_finite;
+						continue;
+					}
+					for (size_t c = 0; c < components; ++c) {
+						chunk.Add(c, value[c]);
+					}
+					++chunk.count;
+				}
+				std::scoped_lock lock(mutex);
+				result.Merge(chunk);
+			}).wait();
+		return result.Statistics(name);
+	}
+
+	FieldStatistics ParallelFieldStatistics(const std::string& name, const std::vector<double>& field, BS::thread_pool& pool) {
+		Accumulator result(1);
+		std::mutex mutex;
+		fedes::ParallelFor(pool, 0, field.size(),
+			[&](const uint32_t& a, const uint32_t& b)
+			{
+				Accumulator chunk(1);
+				for (uint32_t i = a; i < b; i++) {
+					if (!std::isfinite(field[i])) {
+						++chunk.non_finite;
+						continue;
+					}
+					chunk.Add(0, field[i]);
+					++chunk.count;
+				}
+				std::scoped_lock lock(mutex);
+				result.Merge(chunk);
+			}).wait();
+		return result.Statistics(name);
+	}
+
+	/*
+	 * @brief Statistics of every non-empty FE field of the model
+	 */
+	std::vector<FieldStatistics> ParallelModelStatistics(const fedes::Model& model, BS::thread_pool& pool) {
+		std::vector<FieldStatistics> statistics;
+		if (!model.displacement.empty()) {
+			statistics.push_back(ParallelFieldStatistics("displacement", model.displacement, pool));
+		}
+		if (!model.stress.empty()) {
+			statistics.push_back(ParallelFieldStatistics("stress", model.stress, pool));
+		}
+		if (!model.total_strain.empty()) {
+			statistics.push_back(ParallelFieldStatistics("total strain", model.total_strain, pool));
+		}
+		if (!model.plastic_strain.empty()) {
+			statistics.push_back(ParallelFieldStatistics("plastic strain", model.plastic_strain, pool));
+		}
+		if (!model.accumulated_strain.empty()) {
+			statistics.push_back(ParallelFieldStatistics("accumulated strain", model.accumulated_strain, pool));
+		}
+		return statistics;
+	}
+
+	/*
+	 * @brief Histogram of the values over [min, max], all values fall into the one bin if they are equal
+	 */
+	Histogram MakeHistogram(std::span<const double> values, size_t bins, BS::thread_pool& pool) {
+		Histogram histogram;
+		if (values.empty() || bins == 0) {
+			return histogram;
+		}
+		const auto [min, max] = std::minmax_element(values.begin(), values.end());
+		histogram.lower = *min;
+		histogram.upper = *max;
+		histogram.counts.assign(bins, 0);
+		const double width = (histogram.upper - histogram.lower) / bins;
+
+		std::mutex mutex;
+		fedes::ParallelFor(pool, 0, values.size(),
+			[&](const uint32_t& a, const uint32_t& b)
+			{
+				std::vector<size_t> chunk(bins, 0);
+				for (uint32_t i = a; i < b; i++) {
+					const size_t bin = width > 0 ? static_cast<size_t>((values[i] - histogram.lower) / width) : 0;
+					++chunk[std::min(bin, bins - 1)];
+				}
+				std::scoped_lock lock(mutex);
+				for (size_t bin = 0; bin < bins; ++bin) {
+					histogram.counts[bin] += chunk[bin];
+				}
+			}).wait();
+		return histogram;
+	}
+
+	/*
+	 * @brief Error of the actual field against the expected one, both with the same number of values and components
+	 */
+	FieldError ParallelFieldError(const std::string& name, const std::vector<std::vector<double>>& expected,
+		                          const std::vector<std::vector<double>>& actual, BS::thread_pool& pool) {
+		ErrorAccumulator result;
+		std::mutex mutex;
+		fedes::ParallelFor(pool, 0, std::min(expected.size(), actual.size()),
+			[&](const uint32_t& a, const uint32_t& b)
+			{
+				ErrorAccumulator chunk;
+				for (uint32_t i = a; i < b; i++) {
+					for (size_t c = 0; c < expected[i].size(); ++c) {
+						chunk.Add(expected[i][c], actual[i][c]);
+					}
+				}
+				std::scoped_lock lock(mutex);
+				result.Merge(chunk);
+			}).wait();
+		return result.Error(name);
+	}
+
+	FieldError ParallelFieldError(const std::string& name, const std::vector<double>& expected, const std::vector<double>& actual,
+		                          BS::thread_pool& pool) {
+		ErrorAccumulator result;
+		std::mutex mutex;
+		fedes::ParallelFor(pool, 0, std::min(expected.size(), actual.size()),
+			[&](const uint32_t& a, const uint32_t& b)
+			{
+				ErrorAccumulator chunk;
+				for (uint32_t i = a; i < b; i++) {
+					chunk.Add(expected[i], actual[i]);
+				}
+				std::scoped_lock lock(mutex);
+				result.Merge(chunk);
+			}).wait();
+		return result.Error(name);
+	}
+
+	void Histogram::Write(std::ostream& output_stream) const {
+		const double width = counts.empty() ? 0.0 : (upper - lower) / counts.size();
+		for (size_t bin = 0; bin < counts.size(); ++bin) {
+			output_stream << "    [" << std::setw(12) << lower + bin * width << ", " << std::setw(12) << lower + (bin + 1) * width
+				<< (bin + 1 == counts.size() ? "] " : ") ") << counts[bin] << '\n';
+		}
+	}
+
+	void MappingQuality::Write(std::ostream& output_stream) const {
+		output_stream << "Mapping quality\n";
+		for (const FieldStatistics& field : fields) {
+			output_stream << "  " << field.name << ": " << field.count << " values";
+			if (field.non_finite != 0) {
+				output_stream << ", " << field.non_finite << " non-finite";
+			}
+			output_stream << '\n';
+			WriteComponents(output_stream, "min", field.min);
+			WriteComponents(output_stream, "max", field.max);
+			WriteComponents(output_stream, "mean", field.mean);
+			WriteComponents(output_stream, "L2", field.l2);
+		}
+		WritePoints(output_stream, "  Target nodes", nodes);
+		WritePoints(output_stream, "  Target integration points", integration);
+		for (const FieldError& error : round_trip) {
+			output_stream << "  Round-trip " << error.name << ": max " << error.max << ", RMS " << error.rms << ", relative L2 "
+				<< error.relative_l2 << '\n';
+		}
+		output_stream.flush();
+	}
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/indexing/octree/octree.h"
+#include "fedes/model/model.h"
+#include "fedes/maths/vector3.h"
+#include "fedes/maths/geometry.h"
+#include "fedes/common/scheduling.h"
+
+namespace fedes {
+
+	/*
+	 * @brief Per component min, max, mean and L2 norm of a field, e.g. stress has 6 components, accumulated strain 1
+	 */
+	struct FieldStatistics {
+	public:
+		std::string name;
+		size_t count = 0;
+		size_t non_finite = 0; // @brief: NaN/inf values, which are excluded from the statistics
+		std::vector<double> min;
+		std::vector<double> max;
+		std::vector<double> mean;
+		std::vector<double> l2;
+	};
+
+	/*
+	 * @brief Equal width bins over [lower, upper], the last bin includes upper
+	 */
+	struct Histogram {
+	public:
+		double lower = 0;
+		double upper = 0;
+		std::vector<size_t> counts;
+
+		void Write(std::ostream& output_stream = std::cout) const;
+	};
+
+	/*
+	 * @brief How well every target point (node or integration point) is covered by the source
+	 */
+	struct PointQuality {
+	public:
+		size_t count = 0;
+		Histogram distance; // @brief: distance of every target point to its nearest source node
+		double max_distance = 0;
+		double mean_distance = 0;
+		// Element indexes only, see MuesfData
+		size_t relaxed = 0;
+		size_t projected = 0;
+		Histogram relaxation; // @brief: how far the containment bounds were relaxed, for relaxed/projected points only
+	};
+
+	/*
+	 * @brief Mapping error of a field after mapping it to the target and back again onto the source
+	 */
+	struct FieldError {
+	public:
+		std::string name;
+		double max = 0;
+		double rms = 0;
+		double relative_l2 = 0; // @brief: ||mapped back - source|| / ||source||
+	};
+
+	struct MappingQuality {
+	public:
+		std::vector<FieldStatistics> fields;
+		PointQuality nodes;
+		PointQuality integration;
+		std::vector<FieldError> round_trip;
+
+		void Write(std::ostream& output_stream = std::cout) const;
+	};
+
+	FieldStatistics ParallelFieldStatistics(const std::string& name, const std::vector<std::vector<double>>& field, BS::thread_pool& pool);
+	FieldStatistics ParallelFieldStatistics(const std::string& name, const std::vector<double>& field, BS::thread_pool& pool);
+	std::vector<FieldStatistics> ParallelModelStatistics(const fedes::Model& model, BS::thread_pool& pool);
+	Histogram MakeHistogram(std::span<const double> values, size_t bins, BS::thread_pool& pool);
+	FieldError ParallelFieldError(const std::string& name, const std::vector<std::vector<double>>& expected,
+		                          const std::vector<std::vector<double>>& actual, BS::thread_pool& pool);
+	FieldError ParallelFieldError(const std::string& name, const std::vector<double>& expected, const std::vector<double>& actual,
+		                          BS::thread_pool& pool);
+
+	/*
+	 * @brief Distance of every point to its nearest source node and, for element indexes, the number of points that are only
+	 * contained after relaxing the containment bounds or lie outside of the source entirely, i.e. extrapolated. This repeats
+	 * the search of the mapping, NPM costs for node indexes and MUESF costs for element indexes.
+	 * @param octree: Octree Index the mapping used, node or element index
+	 * @param points: target nodes or integration points
+	 * @param bins: number of histogram bins
+	 * @param max_leaf_scans_threshold: as for ParallelElementShapeFunction
+	 */
+	template <std::floating_point T>
+	PointQuality ParallelPointQuality(const fedes::Octree<T>& octree, const std::vector<fedes::Vector3<T>>& points, BS::thread_pool& pool,
+		                              size_t bins = 16, size_t max_leaf_scans_threshold = 1000) {
+		PointQuality quality;
+		quality.count = points.size();
+		if (points.empty()) {
+			return quality;
+		}
+		const bool element_index = !octree.node_elements().empty();
+		std::vector<double> distances(points.size());
+		std::vector<double> relaxations(element_index ? points.size() : 0);
+		std::mutex mutex;
+		double distance_total = 0;
+
+		fedes::ParallelFor(pool, 0, points.size(),
+			[&](const uint32_t& a, const uint32_t& b)
+			{
+				std::vector<std::pair<size_t, T>> nearest;
+				double chunk_distance = 0;
+				size_t chunk_relaxed = 0, chunk_projected = 0;
+				for (uint32_t i = a; i < b; i++) {
+					octree.KNearest(points[i], 1, nearest);
+					distances[i] = nearest.front().second;
+					chunk_distance += distances[i];
+					if (element_index) {
+						const MuesfData data = octree.MUESF(points[i], max_leaf_scans_threshold).second;
+						relaxations[i] = data.relaxation;
+						chunk_projected += data.projected;
+						chunk_relaxed += !data.projected && data.relaxation > 0;
+					}
+				}
+				std::scoped_lock lock(mutex);
+				distance_total += chunk_distance;
+				quality.relaxed += chunk_relaxed;
+				quality.projected += chunk_projected;
+			}).wait();
+
+		quality.mean_distance = distance_total / points.size();
+		quality.max_distance = *std::max_element(distances.begin(), distances.end());
+		quality.distance = MakeHistogram(distances, bins, pool);
+		if (element_index) {
+			std::erase(relaxations, 0.0);
+			quality.relaxation = MakeHistogram(relaxations, bins, pool);
+		}
+		return quality;
+	}
+
+	/*
+	 * @brief Statistics of every mapped target field and the coverage of the target nodes/integration points by the source,
+	 * replacing a visual check of the exported VTU files
+	 * @param octree: Octree Index the mapping used, node or element index
+	 */
+	template <std::floating_point T>
+	MappingQuality ParallelMappingQuality(const fedes::Octree<T>& octree, const fedes::Model& source, const fedes::Model& target,
+		                                  BS::thread_pool& pool, size_t bins = 16, size_t max_leaf_scans_threshold = 1000) {
+		MappingQuality quality;
+		quality.fields = ParallelModelStatistics(target, pool);
+		if (source.ByNode()) {
+			quality.nodes = ParallelPointQuality(octree, target.nodes, pool, bins, max_leaf_scans_threshold);
+		}
+		if (source.ByIntegration()) {
+			quality.integration = ParallelPointQuality(octree, target.integration, pool, bins, max_leaf_scans_threshold);
+		}
+		return quality;
+	}
+
+	/*
+	 * @brief Round-trip error: the mapped target fields are mapped back onto the source nodes, by the given point based
+	 * interpolation, and compared with the original source fields. Nodal fields are mapped back from the target nodes, integration
+	 * point fields from the target integration points.
+	 * @param mapping: called as mapping(octree, source, target) with a node index over the source, e.g. a lambda calling
+	 * ParallelInverseDistanceWeighting
+	 * @param max_depth, leaf_split_threshold: of the node indexes built over the target nodes/integration points
+	 */
+	template <typename Mapping>
+	std::vector<FieldError> ParallelRoundTripError(const fedes::Model& source, const fedes::Model& target, BS::thread_pool& pool,
+		                                           Mapping&& mapping, size_t max_depth = 10, size_t leaf_split_threshold = 64) {
+		std::vector<FieldError> errors;
+		auto shape_like = [](const std::vector<std::vector<double>>& field, std::vector<std::vector<double>>& result) {
+			if (!field.empty()) {
+				result.assign(field.size(), std::vector<double>(field.front().size(), 0.0));
+			}
+		};
+
+		if (source.ByNode() && !target.nodes.empty()) {
+			fedes::Model back_source, back_target;
+			back_source.nodes = target.nodes;
+			back_source.displacement = target.displacement;
+			back_target.nodes = source.nodes;
+			shape_like(source.displacement, back_target.displacement);
+
+			std::span<fedes::Vector3<double>> points(back_source.nodes);
+			fedes::Octree<double> octree(points, max_depth, leaf_split_threshold, &pool);
+			mapping(octree, back_source, back_target);
+			errors.push_back(ParallelFieldError("displacement", source.displacement, back_target.displacement, pool));
+		}
+
+		if (source.ByIntegration() && !target.integration.empty()) {
+			fedes::Model back_source, back_target;
+			back_source.nodes = target.integration;
+			back_source.stress = target.stress;
+			back_source.total_strain = target.total_strain;
+			back_source.plastic_strain = target.plastic_strain;
+			back_source.accumulated_strain = target.accumulated_strain;
+			back_target.integration = source.nodes;
+			shape_like(source.stress, back_target.stress);
+			shape_like(source.total_strain, back_target.total_strain);
+			shape_like(source.plastic_strain, back_target.plastic_strain);
+			back_target.accumulated_strain.resize(source.accumulated_strain.size());
+
+			std::span<fedes::Vector3<double>> points(back_source.nodes);
+			fedes::Octree<double> octree(points, max_depth, leaf_split_threshold, &pool);
+			mapping(octree, back_source, back_target);
+			if (!source.stress.empty()) {
+				errors.push_back(ParallelFieldError("stress", source.stress, back_target.stress, pool));
+			}
+			if (!source.total_strain.empty()) {
+				errors.push_back(ParallelFieldError("total strain", source.total_strain, back_target.total_strain, pool));
+			}
+			if (!source.plastic_strain.empty()) {
+				errors.push_back(ParallelFieldError("plastic strain", source.plastic_strain, back_target.plastic_strain, pool));
+			}
+			if (!source.accumulated_strain.empty()) {
+				errors.push_back(ParallelFieldError("accumulated strain", source.accumulated_strain, back_target.accumulated_strain, pool));
+			}
+		}
+		return errors;
+	}
+}
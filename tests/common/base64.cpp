@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "fedes/common/base64.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+	std::string Decode(const std::string& text) {
+		std::vector<char> bytes(fedes::Base64DecodedSize(text));
+		bytes.resize(fedes::Base64Decode(text, bytes.data()));
+		return std::string(bytes.begin(), bytes.end());
+	}
+}
+
+TEST(Base64, Encode) {
+	EXPECT_EQ(fedes::Base64Encode(""), "");
+	EXPECT_EQ(fedes::Base64Encode("f"), "Zg==");
+	EXPECT_EQ(fedes::Base64Encode("fo"), "Zm8=");
+	EXPECT_EQ(fedes::Base64Encode("foo"), "Zm9v");
+	EXPECT_EQ(fedes::Base64Encode("foobar"), "Zm9vYmFy");
+}
+
+TEST(Base64, Decode) {
+	EXPECT_EQ(Decode(""), "");
+	EXPECT_EQ(Decode("Zg=="), "f");
+	EXPECT_EQ(Decode("Zm8="), "fo");
+	EXPECT_EQ(Decode("Zm9vYmFy"), "foobar");
+	EXPECT_EQ(Decode("  Zm9v\r\n  Ym\nFy \n"), "foobar") << "Expected blanks and line breaks to be skipped";
+	EXPECT_EQ(Decode("Zg==Zm8=Zm9v"), "ffofoo") << "Expected concatenated encodings to be decoded in turn";
+}
+
+TEST(Base64, RoundTrip) {
+	std::string bytes;
+	for (int i = 0; i < 1000; ++i) {
+		bytes += static_cast<char>(i * 37 % 256);
+	}
+	for (size_t size : { 998, 999, 1000 }) {
+		EXPECT_EQ(Decode(fedes::Base64Encode(bytes.substr(0, size))), bytes.substr(0, size));
+	}
+}
+
+TEST(Base64, Invalid) {
+	std::vector<char> bytes(16);
+	EXPECT_THROW(fedes::Base64Decode("Zm9*", bytes.data()), std::invalid_argument);
+	EXPECT_THROW(fedes::Base64Decode("Zm9", bytes.data()), std::invalid_argument);
+	EXPECT_THROW(fedes::Base64Decode("Z===", bytes.data()), std::invalid_argument);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "fedes/common/scheduling.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+TEST(Scheduling, VisitsEveryIndexOnce) {
+	BS::thread_pool pool(4);
+	for (size_t grain : { 0, 1, 7, 1000, 5000 }) {
+		std::vector<std::atomic<int>> visits(2503);
+		fedes::ParallelFor(pool, 0, visits.size(),
+			[&](const size_t a, const size_t b)
+			{
+				for (size_t i = a; i < b; ++i) {
+					visits[i]++;
+				}
+			}, grain).wait();
+
+		for (const auto& v : visits) {
+			ASSERT_EQ(v.load(), 1);
+		}
+	}
+}
+
+TEST(Scheduling, Offset) {
+	BS::thread_pool pool(2);
+	std::atomic<size_t> sum = 0;
+	fedes::ParallelFor(pool, 10, 20,
+		[&](const uint32_t& a, const uint32_t& b)
+		{
+			for (uint32_t i = a; i < b; ++i) {
+				sum += i;
+			}
+		}, 3).wait();
+	ASSERT_EQ(sum.load(), 145);
+}
+
+TEST(Scheduling, EmptyRange) {
+	BS::thread_pool pool(2);
+	bool called = false;
+	fedes::ParallelFor(pool, 5, 5, [&](const size_t, const size_t) { called = true; }).wait();
+	ASSERT_FALSE(called);
+}
+
+TEST(Scheduling, PropagatesExceptions) {
+	BS::thread_pool pool(2);
+	BS::multi_future<void> futures = fedes::ParallelFor(pool, 0, 100,
+		[&](const size_t a, const size_t b)
+		{
+			if (a <= 50 && 50 < b) {
+				throw std::runtime_error("chunk failure");
+			}
+		}, 10);
+	ASSERT_THROW(futures.get(), std::runtime_error);
+}
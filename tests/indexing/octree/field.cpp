@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "fedes/indexing/octree/traversals.h"
 
+#include <cmath>
+#include <span>
 #include <vector>
 
 #include "fedes/indexing/octree/octree.h"
@@ -22,28 +24,78 @@ class OctreeFieldTest : public ::testing::Test {
 protected:
 	std::unique_ptr<fedes::Octree<double>> octree_;
 	std::vector<fedes::Vector3<double>> points_;
+	std::span<fedes::Vector3<double>> span_;
 
 	void SetUp() override {
 		points_ = fedes::GenerateRandomArray<double>(-1.00, 1.00, 48);
 		points_.emplace_back(-1.00, -1.00, -1.00);
 		points_.emplace_back(1.00, 1.00, 1.00);
-		octree_ = std::make_unique<fedes::Octree<double>>(points_, 10, 0);
+		span_ = points_;
+		octree_ = std::make_unique<fedes::Octree<double>>(span_, 10, 0);
 	};
 
-	fedes::Vector3<double> BestForDir(uint_fast8_t dir) {
+	/*
+	 * @brief Brute force nearest point in the given direction of the query, as (index, distance)
+	 */
+	std::pair<size_t, double> BestForDir(uint_fast8_t dir, const fedes::Vector3<double>& query = fedes::Vector3<double>(0.0, 0.0, 0.0)) {
+		std::pair<size_t, double> best;
 		double best_dist = std::numeric_limits<double>::max();
-		for (const auto& p : points_) {
-			if (fedes::DetermineDirection(fedes::Vector3<double>(0.0, 0.0, 0.0), p) == dir) {
-				double current_dist = fedes::DistanceSquared(p, fedes::Vector3<double>(0.0, 0.0, 0.0));
+		for (size_t i = 0; i < points_.size(); ++i) {
+			if (fedes::DetermineDirection(query, points_[i]) == dir) {
+				double current_dist = fedes::DistanceSquared(points_[i], query);
 				if (current_dist < best_dist) {
 					best_dist = current_dist;
+					best = { i, std::sqrt(current_dist) };
 				}
 			}
 		}
+		return best;
 	}
 };
 
 
 TEST_F(OctreeFieldTest, Direction2) {
 	
-}
\ No newline at end of file
+}
+
+TEST_F(OctreeFieldTest, Directional) {
+	std::vector<fedes::Vector3<double>> queries = fedes::GenerateRandomArray<double>(-1.20, 1.20, 40);
+	queries.emplace_back(0.0, 0.0, 0.0);
+	queries.emplace_back(1.5, 1.5, 1.5);
+
+	for (const auto& query : queries) {
+		std::array<std::pair<size_t, double>, 8> field = octree_->FieldOfPoints(query);
+		for (uint_fast8_t dir = 0; dir < 8; ++dir) {
+			std::pair<size_t, double> expected = BestForDir(dir, query);
+			ASSERT_EQ(field[dir].first, expected.first);
+			ASSERT_DOUBLE_EQ(field[dir].second, expected.second);
+		}
+	}
+}
+
+TEST_F(OctreeFieldTest, DirectionalMatchesRadius) {
+	fedes::Vector3<double> query(0.1, -0.2, 0.3);
+	std::array<std::pair<size_t, double>, 8> directional = octree_->FieldOfPoints(query);
+	std::array<std::pair<size_t, double>, 8> radius = octree_->FieldOfPoints(query, 10.0);
+	for (uint_fast8_t dir = 0; dir < 8; ++dir) {
+		ASSERT_EQ(directional[dir].first, radius[dir].first);
+		ASSERT_NEAR(directional[dir].second, radius[dir].second, 1e-6);
+	}
+}
+
+TEST_F(OctreeFieldTest, Adaptive) {
+	std::vector<fedes::Vector3<double>> queries = fedes::GenerateRandomArray<double>(-1.20, 1.20, 40);
+	queries.emplace_back(0.0, 0.0, 0.0);
+	queries.emplace_back(3.0, -2.0, 1.5);
+
+	for (size_t k : { 1, 4, 100 }) {
+		for (const auto& query : queries) {
+			std::array<std::pair<size_t, double>, 8> field = octree_->AdaptiveFieldOfPoints(query, k, 1.5);
+			for (uint_fast8_t dir = 0; dir < 8; ++dir) {
+				std::pair<size_t, double> expected = BestForDir(dir, query);
+				ASSERT_EQ(field[dir].first, expected.first);
+				ASSERT_DOUBLE_EQ(field[dir].second, expected.second);
+			}
+		}
+	}
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "fedes/indexing/octree/octree.h"
+
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/maths/vector3.h"
+#include "fedes/maths/geometry.h"
+#include "fedes/maths/isoparametric.h"
+
+class OctreeMUESF : public ::testing::Test {
+protected:
+	static constexpr size_t n = 6; // @brief: hexahedra per axis
+	std::vector<fedes::Vector3<double>> nodes_;
+	std::vector<std::vector<size_t>> elements_;
+	std::vector<fedes::Vector3<double>> queries_;
+
+	void SetUp() override {
+		auto id = [](size_t i, size_t j, size_t k) { return (k * (n + 1) + j) * (n + 1) + i; };
+		for (size_t k = 0; k <= n; ++k) {
+			for (size_t j = 0; j <= n; ++j) {
+				for (size_t i = 0; i <= n; ++i) {
+					nodes_.emplace_back(static_cast<double>(i), static_cast<double>(j), static_cast<double>(k));
+				}
+			}
+		}
+		for (size_t k = 0; k < n; ++k) {
+			for (size_t j = 0; j < n; ++j) {
+				for (size_t i = 0; i < n; ++i) {
+					elements_.push_back({ id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k), id(i, j + 1, k),
+						id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1), id(i, j + 1, k + 1) });
+					queries_.emplace_back(i + 0.3, j + 0.6, k + 0.45);
+				}
+			}
+		}
+	}
+};
+
+TEST_F(OctreeMUESF, CachedMatchesUncached) {
+	std::span<fedes::Vector3<double>> points(nodes_);
+	fedes::Octree<double> cached(points, elements_, 10, 8);
+	fedes::Octree<double> uncached(points, elements_, 10, 8, std::nullopt, false);
+	ASSERT_FALSE(cached.element_cache().empty());
+	ASSERT_TRUE(uncached.element_cache().empty());
+
+	for (size_t q = 0; q < queries_.size(); ++q) {
+		auto [element, local] = cached.MUESF(queries_[q], 1000);
+		auto [expected_element, expected_local] = uncached.MUESF(queries_[q], 1000);
+		EXPECT_EQ(element, q);
+		EXPECT_EQ(element, expected_element);
+		EXPECT_NEAR(local.g, expected_local.g, 1e-12);
+		EXPECT_NEAR(local.h, expected_local.h, 1e-12);
+		EXPECT_NEAR(local.r, expected_local.r, 1e-12);
+	}
+}
+
+TEST_F(OctreeMUESF, ParallelCachedMatchesSerial) {
+	BS::thread_pool pool;
+	std::span<fedes::Vector3<double>> points(nodes_);
+	fedes::Octree<double> serial(points, elements_, 10, 8);
+	fedes::Octree<double> parallel(points, elements_, 10, 8, &pool);
+
+	for (size_t q = 0; q < queries_.size(); ++q) {
+		EXPECT_EQ(serial.MUESF(queries_[q], 1000).first, parallel.MUESF(queries_[q], 1000).first);
+	}
+}
+
+TEST_F(OctreeMUESF, DistortedHexahedra) {
+	// Perturb every interior node, so that no element remains affine
+	for (size_t p = 0; p < nodes_.size(); ++p) {
+		fedes::Vector3<double>& v = nodes_[p];
+		if (v.x > 0 && v.x < n && v.y > 0 && v.y < n && v.z > 0 && v.z < n) {
+			v += fedes::Vector3<double>(0.15 * std::sin(p * 1.3), 0.15 * std::cos(p * 0.7), 0.15 * std::sin(p * 2.1));
+		}
+	}
+	std::span<fedes::Vector3<double>> points(nodes_);
+	fedes::Octree<double> octree(points, elements_, 10, 8);
+
+	for (size_t e = 0; e < elements_.size(); ++e) {
+		const double g = 0.8, h = -0.85, r = 0.9;
+		auto shape = fedes::ShapeFunctions<fedes::ElementType::Hexahedron>::Values(g, h, r);
+		fedes::Vector3<double> query;
+		for (size_t i = 0; i < 8; ++i) {
+			query += nodes_[elements_[e][i]] * shape[i];
+		}
+
+		auto [element, local] = octree.MUESF(query, 1000);
+		EXPECT_EQ(element, e);
+		EXPECT_NEAR(local.g, g, 1e-8);
+		EXPECT_NEAR(local.h, h, 1e-8);
+		EXPECT_NEAR(local.r, r, 1e-8);
+	}
+}
+
+TEST_F(OctreeMUESF, Relaxation) {
+	std::span<fedes::Vector3<double>> points(nodes_);
+	fedes::Octree<double> cached(points, elements_, 10, 8);
+	fedes::Octree<double> uncached(points, elements_, 10, 8, std::nullopt, false);
+
+	// Just outside of the corner element (0, 0, 0): g = -1.1, i.e. a relaxation of 0.09 beyond the base bounds
+	fedes::Vector3<double> query(-0.05, 0.5, 0.5);
+	for (const fedes::Octree<double>* octree : { &cached, &uncached }) {
+		auto [element, local] = octree->MUESF(query, 1000);
+		EXPECT_EQ(element, 0);
+		EXPECT_FALSE(local.projected);
+		EXPECT_NEAR(local.relaxation, 0.09, 1e-12);
+		EXPECT_NEAR(local.g, -1.1, 1e-12);
+	}
+}
+
+TEST_F(OctreeMUESF, OutsideProjection) {
+	std::span<fedes::Vector3<double>> points(nodes_);
+	fedes::Octree<double> cached(points, elements_, 10, 8);
+	fedes::Octree<double> uncached(points, elements_, 10, 8, std::nullopt, false);
+
+	// Far beyond the last element along x, at the height of element (n - 1, 0, 0)
+	fedes::Vector3<double> query(n + 4.0, 0.5, 0.25);
+	for (const fedes::Octree<double>* octree : { &cached, &uncached }) {
+		auto [element, local] = octree->MUESF(query, 1000);
+		EXPECT_EQ(element, n - 1);
+		EXPECT_TRUE(local.projected);
+		EXPECT_GT(local.relaxation, 0.25);
+		EXPECT_DOUBLE_EQ(local.g, 1.0);
+		EXPECT_NEAR(local.h, 0.0, 1e-12);
+		EXPECT_NEAR(local.r, -0.5, 1e-12);
+	}
+}
+
+
+TEST_F(OctreeMUESF, Hint) {
+	std::span<fedes::Vector3<double>> points(nodes_);
+	fedes::Octree<double> octree(points, elements_, 10, 8);
+
+	for (size_t q = 0; q < queries_.size(); ++q) {
+		// The containing element as hint, a wrong one and none all find the same element
+		for (std::optional<size_t> hint : { std::optional<size_t>(q), std::optional<size_t>((q + 7) % elements_.size()),
+			                                std::optional<size_t>(elements_.size()), std::optional<size_t>() }) {
+			auto [element, local] = octree.MUESF(queries_[q], 1000, 0.25, hint);
+			EXPECT_EQ(element, q);
+			EXPECT_NEAR(local.g, -0.4, 1e-12);
+			EXPECT_NEAR(local.h, 0.2, 1e-12);
+			EXPECT_NEAR(local.r, -0.1, 1e-12);
+		}
+	}
+}
@@ -4,8 +4,14 @@
 #include <memory>
 #include <array>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <vector>
 
 #include "fedes/maths/vector3.h"
+#include "fedes/maths/distance.h"
+#include "fedes/maths/random.h"
 
 
 class OctreeNearestSearchTest : public ::testing::Test {
@@ -33,4 +39,44 @@ TEST_F(OctreeNearestSearchTest, DISABLED_Nearest) {
 	fedes::Vector3<double> p2(-0.9, -0.82, -0.5);
 	size_t n2 = octree_->Nearest(p2);
 	ASSERT_EQ(n2, 0);
+}
+
+TEST(OctreeKNearestSearch, MatchesBruteForce) {
+	std::vector<fedes::Vector3<double>> points = fedes::GenerateRandomArray<double>(-1.0, 1.0, 500);
+	std::span<fedes::Vector3<double>> span(points);
+	fedes::Octree<double> octree(span, 10, 4);
+	std::vector<fedes::Vector3<double>> queries = fedes::GenerateRandomArray<double>(-1.5, 1.5, 50);
+
+	std::vector<std::pair<size_t, double>> results;
+	for (size_t k : { 1, 5, 32 }) {
+		for (const fedes::Vector3<double>& query : queries) {
+			std::vector<double> distances;
+			for (const fedes::Vector3<double>& p : points) {
+				distances.push_back(std::sqrt(fedes::DistanceSquared(query, p)));
+			}
+			std::sort(distances.begin(), distances.end());
+
+			octree.KNearest(query, k, results);
+			ASSERT_EQ(results.size(), k);
+			for (size_t i = 0; i < k; ++i) {
+				ASSERT_DOUBLE_EQ(results[i].second, distances[i]) << "Expected the " << i << "th nearest point, k = " << k;
+				ASSERT_DOUBLE_EQ(results[i].second, std::sqrt(fedes::DistanceSquared(query, points[results[i].first])));
+			}
+			ASSERT_EQ(results.front().first, octree.Nearest(query));
+		}
+	}
+}
+
+TEST(OctreeKNearestSearch, FewerPointsThanK) {
+	std::vector<fedes::Vector3<double>> points = fedes::GenerateRandomArray<double>(-1.0, 1.0, 6);
+	std::span<fedes::Vector3<double>> span(points);
+	fedes::Octree<double> octree(span, 10, 1);
+
+	std::vector<std::pair<size_t, double>> results;
+	octree.KNearest(fedes::Vector3<double>(0.0), 10, results);
+	ASSERT_EQ(results.size(), points.size());
+	ASSERT_TRUE(std::is_sorted(results.begin(), results.end(), [](const auto& a, const auto& b) { return a.second < b.second; }));
+
+	octree.KNearest(fedes::Vector3<double>(0.0), 0, results);
+	ASSERT_TRUE(results.empty());
 }
\ No newline at end of file
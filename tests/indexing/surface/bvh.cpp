@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "fedes/indexing/surface/bvh.h"
+
+#include <cmath>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/indexing/surface/boundary.h"
+#include "fedes/indexing/octree/octree.h"
+#include "fedes/interpolations/octree/octree.h"
+#include "fedes/model/model.h"
+#include "fedes/maths/random.h"
+
+class SurfaceBVH : public ::testing::Test {
+protected:
+	static constexpr size_t n_ = 4;
+	fedes::Model source_;
+
+	// n^3 unit hexahedra over [0, n]^3 with a linear displacement field
+	void SetUp() override {
+		auto node = [&](size_t x, size_t y, size_t z) { return x + (n_ + 1) * (y + (n_ + 1) * z); };
+		for (size_t z = 0; z <= n_; ++z) {
+			for (size_t y = 0; y <= n_; ++y) {
+				for (size_t x = 0; x <= n_; ++x) {
+					source_.nodes.emplace_back(x, y, z);
+					source_.displacement.push_back({ double(x), double(y), double(z) });
+				}
+			}
+		}
+		for (size_t z = 0; z < n_; ++z) {
+			for (size_t y = 0; y < n_; ++y) {
+				for (size_t x = 0; x < n_; ++x) {
+					source_.elements.push_back({ node(x, y, z), node(x + 1, y, z), node(x + 1, y + 1, z), node(x, y + 1, z),
+						node(x, y, z + 1), node(x + 1, y, z + 1), node(x + 1, y + 1, z + 1), node(x, y + 1, z + 1) });
+				}
+			}
+		}
+	}
+};
+
+TEST_F(SurfaceBVH, HexahedronBoundaryFaces) {
+	const std::vector<fedes::BoundaryFace> faces = fedes::BoundaryFaces(source_.elements);
+	ASSERT_EQ(faces.size(), 6 * n_ * n_);
+	for (const fedes::BoundaryFace& face : faces) {
+		ASSERT_EQ(face.count, 4);
+		// Every node of a boundary face lies on one of the planes bounding the grid
+		bool on_plane[6] = { true, true, true, true, true, true };
+		for (size_t k = 0; k < 4; ++k) {
+			const fedes::Vector3<double>& p = source_.nodes[face.nodes[k]];
+			on_plane[0] &= p.x == 0; on_plane[1] &= p.x == n_;
+			on_plane[2] &= p.y == 0; on_plane[3] &= p.y == n_;
+			on_plane[4] &= p.z == 0; on_plane[5] &= p.z == n_;
+		}
+		EXPECT_TRUE(on_plane[0] || on_plane[1] || on_plane[2] || on_plane[3] || on_plane[4] || on_plane[5]);
+	}
+	EXPECT_EQ(fedes::BoundaryTriangles(source_.elements).size(), 2 * faces.size());
+}
+
+TEST(SurfaceBoundary, TetrahedraSharingAFace) {
+	const std::vector<std::vector<size_t>> elements = { { 0, 1, 2, 3 }, { 1, 2, 3, 4 } };
+	const std::vector<fedes::BoundaryFace> faces = fedes::BoundaryFaces(elements);
+	ASSERT_EQ(faces.size(), 6);
+	for (const fedes::BoundaryFace& face : faces) {
+		EXPECT_EQ(face.count, 3);
+		const bool shared = std::is_permutation(face.nodes.begin(), face.nodes.begin() + 3, std::vector<size_t>{ 1, 2, 3 }.begin());
+		EXPECT_FALSE(shared) << "Expected the shared face to be interior";
+	}
+}
+
+TEST_F(SurfaceBVH, ClosestMatchesBruteForce) {
+	const fedes::SurfaceBVH surface(source_.nodes, source_.elements, 2);
+	const std::vector<fedes::Vector3<double>> queries = fedes::GenerateRandomArray<double>(-3.0, 7.0, 500);
+	for (const fedes::Vector3<double>& query : queries) {
+		double expected = std::numeric_limits<double>::infinity();
+		for (const fedes::SurfaceTriangle& triangle : surface.triangles()) {
+			const fedes::Vector3<double> point = fedes::internal::ClosestPointOnTriangle(query, source_.nodes[triangle.nodes[0]],
+				source_.nodes[triangle.nodes[1]], source_.nodes[triangle.nodes[2]]);
+			const fedes::Vector3<double> d = point - query;
+			expected = std::min(expected, std::sqrt(fedes::internal::Dot(d, d)));
+		}
+		const fedes::SurfaceBVH::Hit hit = surface.Closest(query);
+		ASSERT_NEAR(hit.distance, expected, 1e-12) << "Query point " << query;
+	}
+}
+
+TEST_F(SurfaceBVH, InsideOutside) {
+	const fedes::SurfaceBVH surface(source_.nodes, source_.elements);
+	const std::vector<fedes::Vector3<double>> queries = fedes::GenerateRandomArray<double>(-2.0, 6.0, 2000);
+	for (const fedes::Vector3<double>& query : queries) {
+		const bool inside = query.x > 0 && query.x < n_ && query.y > 0 && query.y < n_ && query.z > 0 && query.z < n_;
+		ASSERT_EQ(surface.Inside(query), inside) << "Query point " << query;
+	}
+	// Grid nodes and points in the face planes are hit by rays through edges and vertices
+	EXPECT_TRUE(surface.Inside({ 2.0, 2.0, 2.0 }));
+	EXPECT_TRUE(surface.Inside({ 1.0, 3.0, 2.0 }));
+	EXPECT_FALSE(surface.Inside({ 2.0, 2.0, 5.0 }));
+
+	EXPECT_NEAR(surface.SignedDistance({ 2.0, 1.5, 2.0 }), -1.5, 1e-12);
+	EXPECT_NEAR(surface.SignedDistance({ 2.0, 2.0, 7.0 }), 3.0, 1e-12);
+}
+
+TEST_F(SurfaceBVH, ClosestElement) {
+	const fedes::SurfaceBVH surface(source_.nodes, source_.elements);
+	const fedes::SurfaceBVH::Hit hit = surface.Closest({ 10.0, 0.5, 0.5 });
+	EXPECT_NEAR(hit.distance, 6.0, 1e-12);
+	EXPECT_EQ(hit.element, n_ - 1) << "Expected the corner element at x = n - 1";
+	EXPECT_EQ(hit.point, fedes::Vector3<double>(4.0, 0.5, 0.5));
+}
+
+TEST_F(SurfaceBVH, OutsidePointsExtrapolated) {
+	BS::thread_pool pool(4);
+	std::span<fedes::Vector3<double>> span(source_.nodes);
+	fedes::Octree<double> octree(span, source_.elements, 10, 8);
+	const fedes::SurfaceBVH surface(source_.nodes, source_.elements);
+
+	fedes::Model target;
+	target.nodes = { { 1.25, 2.5, 3.75 }, { 10.0, 2.25, 1.75 }, { -1.0, -1.0, 2.5 } };
+	target.displacement.resize(target.nodes.size(), std::vector<double>(3));
+	fedes::ParallelElementShapeFunction(octree, source_, target, pool, 1000, fedes::TargetOrder::File, &surface);
+
+	const std::vector<fedes::Vector3<double>> expected = { { 1.25, 2.5, 3.75 }, { 4.0, 2.25, 1.75 }, { 0.0, 0.0, 2.5 } };
+	for (size_t i = 0; i < target.nodes.size(); ++i) {
+		for (size_t k = 0; k < 3; ++k) {
+			EXPECT_NEAR(target.displacement[i][k], (k == 0 ? expected[i].x : k == 1 ? expected[i].y : expected[i].z), 1e-9) << "Target node " << i;
+		}
+	}
+
+	fedes::Model dmue_target;
+	dmue_target.nodes = target.nodes;
+	dmue_target.displacement.resize(target.nodes.size(), std::vector<double>(3));
+	fedes::ParallelDMUE(octree, source_, dmue_target, pool, 50, fedes::TargetOrder::File, &surface);
+	for (size_t k = 0; k < 3; ++k) {
+		EXPECT_TRUE(std::isfinite(dmue_target.displacement[1][k]));
+	}
+	EXPECT_GT(dmue_target.displacement[1][0], 3.0) << "Expected the outside point to be weighted over an element at x = n";
+}
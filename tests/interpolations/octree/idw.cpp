@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "fedes/interpolations/octree/octree.h"
+
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/model/model.h"
+#include "fedes/indexing/octree/octree.h"
+#include "fedes/maths/random.h"
+
+class OctreeInterpolationsIDW : public ::testing::Test {
+protected:
+	fedes::Model source_, target_;
+	std::span<fedes::Vector3<double>> span_;
+	std::unique_ptr<fedes::Octree<double>> octree_;
+	BS::thread_pool pool_{ 4 };
+
+	void SetUp() override {
+		source_.nodes = fedes::GenerateRandomArray<double>(-1.0, 1.0, 1000);
+		for (const fedes::Vector3<double>& node : source_.nodes) {
+			source_.displacement.push_back({ node.x, node.y, node.z });
+			source_.stress.push_back({ 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 });
+			source_.accumulated_strain.push_back(0.5);
+		}
+		span_ = std::span<fedes::Vector3<double>>(source_.nodes);
+		octree_ = std::make_unique<fedes::Octree<double>>(span_, 10, 8);
+
+		target_.nodes = fedes::GenerateRandomArray<double>(-0.8, 0.9, 300);
+		target_.integration = target_.nodes;
+		target_.SetTargetIndexes(source_);
+		target_.stress.resize(target_.integration.size(), std::vector<double>(6));
+		target_.accumulated_strain.resize(target_.integration.size());
+	}
+};
+
+TEST_F(OctreeInterpolationsIDW, ConstantField) {
+	fedes::ParallelInverseDistanceWeighting<double>(*octree_, source_, target_, pool_, 8, 2.0);
+	for (size_t i = 0; i < target_.integration.size(); ++i) {
+		for (size_t k = 0; k < 6; ++k) {
+			ASSERT_NEAR(target_.stress[i][k], k + 1.0, 1e-12) << "Expected a constant field to be reproduced exactly";
+		}
+		ASSERT_NEAR(target_.accumulated_strain[i], 0.5, 1e-12);
+	}
+}
+
+TEST_F(OctreeInterpolationsIDW, LinearField) {
+	fedes::ParallelInverseDistanceWeighting<double>(*octree_, source_, target_, pool_, 8, 2.0, fedes::TargetOrder::Morton);
+	for (size_t i = 0; i < target_.nodes.size(); ++i) {
+		// The weights form a convex combination of nearby points, so the result stays close to the linear field
+		ASSERT_NEAR(target_.displacement[i][0], target_.nodes[i].x, 0.25);
+		ASSERT_NEAR(target_.displacement[i][1], target_.nodes[i].y, 0.25);
+		ASSERT_NEAR(target_.displacement[i][2], target_.nodes[i].z, 0.25);
+	}
+}
+
+TEST_F(OctreeInterpolationsIDW, CoincidentPoints) {
+	target_.nodes.assign(source_.nodes.begin(), source_.nodes.begin() + 100);
+	target_.displacement.assign(100, std::vector<double>(3));
+	fedes::ParallelInverseDistanceWeighting<double>(*octree_, source_, target_, pool_, 8, 2.0);
+	for (size_t i = 0; i < target_.nodes.size(); ++i) {
+		ASSERT_EQ(target_.displacement[i], source_.displacement[i]);
+	}
+}
+
+TEST_F(OctreeInterpolationsIDW, SingleNeighbourIsNearestPoint) {
+	fedes::Model nearest = target_;
+	fedes::ParallelInverseDistanceWeighting<double>(*octree_, source_, target_, pool_, 1, 2.0);
+	fedes::ParallelNearestPointMethod<double>(*octree_, source_, nearest, pool_);
+	ASSERT_EQ(target_.displacement, nearest.displacement);
+}
+
+TEST_F(OctreeInterpolationsIDW, SerialMatchesParallel) {
+	fedes::Model serial = target_;
+	fedes::ParallelInverseDistanceWeighting<double>(*octree_, source_, target_, pool_, 6, 3.0, fedes::TargetOrder::Morton);
+	fedes::InverseDistanceWeighting<double>(*octree_, source_, serial, 6, 3.0);
+	ASSERT_EQ(target_.displacement, serial.displacement);
+	ASSERT_EQ(target_.stress, serial.stress);
+
+	ASSERT_THROW(fedes::InverseDistanceWeighting<double>(*octree_, source_, serial, 0, 2.0), std::invalid_argument);
+}
\ No newline at end of file
@@ -2,12 +2,16 @@
 #include "fedes/interpolations/octree/octree.h"
 
 #include <memory>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
 
 #include "fedes/model/model.h"
 #include "fedes/model/writers.h"
 #include "fedes/model/parsers.h"
 #include "fedes/model/examples.h"
 #include "fedes/indexing/octree/octree.h"
+#include "fedes/maths/random.h"
 
 
 TEST(OctreeInterpolationsNPM, DISABLED_Model1) {
@@ -20,4 +24,26 @@ TEST(OctreeInterpolationsNPM, DISABLED_Model1) {
 	ASSERT_EQ(target.displacement[14], source.displacement[2015]);
 	ASSERT_EQ(target.displacement[25000], std::vector<double>({ 0.059610000000000003 , -0.028618000000000001,  0.44091999999999998 }));
 	ASSERT_EQ(target.stress[100000], std::vector<double>({ 144810000.00000000, 429390000.00000000, 77178000.000000000, -78032000.000000000, -89415000.000000000, -36849000.000000000 }));
+}
+
+TEST(OctreeInterpolationsNPM, MortonTargetOrder) {
+	fedes::Model source, target;
+	source.nodes = fedes::GenerateRandomArray<double>(-1.0, 1.0, 2000);
+	for (const fedes::Vector3<double>& node : source.nodes) {
+		source.displacement.push_back({ node.x, node.y, node.z });
+	}
+	target.nodes = fedes::GenerateRandomArray<double>(-0.9, 1.1, 1500);
+	target.SetTargetIndexes(source);
+	fedes::Model morton_target = target;
+
+	std::span<fedes::Vector3<double>> nodes(source.nodes);
+	fedes::Octree<double> octree(nodes, 10, 8);
+	BS::thread_pool pool(4);
+	fedes::ParallelNearestPointMethod<double>(octree, source, target, pool);
+	fedes::ParallelNearestPointMethod<double>(octree, source, morton_target, pool, fedes::TargetOrder::Morton);
+
+	ASSERT_EQ(target.displacement, morton_target.displacement);
+	for (size_t i = 0; i < target.nodes.size(); ++i) {
+		ASSERT_EQ(target.displacement[i], source.displacement[octree.Nearest(target.nodes[i])]);
+	}
 }
\ No newline at end of file
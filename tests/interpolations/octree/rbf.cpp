@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "fedes/interpolations/octree/octree.h"
+
+#include <cmath>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/model/model.h"
+#include "fedes/indexing/octree/octree.h"
+#include "fedes/maths/random.h"
+
+class OctreeInterpolationsRBF : public ::testing::Test {
+protected:
+	fedes::Model source_, target_;
+	std::span<fedes::Vector3<double>> span_;
+	std::unique_ptr<fedes::Octree<double>> octree_;
+	BS::thread_pool pool_{ 4 };
+
+	static std::vector<double> Field(const fedes::Vector3<double>& p) {
+		return { 2 * p.x - p.y + 0.5 * p.z + 1, p.x * p.x + p.y * p.z, std::sin(p.x) * std::cos(p.y) };
+	}
+
+	void SetUp() override {
+		source_.nodes = fedes::GenerateRandomArray<double>(-1.0, 1.0, 4000);
+		for (const fedes::Vector3<double>& node : source_.nodes) {
+			source_.displacement.push_back(Field(node));
+		}
+		span_ = std::span<fedes::Vector3<double>>(source_.nodes);
+		octree_ = std::make_unique<fedes::Octree<double>>(span_, 10, 8);
+
+		target_.nodes = fedes::GenerateRandomArray<double>(-0.7, 0.7, 500);
+		target_.SetTargetIndexes(source_);
+	}
+};
+
+TEST_F(OctreeInterpolationsRBF, LinearFieldIsExact) {
+	fedes::ParallelRadialBasisFunction<double>(*octree_, source_, target_, pool_, 16, fedes::TargetOrder::Morton);
+	for (size_t i = 0; i < target_.nodes.size(); ++i) {
+		ASSERT_NEAR(target_.displacement[i][0], Field(target_.nodes[i])[0], 1e-8) << "Expected a linear field to be reproduced";
+	}
+}
+
+TEST_F(OctreeInterpolationsRBF, MoreAccurateThanIDW) {
+	fedes::Model idw = target_;
+	fedes::ParallelRadialBasisFunction<double>(*octree_, source_, target_, pool_, 24);
+	fedes::ParallelInverseDistanceWeighting<double>(*octree_, source_, idw, pool_, 24, 2.0);
+
+	for (size_t c = 1; c < 3; ++c) {
+		double rbf_error = 0, idw_error = 0;
+		for (size_t i = 0; i < target_.nodes.size(); ++i) {
+			const double exact = Field(target_.nodes[i])[c];
+			rbf_error += std::abs(target_.displacement[i][c] - exact);
+			idw_error += std::abs(idw.displacement[i][c] - exact);
+		}
+		ASSERT_LT(rbf_error, 0.25 * idw_error) << "Expected a smooth field to be approximated more closely, component " << c;
+	}
+}
+
+TEST_F(OctreeInterpolationsRBF, Degenerate) {
+	// Coincident target points copy the source, coplanar neighbours fall back to inverse distance weights
+	target_.nodes.assign(source_.nodes.begin(), source_.nodes.begin() + 50);
+	target_.displacement.assign(50, std::vector<double>(3));
+	fedes::ParallelRadialBasisFunction<double>(*octree_, source_, target_, pool_, 16);
+	for (size_t i = 0; i < target_.nodes.size(); ++i) {
+		ASSERT_EQ(target_.displacement[i], source_.displacement[i]);
+	}
+
+	fedes::Model plane;
+	for (size_t x = 0; x < 10; ++x) {
+		for (size_t y = 0; y < 10; ++y) {
+			plane.nodes.emplace_back(x, y, 0.0);
+			plane.displacement.push_back({ 1.0, 2.0, 3.0 });
+		}
+	}
+	std::span<fedes::Vector3<double>> plane_span(plane.nodes);
+	fedes::Octree<double> plane_octree(plane_span, 10, 8);
+	fedes::Model plane_target;
+	plane_target.nodes = { { 4.5, 4.5, 0.0 }, { 2.2, 7.1, 0.0 } };
+	plane_target.SetTargetIndexes(plane);
+	fedes::RadialBasisFunction<double>(plane_octree, plane, plane_target, 16);
+	for (const std::vector<double>& value : plane_target.displacement) {
+		ASSERT_NEAR(value[0], 1.0, 1e-12);
+		ASSERT_NEAR(value[2], 3.0, 1e-12);
+	}
+}
+
+TEST_F(OctreeInterpolationsRBF, SerialMatchesParallel) {
+	fedes::Model serial = target_;
+	fedes::ParallelRadialBasisFunction<double>(*octree_, source_, target_, pool_, 20, fedes::TargetOrder::Morton);
+	fedes::RadialBasisFunction<double>(*octree_, source_, serial, 20);
+	ASSERT_EQ(target_.displacement, serial.displacement);
+}
\ No newline at end of file
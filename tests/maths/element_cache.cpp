@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "fedes/maths/element_cache.h"
+
+#include <vector>
+#include <span>
+#include <optional>
+
+#include "fedes/maths/vector3.h"
+#include "fedes/maths/geometry.h"
+#include "fedes/maths/element_type.h"
+
+class ElementCacheTest : public ::testing::Test {
+protected:
+	std::vector<fedes::Vector3<double>> nodes_;
+
+	void SetUp() override {
+		// Slightly distorted unit hexahedron, the first 4 nodes doubling up as a tetrahedron
+		nodes_.emplace_back(0.0, 0.0, 0.0);
+		nodes_.emplace_back(1.1, 0.0, 0.1);
+		nodes_.emplace_back(1.0, 1.0, 0.0);
+		nodes_.emplace_back(0.0, 0.9, 0.0);
+		nodes_.emplace_back(0.1, 0.0, 1.0);
+		nodes_.emplace_back(1.0, 0.1, 1.0);
+		nodes_.emplace_back(1.0, 1.0, 1.2);
+		nodes_.emplace_back(0.0, 1.0, 1.0);
+	}
+};
+
+TEST_F(ElementCacheTest, Tetrahedron) {
+	std::vector<size_t> element({0, 1, 3, 4});
+	fedes::Vector3<double> query(0.2, 0.2, 0.2);
+	fedes::ElementCache cache = fedes::CacheElement(nodes_, element, fedes::ElementType::Tetrahedron);
+
+	std::optional<fedes::MuesfData> expected = fedes::TetrahedronContainment(nodes_, element, query, -0.01, -0.01, -0.01, 1.01);
+	std::optional<fedes::MuesfData> got = fedes::TetrahedronContainment(cache, query, -0.01, -0.01, -0.01, 1.01);
+	ASSERT_TRUE(expected.has_value());
+	ASSERT_TRUE(got.has_value());
+	EXPECT_NEAR(got->g, expected->g, 1e-12);
+	EXPECT_NEAR(got->h, expected->h, 1e-12);
+	EXPECT_NEAR(got->r, expected->r, 1e-12);
+
+	fedes::Vector3<double> outside(2.0, 2.0, 2.0);
+	EXPECT_FALSE(fedes::TetrahedronContainment(cache, outside, -0.01, -0.01, -0.01, 1.01).has_value());
+}
+
+TEST_F(ElementCacheTest, Wedge) {
+	std::vector<size_t> element({0, 1, 3, 4, 5, 7});
+	fedes::Vector3<double> query(0.3, 0.3, 0.5);
+	fedes::ElementCache cache = fedes::CacheElement(nodes_, element, fedes::ElementType::Wedge);
+
+	std::optional<fedes::MuesfData> expected = fedes::WedgeContainment(nodes_, element, query, -5, -5, -5, 5, 5, 5);
+	fedes::MuesfData got = cache.LocalCoordinates(query);
+	ASSERT_TRUE(expected.has_value());
+	EXPECT_NEAR(got.g, expected->g, 1e-12);
+	EXPECT_NEAR(got.h, expected->h, 1e-12);
+	EXPECT_NEAR(got.r, expected->r, 1e-12);
+}
+
+TEST_F(ElementCacheTest, Hexahedron) {
+	std::vector<size_t> element({0, 1, 2, 3, 4, 5, 6, 7});
+	fedes::Vector3<double> query(0.4, 0.6, 0.5);
+	fedes::ElementCache cache = fedes::CacheElement(nodes_, element, fedes::ElementType::Hexahedron);
+
+	std::optional<fedes::MuesfData> expected = fedes::HexahedronContainment(nodes_, element, query, -1.01, -1.01, -1.01, 1.01, 1.01, 1.01);
+	std::optional<fedes::MuesfData> got = fedes::HexahedronContainment(cache, query, -1.01, -1.01, -1.01, 1.01, 1.01, 1.01);
+	ASSERT_TRUE(expected.has_value());
+	ASSERT_TRUE(got.has_value());
+	EXPECT_NEAR(got->g, expected->g, 1e-12);
+	EXPECT_NEAR(got->h, expected->h, 1e-12);
+	EXPECT_NEAR(got->r, expected->r, 1e-12);
+}
+
+TEST_F(ElementCacheTest, Block) {
+	std::vector<std::vector<size_t>> elements({ {0, 1, 3, 4}, {1, 2, 3, 6}, {4, 5, 7, 1}, {3, 6, 7, 4}, {1, 3, 4, 6} });
+	std::vector<fedes::ElementCache> cache;
+	std::vector<size_t> candidates;
+	for (size_t e = 0; e < elements.size(); ++e) {
+		cache.emplace_back(fedes::CacheElement(nodes_, elements[e], fedes::ElementType::Tetrahedron));
+		candidates.emplace_back(e);
+	}
+
+	std::vector<fedes::ElementBlock> blocks = fedes::PackElementBlocks(candidates, cache);
+	ASSERT_EQ(blocks.size(), 2);
+	ASSERT_EQ(blocks[0].count, 4);
+	ASSERT_EQ(blocks[1].count, 1);
+
+	constexpr double inf = std::numeric_limits<double>::infinity();
+	fedes::ContainmentBounds bounds{ {-0.01, -0.01, -0.01}, {inf, inf, inf}, 1.01 };
+	std::vector<fedes::Vector3<double>> queries({ {0.2, 0.2, 0.2}, {0.9, 0.8, 0.3}, {0.5, 0.5, 0.5}, {0.4, 0.5, 0.9}, {3.0, 3.0, 3.0} });
+	for (const auto& query : queries) {
+		for (size_t b = 0; b < blocks.size(); ++b) {
+			std::array<std::array<double, fedes::element_block_width>, 3> local;
+			uint_fast8_t mask = fedes::BlockContainment(blocks[b], query, bounds, local);
+			for (size_t lane = 0; lane < fedes::element_block_width; ++lane) {
+				size_t c = b * fedes::element_block_width + lane;
+				bool expected = c < candidates.size() && fedes::TetrahedronContainment(cache[c], query, -0.01, -0.01, -0.01, 1.01).has_value();
+				EXPECT_EQ(static_cast<bool>(mask & (1u << lane)), expected);
+			}
+		}
+	}
+}
+
+TEST(ElementCache, BoundsViolation) {
+	constexpr double inf = std::numeric_limits<double>::infinity();
+	fedes::ContainmentBounds tetrahedron{ {-0.01, -0.01, -0.01}, {inf, inf, inf}, 1.01 };
+	EXPECT_LT(fedes::BoundsViolation({ .g = 0.2, .h = 0.2, .r = 0.2 }, tetrahedron), 0.0);
+	EXPECT_NEAR(fedes::BoundsViolation({ .g = -0.11, .h = 0.2, .r = 0.2 }, tetrahedron), 0.1, 1e-12);
+	EXPECT_NEAR(fedes::BoundsViolation({ .g = 0.5, .h = 0.5, .r = 0.3 }, tetrahedron), 0.29, 1e-12);
+	EXPECT_LT(fedes::BoundsViolation({ .g = -0.11, .h = 0.2, .r = 0.2 }, fedes::Relax(tetrahedron, 0.15)), 0.0);
+
+	fedes::MuesfData projected = fedes::ProjectLocalCoordinates({ .g = -0.2, .h = 0.9, .r = 0.6 }, fedes::ElementType::Tetrahedron);
+	EXPECT_DOUBLE_EQ(projected.g, 0.0);
+	EXPECT_DOUBLE_EQ(projected.h + projected.r, 1.0);
+
+	projected = fedes::ProjectLocalCoordinates({ .g = 1.7, .h = -3.0, .r = 0.4 }, fedes::ElementType::Hexahedron);
+	EXPECT_DOUBLE_EQ(projected.g, 1.0);
+	EXPECT_DOUBLE_EQ(projected.h, -1.0);
+	EXPECT_DOUBLE_EQ(projected.r, 0.4);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "fedes/maths/isoparametric.h"
+
+#include <vector>
+#include <span>
+#include <optional>
+
+#include "fedes/maths/vector3.h"
+#include "fedes/maths/element_cache.h"
+#include "fedes/maths/element_type.h"
+
+template <fedes::ElementType E>
+static fedes::Vector3<double> ForwardMap(const std::vector<fedes::Vector3<double>>& nodes, const std::vector<size_t>& element, double g, double h, double r) {
+	auto n = fedes::ShapeFunctions<E>::Values(g, h, r);
+	fedes::Vector3<double> x;
+	for (size_t i = 0; i < n.size(); ++i) {
+		x += nodes[element[i]] * n[i];
+	}
+	return x;
+}
+
+class IsoparametricTest : public ::testing::Test {
+protected:
+	std::vector<fedes::Vector3<double>> nodes_;
+
+	void SetUp() override {
+		// Strongly distorted (non-affine) hexahedron
+		nodes_.emplace_back(0.0, 0.0, 0.0);
+		nodes_.emplace_back(2.0, 0.0, 0.3);
+		nodes_.emplace_back(1.6, 1.4, 0.0);
+		nodes_.emplace_back(0.0, 1.0, 0.0);
+		nodes_.emplace_back(0.2, 0.0, 1.0);
+		nodes_.emplace_back(1.0, 0.4, 1.3);
+		nodes_.emplace_back(1.5, 1.5, 2.0);
+		nodes_.emplace_back(-0.3, 1.1, 1.0);
+	}
+};
+
+TEST_F(IsoparametricTest, HexahedronRoundTrip) {
+	std::vector<size_t> element({0, 1, 2, 3, 4, 5, 6, 7});
+	std::span<fedes::Vector3<double>> points(nodes_);
+	fedes::ElementCache cache = fedes::CacheElement(points, element, fedes::ElementType::Hexahedron);
+
+	for (const auto& [g, h, r] : std::vector<std::array<double, 3>>({ {0.0, 0.0, 0.0}, {0.5, -0.7, 0.2}, {-0.9, 0.9, 0.9}, {0.95, 0.95, -0.95} })) {
+		fedes::Vector3<double> query = ForwardMap<fedes::ElementType::Hexahedron>(nodes_, element, g, h, r);
+		std::optional<fedes::MuesfData> local = fedes::InverseMap<fedes::ElementType::Hexahedron>(points, element, query, cache.LocalCoordinates(query));
+		ASSERT_TRUE(local.has_value());
+		EXPECT_NEAR(local->g, g, 1e-8);
+		EXPECT_NEAR(local->h, h, 1e-8);
+		EXPECT_NEAR(local->r, r, 1e-8);
+	}
+}
+
+TEST_F(IsoparametricTest, WedgeRoundTrip) {
+	std::vector<size_t> element({0, 1, 3, 4, 5, 7});
+	std::span<fedes::Vector3<double>> points(nodes_);
+	fedes::ElementCache cache = fedes::CacheElement(points, element, fedes::ElementType::Wedge);
+
+	for (const auto& [g, h, r] : std::vector<std::array<double, 3>>({ {0.2, 0.2, 0.0}, {0.7, 0.1, -0.8}, {0.05, 0.9, 0.9} })) {
+		fedes::Vector3<double> query = ForwardMap<fedes::ElementType::Wedge>(nodes_, element, g, h, r);
+		std::optional<fedes::MuesfData> local = fedes::InverseMap<fedes::ElementType::Wedge>(points, element, query, cache.LocalCoordinates(query));
+		ASSERT_TRUE(local.has_value());
+		EXPECT_NEAR(local->g, g, 1e-8);
+		EXPECT_NEAR(local->h, h, 1e-8);
+		EXPECT_NEAR(local->r, r, 1e-8);
+	}
+}
+
+TEST_F(IsoparametricTest, Containment) {
+	std::vector<size_t> element({0, 1, 2, 3, 4, 5, 6, 7});
+	std::span<fedes::Vector3<double>> points(nodes_);
+	fedes::ElementCache cache = fedes::CacheElement(points, element, fedes::ElementType::Hexahedron);
+	constexpr double inf = std::numeric_limits<double>::infinity();
+	fedes::ContainmentBounds bounds{ {-1.01, -1.01, -1.01}, {1.01, 1.01, 1.01}, inf };
+
+	fedes::Vector3<double> inside = ForwardMap<fedes::ElementType::Hexahedron>(nodes_, element, 0.9, -0.9, 0.9);
+	fedes::Vector3<double> outside = ForwardMap<fedes::ElementType::Hexahedron>(nodes_, element, 1.2, 0.0, 0.0);
+	EXPECT_TRUE(fedes::IsoparametricContainment<fedes::ElementType::Hexahedron>(points, element, cache, inside, bounds).has_value());
+	EXPECT_FALSE(fedes::IsoparametricContainment<fedes::ElementType::Hexahedron>(points, element, cache, outside, bounds).has_value());
+}
+
+TEST_F(IsoparametricTest, BoundingBoxPadding) {
+	constexpr double inf = std::numeric_limits<double>::infinity();
+	// Within the reference element, the nodal bounding box needs no padding
+	EXPECT_DOUBLE_EQ(fedes::BoundingBoxPadding<fedes::ElementType::Hexahedron>({ {-1, -1, -1}, {1, 1, 1}, inf }), 0.0);
+	EXPECT_DOUBLE_EQ(fedes::BoundingBoxPadding<fedes::ElementType::Wedge>({ {0, 0, -1}, {1, 1, 1}, inf, 1 }), 0.0);
+	EXPECT_GT(fedes::BoundingBoxPadding<fedes::ElementType::Hexahedron>({ {-1.06, -1.06, -1.06}, {1.06, 1.06, 1.06}, inf }), 0.0);
+
+	// Every mapped point within the relaxed bounds must lie in the padded box
+	std::vector<size_t> element({0, 1, 2, 3, 4, 5, 6, 7});
+	std::span<fedes::Vector3<double>> points(nodes_);
+	fedes::ElementCache cache = fedes::CacheElement(points, element, fedes::ElementType::Hexahedron);
+	double s = 1.3;
+	double padding = fedes::BoundingBoxPadding<fedes::ElementType::Hexahedron>({ {-s, -s, -s}, {s, s, s}, inf });
+	fedes::Vector3<double> range = cache.aabb_max - cache.aabb_min;
+	for (double g : { -s, s }) {
+		for (double h : { -s, s }) {
+			for (double r : { -s, s }) {
+				fedes::Vector3<double> x = ForwardMap<fedes::ElementType::Hexahedron>(nodes_, element, g, h, r);
+				EXPECT_GE(x.x, cache.aabb_min.x - padding * range.x);
+				EXPECT_LE(x.x, cache.aabb_max.x + padding * range.x);
+				EXPECT_GE(x.y, cache.aabb_min.y - padding * range.y);
+				EXPECT_LE(x.y, cache.aabb_max.y + padding * range.y);
+				EXPECT_GE(x.z, cache.aabb_min.z - padding * range.z);
+				EXPECT_LE(x.z, cache.aabb_max.z + padding * range.z);
+			}
+		}
+	}
+}
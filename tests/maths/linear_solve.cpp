@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "fedes/maths/linear_solve.h"
+
+#include <random>
+#include <vector>
+
+TEST(LinearSolve, RandomSystem) {
+	std::default_random_engine engine;
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+	for (size_t n : { 1, 4, 20, 36 }) {
+		std::vector<double> a(n * n), x(n), b(n, 0.0);
+		for (double& v : a) {
+			v = uniform(engine);
+		}
+		for (double& v : x) {
+			v = uniform(engine);
+		}
+		for (size_t i = 0; i < n; ++i) {
+			for (size_t j = 0; j < n; ++j) {
+				b[i] += a[i * n + j] * x[j];
+			}
+		}
+
+		std::vector<size_t> pivots(n);
+		ASSERT_TRUE(fedes::LUFactorize(a, n, pivots));
+		fedes::LUSolve(a, n, pivots, b);
+		for (size_t i = 0; i < n; ++i) {
+			ASSERT_NEAR(b[i], x[i], 1e-9) << "n = " << n;
+		}
+	}
+}
+
+TEST(LinearSolve, RequiresPivoting) {
+	// Zero leading entry, only solvable with row swaps
+	std::vector<double> a = { 0, 2, 1,
+	                          1, 1, 1,
+	                          2, 0, 3 };
+	std::vector<double> b = { 7, 6, 11 }; // x = (1, 2, 3)
+	std::vector<size_t> pivots(3);
+	ASSERT_TRUE(fedes::LUFactorize(a, 3, pivots));
+	fedes::LUSolve(a, 3, pivots, b);
+	ASSERT_NEAR(b[0], 1.0, 1e-12);
+	ASSERT_NEAR(b[1], 2.0, 1e-12);
+	ASSERT_NEAR(b[2], 3.0, 1e-12);
+}
+
+TEST(LinearSolve, Singular) {
+	std::vector<double> a = { 1, 2, 3,
+	                          2, 4, 6,
+	                          1, 0, 1 };
+	std::vector<size_t> pivots(3);
+	ASSERT_FALSE(fedes::LUFactorize(a, 3, pivots));
+
+	std::vector<double> zero(4, 0.0);
+	ASSERT_FALSE(fedes::LUFactorize(zero, 2, pivots));
+}
\ No newline at end of file
@@ -1,7 +1,12 @@
 #include <gtest/gtest.h>
 #include "fedes/maths/z_ordering.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "fedes/maths/vector3.h"
+#include "fedes/maths/random.h"
 
 class DetermineDirectionTest : public ::testing::Test {
 protected:
@@ -22,4 +27,55 @@ TEST_F(DetermineDirectionTest, ZOrder5) {
 	fedes::Vector3<double> point(0.5, -0.1, 0.9);
 	uint_fast8_t dir = fedes::DetermineDirection(center, point);
 	ASSERT_EQ(dir, 5) << "Expected point to have Morton Encoding of index 5";
+}
+
+TEST(MortonCode, Interleaving) {
+	ASSERT_EQ(fedes::MortonCode(0, 0, 0), 0);
+	ASSERT_EQ(fedes::MortonCode(0, 0, 1), 1);
+	ASSERT_EQ(fedes::MortonCode(0, 1, 0), 2);
+	ASSERT_EQ(fedes::MortonCode(1, 0, 0), 4);
+	ASSERT_EQ(fedes::MortonCode(1, 1, 1), 7);
+	ASSERT_EQ(fedes::MortonCode(2, 0, 0), 32);
+	ASSERT_EQ(fedes::MortonCode(3, 2, 1), 0b110'101);
+	ASSERT_EQ(fedes::MortonCode(0x1fffff, 0x1fffff, 0x1fffff), (uint_fast64_t(1) << 63) - 1);
+}
+
+TEST(MortonOrder, CubeCorners) {
+	// Corners of a cube, shuffled, with the direction code of each against the center as its index in Z-Order
+	std::vector<fedes::Vector3<double>> points = {
+		{ 1, 1, 0 }, { 0, 0, 1 }, { 1, 0, 1 }, { 0, 1, 0 }, { 1, 1, 1 }, { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 1 }
+	};
+	std::vector<size_t> order = fedes::MortonOrder(points);
+	ASSERT_EQ(order.size(), points.size());
+
+	fedes::Vector3<double> center(0.5, 0.5, 0.5);
+	for (size_t i = 0; i < order.size(); ++i) {
+		ASSERT_EQ(fedes::DetermineDirection(center, points[order[i]]), i) << "Expected corner " << points[order[i]] << " at position " << i;
+	}
+}
+
+TEST(MortonOrder, Permutation) {
+	std::vector<fedes::Vector3<double>> points = fedes::GenerateRandomArray<double>(-5.0, 3.0, 1000);
+	std::vector<size_t> order = fedes::MortonOrder(points);
+	ASSERT_EQ(order.size(), points.size());
+
+	std::vector<size_t> sorted = order;
+	std::sort(sorted.begin(), sorted.end());
+	for (size_t i = 0; i < sorted.size(); ++i) {
+		ASSERT_EQ(sorted[i], i);
+	}
+
+	// Consecutive points along the curve are much closer than consecutive points in the input order
+	auto path = [&](auto index) {
+		double length = 0;
+		for (size_t i = 1; i < points.size(); ++i) {
+			fedes::Vector3<double> d = points[index(i)] - points[index(i - 1)];
+			length += std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+		}
+		return length;
+	};
+	ASSERT_LT(path([&](size_t i) { return order[i]; }), 0.25 * path([](size_t i) { return i; }));
+
+	ASSERT_TRUE(fedes::MortonOrder(std::vector<fedes::Vector3<double>>()).empty());
+	ASSERT_EQ(fedes::MortonOrder(std::vector<fedes::Vector3<double>>(3, fedes::Vector3<double>(1.0))).size(), 3);
 }
\ No newline at end of file
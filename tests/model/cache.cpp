@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "fedes/model/cache.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/model/model.h"
+#include "fedes/common/files.h"
+
+namespace {
+	// Two elements of different sizes, ragged and partly empty fields, integration points and sparse IDs
+	fedes::Model CacheModel() {
+		fedes::Model model;
+		model.nodes = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 1, 1, 1 }, { 0.1, 0.2, 1e-300 } };
+		model.elements = { { 0, 1, 2, 3 }, { 1, 2, 3, 4, 5, 0 } };
+		model.displacement = { { 1, 2, 3 }, {}, { 4, 5, 6 }, { 7, 8, 9 }, { -1, -2, -3 }, { 0.5, 0.25, 0.125 } };
+		model.stress = { { 1, 2, 3, 4, 5, 6 }, { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 } };
+		model.accumulated_strain = { 0.1, 0.2, 0.3, 0.4, 0.5, 0.6 };
+		model.integration = { { 0.25, 0.25, 0.25 }, { 0.5, 0.5, 0.5 }, { 0.4, 0.4, 0.4 } };
+		model.integration_offsets = { 0, 1, 3 };
+		model.node_ids = { 10, 20, 30, 40, 50, 60 };
+		model.element_ids = { 7, 1000000000000 };
+		return model;
+	}
+
+	void ExpectSame(const fedes::Model& a, const fedes::Model& b) {
+		EXPECT_EQ(a, b);
+		EXPECT_EQ(a.integration, b.integration);
+		EXPECT_EQ(a.integration_offsets, b.integration_offsets);
+		EXPECT_EQ(a.node_ids, b.node_ids);
+		EXPECT_EQ(a.element_ids, b.element_ids);
+		EXPECT_EQ(a.node_order, b.node_order);
+		EXPECT_EQ(a.element_order, b.element_order);
+	}
+
+	void WriteText(const std::filesystem::path& path, const std::string& text) {
+		std::ofstream stream(path, std::ios::binary);
+		stream << text;
+	}
+}
+
+TEST(ModelCache, RoundTrip) {
+	const fedes::Model model = CacheModel();
+	fedes::ModelCacheWrite("Test_ModelCache_RoundTrip.fedes", model);
+
+	fedes::Model read;
+	read.nodes = { { 9, 9, 9 } };
+	fedes::ModelCacheRead("Test_ModelCache_RoundTrip.fedes", read);
+	ExpectSame(model, read);
+
+	BS::thread_pool pool(4);
+	fedes::Model parallel;
+	fedes::ModelCacheRead("Test_ModelCache_RoundTrip.fedes", parallel, &pool);
+	ExpectSame(model, parallel);
+}
+
+TEST(ModelCache, EmptyModel) {
+	fedes::ModelCacheWrite("Test_ModelCache_Empty.fedes", fedes::Model());
+	fedes::Model read = CacheModel();
+	fedes::ModelCacheRead("Test_ModelCache_Empty.fedes", read);
+	ExpectSame(fedes::Model(), read);
+}
+
+TEST(ModelCache, Corrupted) {
+	const fedes::Model model = CacheModel();
+	fedes::ModelCacheWrite("Test_ModelCache_Corrupted.fedes", model);
+	const std::string bytes = fedes::StringFromFile("Test_ModelCache_Corrupted.fedes");
+
+	// A flipped byte in the last section (the element IDs), in the header, or a truncated file
+	std::string flipped = bytes;
+	flipped[flipped.size() - 3] ^= 0x10;
+	std::string header = bytes;
+	header[8] = 2;
+	const std::vector<std::string> invalid = { flipped, header, bytes.substr(0, bytes.size() - 16), bytes.substr(0, 20),
+		"not a cache at all, but long enough to hold a header" };
+	for (const std::string& contents : invalid) {
+		WriteText("Test_ModelCache_Corrupted.fedes", contents);
+		fedes::Model read = CacheModel();
+		read.nodes.pop_back();
+		EXPECT_THROW(fedes::ModelCacheRead("Test_ModelCache_Corrupted.fedes", read), std::invalid_argument);
+		EXPECT_EQ(read.nodes.size(), model.nodes.size() - 1);
+	}
+}
+
+TEST(ModelCache, Fresh) {
+	std::filesystem::create_directories("Test_ModelCache_Fresh");
+	const std::filesystem::path input = "Test_ModelCache_Fresh/model.inp";
+	const std::filesystem::path output = "Test_ModelCache_Fresh/model.dat";
+	WriteText(input, "*NODE\n");
+	WriteText(output, "results\n");
+	const std::filesystem::path cache = fedes::ModelCachePath({ input, output });
+	EXPECT_EQ(cache, std::filesystem::path("Test_ModelCache_Fresh/model.inp.fedes"));
+	std::filesystem::remove(cache);
+	EXPECT_FALSE(fedes::ModelCacheFresh(cache, { input, output }));
+
+	fedes::ModelCacheWrite(cache, CacheModel(), { input, output });
+	const std::filesystem::file_time_type written = std::filesystem::last_write_time(cache);
+	std::filesystem::last_write_time(input, written - std::chrono::seconds(10));
+	std::filesystem::last_write_time(output, written - std::chrono::seconds(10));
+	EXPECT_TRUE(fedes::ModelCacheFresh(cache, { input, output }));
+
+	// Other sources, or a source edited since
+	EXPECT_FALSE(fedes::ModelCacheFresh(cache, { input }));
+	EXPECT_FALSE(fedes::ModelCacheFresh(cache, { input, "Test_ModelCache_Fresh/missing.dat" }));
+	std::filesystem::last_write_time(output, written + std::chrono::seconds(10));
+	EXPECT_FALSE(fedes::ModelCacheFresh(cache, { input, output }));
+}
+
+TEST(ModelCache, CachedRead) {
+	std::filesystem::create_directories("Test_ModelCache_CachedRead");
+	const std::filesystem::path input = "Test_ModelCache_CachedRead/model.inp";
+	WriteText(input, "*NODE\n");
+	std::filesystem::last_write_time(input, std::filesystem::file_time_type::clock::now() - std::chrono::seconds(10));
+	std::filesystem::remove(fedes::ModelCachePath({ input }));
+
+	size_t parsed = 0;
+	auto parse = [&](fedes::Model& model) {
+		++parsed;
+		model = CacheModel();
+	};
+	BS::thread_pool pool(2);
+	fedes::Model first;
+	fedes::CachedRead({ input }, first, parse, &pool);
+	EXPECT_EQ(parsed, 1);
+	EXPECT_TRUE(std::filesystem::exists(fedes::ModelCachePath({ input })));
+
+	fedes::Model second;
+	fedes::CachedRead({ input }, second, parse, &pool);
+	EXPECT_EQ(parsed, 1);
+	ExpectSame(first, second);
+
+	// A corrupted cache falls back to parsing, and is rewritten
+	WriteText(fedes::ModelCachePath({ input }), "corrupted");
+	fedes::Model third;
+	fedes::CachedRead({ input }, third, parse);
+	EXPECT_EQ(parsed, 2);
+	ExpectSame(first, third);
+	fedes::Model fourth;
+	fedes::CachedRead({ input }, fourth, parse);
+	EXPECT_EQ(parsed, 2);
+}
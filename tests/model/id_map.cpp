@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "fedes/model/id_map.h"
+
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+TEST(IdMap, Dense) {
+	fedes::IdMap map;
+	for (size_t id = 1; id <= 100; ++id) {
+		EXPECT_EQ(map.Insert(id), id - 1);
+	}
+	EXPECT_TRUE(map.dense());
+	EXPECT_EQ(map.size(), 100);
+	EXPECT_EQ(map.At(42), 41);
+	EXPECT_EQ(map.Id(41), 42);
+	EXPECT_FALSE(map.Find(0).has_value());
+	EXPECT_FALSE(map.Find(101).has_value());
+	EXPECT_TRUE(map.Release().empty());
+}
+
+TEST(IdMap, Sparse) {
+	fedes::IdMap map;
+	map.Insert(1);
+	map.Insert(2);
+	EXPECT_EQ(map.Insert(1000001), 2) << "Expected the index in insertion order";
+	EXPECT_FALSE(map.dense());
+	for (size_t i = 1; i <= 10000; ++i) {
+		map.Insert(1000001 + 7 * i);
+	}
+	EXPECT_EQ(map.size(), 10003);
+	EXPECT_EQ(map.At(1), 0);
+	EXPECT_EQ(map.At(2), 1);
+	EXPECT_EQ(map.At(1000001), 2);
+	EXPECT_EQ(map.At(1000001 + 7 * 10000), 10002);
+	EXPECT_EQ(map.Id(10002), 1000001 + 7 * 10000);
+	EXPECT_FALSE(map.Find(1000002).has_value());
+	EXPECT_THROW(static_cast<void>(map.At(3)), std::out_of_range);
+
+	const std::vector<size_t> ids = map.Release();
+	ASSERT_EQ(ids.size(), 10003);
+	EXPECT_EQ(ids[0], 1);
+	EXPECT_EQ(ids[2], 1000001);
+	EXPECT_EQ(map.size(), 0);
+}
+
+TEST(IdMap, Duplicates) {
+	fedes::IdMap map;
+	map.Insert(1);
+	map.Insert(2);
+	EXPECT_THROW(map.Insert(1), std::invalid_argument);
+	map.Insert(10);
+	EXPECT_THROW(map.Insert(10), std::invalid_argument);
+	EXPECT_THROW(map.Insert(2), std::invalid_argument);
+	EXPECT_EQ(map.size(), 3);
+}
+
+TEST(IdMap, FromModelIds) {
+	const fedes::IdMap dense({}, 5);
+	EXPECT_TRUE(dense.dense());
+	EXPECT_EQ(dense.At(5), 4);
+
+	const fedes::IdMap sparse({ 30, 10, 20 }, 3);
+	EXPECT_EQ(sparse.At(30), 0);
+	EXPECT_EQ(sparse.At(10), 1);
+	EXPECT_EQ(sparse.At(20), 2);
+	EXPECT_FALSE(sparse.Find(1).has_value());
+}
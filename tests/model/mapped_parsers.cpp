@@ -0,0 +1,278 @@
+#include <gtest/gtest.h>
+#include "fedes/model/parsers.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/model/model.h"
+#include "fedes/common/mapped_file.h"
+#include "fedes/common/scanning.h"
+
+class MappedParserTest : public ::testing::Test {
+protected:
+	fedes::Model model_;
+	std::filesystem::path path_;
+
+	void SetUp() override {
+		path_ = std::filesystem::temp_directory_path() / ("fedes-mapped-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+			::testing::UnitTest::GetInstance()->current_test_info()->name() + ".inp");
+	}
+
+	void TearDown() override {
+		std::filesystem::remove(path_);
+	}
+
+	void Write(const std::string& contents) {
+		std::ofstream stream(path_, std::ios::binary);
+		stream << contents;
+	}
+
+	// All parsers must read the same nodes and elements from the example models
+	static void ExpectEquivalent(const std::filesystem::path& path) {
+		if (!std::filesystem::exists(path)) {
+			GTEST_SKIP() << "Model file not found: " << path;
+		}
+		fedes::Model expected, actual;
+		fedes::AbaqusInputRead(path, expected);
+		fedes::AbaqusInputReadMapped(path, actual);
+		ExpectSameMesh(expected, actual);
+
+		fedes::Model parallel;
+		BS::thread_pool pool(4);
+		fedes::AbaqusInputReadParallel(path, parallel, pool);
+		ExpectSameMesh(expected, parallel);
+	}
+
+	static void ExpectSameMesh(const fedes::Model& expected, const fedes::Model& actual) {
+		ASSERT_FALSE(actual.nodes.empty());
+		ASSERT_EQ(actual.nodes.size(), expected.nodes.size());
+		ASSERT_EQ(actual.elements.size(), expected.elements.size());
+		for (size_t i = 0; i < expected.nodes.size(); ++i) {
+			ASSERT_EQ(actual.nodes[i], expected.nodes[i]) << "Node " << i;
+		}
+		for (size_t i = 0; i < expected.elements.size(); ++i) {
+			ASSERT_EQ(actual.elements[i], expected.elements[i]) << "Element " << i;
+		}
+	}
+};
+
+TEST_F(MappedParserTest, EquivalentHexahedra) {
+	ExpectEquivalent("../../models/Example2/piston-hex.inp");
+}
+
+TEST_F(MappedParserTest, HexahedraValues) {
+	if (!std::filesystem::exists("../../models/Example2/piston-hex.inp")) {
+		GTEST_SKIP() << "Model file not found";
+	}
+	fedes::AbaqusInputReadMapped("../../models/Example2/piston-hex.inp", model_);
+	ASSERT_EQ(model_.nodes.size(), 12174);
+	ASSERT_EQ(model_.elements.size(), 9387);
+	EXPECT_EQ(model_.nodes[0], fedes::Vector3<double>(0, 36, 60));
+	EXPECT_EQ(model_.nodes[12173], fedes::Vector3<double>(62.4650764, -29.2286339, 3.4624815));
+	EXPECT_EQ(model_.elements[0], std::vector<size_t>({ 0, 58, 137, 3, 219, 1177, 1217, 218 }));
+	EXPECT_EQ(model_.elements[9386], std::vector<size_t>({ 12173, 11379, 5327, 5331, 6208, 5414, 54, 1105 }));
+}
+
+TEST_F(MappedParserTest, EquivalentTetrahedra) {
+	ExpectEquivalent("../../models/Example2/piston-tet.inp");
+}
+
+TEST_F(MappedParserTest, EquivalentAssembly) {
+	ExpectEquivalent("../../models/Example1-ManufacturingProcessChain-2ndLoop/Process-1-Abaqus-Input.inp");
+}
+
+TEST_F(MappedParserTest, Sections) {
+	Write(
+		"*Heading\r\n"
+		"** comment\r\n"
+		"*NODE\r\n"
+		"  1,  0.,  +1.5e+00, -2.\r\n"
+		"  2,  1.0, 2.0, 3.0\r\n"
+		"\r\n"
+		"  3,  4, 5\r\n"
+		"*Element, type=C3D8\r\n"
+		"1, 1, 2, 3, 1, 2, 3, 1, 2\r\n"
+		"2, 3, 2, 1, 3,\r\n"
+		"   2, 1, 3, 2\r\n"
+		"*Element Output\r\n"
+		"S, E\r\n"
+		"*Node\r\n"
+		"  4, 9, 9, 9\r\n"
+		"*element, type=C3D8\r\n"
+		"3, 1, 1, 1, 1, 2, 2, 2, 2");
+	fedes::AbaqusInputReadMapped(path_, model_);
+
+	ASSERT_EQ(model_.nodes.size(), 3) << "Expected only the first *Node section to be read";
+	EXPECT_EQ(model_.nodes[0], fedes::Vector3<double>(0.0, 1.5, -2.0));
+	EXPECT_EQ(model_.nodes[1], fedes::Vector3<double>(1.0, 2.0, 3.0));
+	EXPECT_EQ(model_.nodes[2], fedes::Vector3<double>(4.0, 5.0, 0.0));
+
+	ASSERT_EQ(model_.elements.size(), 3);
+	EXPECT_EQ(model_.elements[0], std::vector<size_t>({ 0, 1, 2, 0, 1, 2, 0, 1 }));
+	EXPECT_EQ(model_.elements[1], std::vector<size_t>({ 2, 1, 0, 2, 1, 0, 2, 1 })) << "Expected the continuation line to be joined";
+	EXPECT_EQ(model_.elements[2], std::vector<size_t>({ 0, 0, 0, 0, 1, 1, 1, 1 }));
+}
+
+TEST_F(MappedParserTest, InvalidLine) {
+	Write("*Node\n1, 0.0, abc, 1.0\n");
+	EXPECT_THROW(fedes::AbaqusInputReadMapped(path_, model_), std::invalid_argument);
+}
+
+TEST_F(MappedParserTest, MissingFile) {
+	EXPECT_THROW(fedes::MappedFile("../../models/does-not-exist.inp"), std::ifstream::failure);
+}
+
+TEST(Scanning, Lines) {
+	const std::string_view text = "a\r\nbc\n\nd";
+	size_t position = 0;
+	EXPECT_EQ(fedes::NextLine(text, position), "a");
+	EXPECT_EQ(fedes::NextLine(text, position), "bc");
+	EXPECT_EQ(fedes::NextLine(text, position), "");
+	EXPECT_EQ(fedes::NextLine(text, position), "d");
+	EXPECT_EQ(position, text.size());
+	EXPECT_EQ(fedes::CountLines(text), 4);
+	EXPECT_EQ(fedes::CountLines("a\nb\n"), 2);
+}
+
+TEST(Scanning, Numbers) {
+	const std::string_view line = " +12, -3.5e-1 ,x";
+	size_t p = 0;
+	int integer = 0;
+	double real = 0;
+	ASSERT_TRUE(fedes::ParseNumber(line, p, integer));
+	EXPECT_EQ(integer, 12);
+	ASSERT_TRUE(fedes::SkipSeparator(line, p, ','));
+	ASSERT_TRUE(fedes::ParseNumber(line, p, real));
+	EXPECT_DOUBLE_EQ(real, -0.35);
+	ASSERT_TRUE(fedes::SkipSeparator(line, p, ','));
+	const size_t before = p;
+	EXPECT_FALSE(fedes::ParseNumber(line, p, real));
+	EXPECT_EQ(p, before);
+	EXPECT_TRUE(fedes::StartsWithLower("*NoDe, nset=all", "*node"));
+	EXPECT_FALSE(fedes::StartsWithLower("*Nset", "*node"));
+}
+
+TEST_F(MappedParserTest, ParallelOutputEquivalent) {
+	if (!std::filesystem::exists("../../models/Example2/piston-hex.dat")) {
+		GTEST_SKIP() << "Model file not found";
+	}
+	fedes::Model expected, actual;
+	BS::thread_pool pool(4);
+	fedes::AbaqusInputReadParallel("../../models/Example2/piston-hex.inp", expected, pool);
+	actual.nodes = expected.nodes;
+	fedes::AbaqusOutputRead("../../models/Example2/piston-hex.dat", expected);
+	fedes::AbaqusOutputReadParallel("../../models/Example2/piston-hex.dat", actual, pool);
+
+	ASSERT_EQ(actual.stress.size(), 12174);
+	EXPECT_EQ(actual.stress, expected.stress);
+	EXPECT_EQ(actual.displacement, expected.displacement);
+	EXPECT_EQ(actual.stress[0], std::vector<double>({ -370.6, -943.6, -48.59, 186.2, 7.742, 16.62 }));
+}
+
+TEST_F(MappedParserTest, ParallelContinuedElements) {
+	// Large enough to be split in several chunks, whose boundaries must not separate an element from its continuation
+	std::string contents = "*Node\n";
+	for (size_t i = 1; i <= 20000; ++i) {
+		contents += std::to_string(i) + ", " + std::to_string(i * 0.5) + ", " + std::to_string(i) + ", -" + std::to_string(i) + "\n";
+	}
+	contents += "*Element, type=C3D8\n";
+	for (size_t i = 1; i <= 20000; ++i) {
+		const std::string n = std::to_string(i);
+		contents += n + ", " + n + ", " + n + ", " + n + ",\n \n  " + n + ", " + n + ",\n" + n + ", " + n + ", " + n + "\n";
+	}
+	Write(contents);
+
+	fedes::Model expected;
+	fedes::AbaqusInputReadMapped(path_, expected);
+	BS::thread_pool pool(4);
+	fedes::AbaqusInputReadParallel(path_, model_, pool);
+
+	ASSERT_EQ(model_.nodes.size(), 20000);
+	ASSERT_EQ(model_.elements.size(), 20000);
+	EXPECT_EQ(model_.nodes, expected.nodes);
+	EXPECT_EQ(model_.elements, expected.elements);
+	EXPECT_EQ(model_.elements[19999], std::vector<size_t>(8, 19999));
+}
+
+TEST_F(MappedParserTest, ParallelAnsysLis) {
+	Write(
+		" LIST ALL SELECTED NODES.   DSYS=      0\n"
+		"\n"
+		"    NODE        X             Y             Z           THXY     THYZ     THZX\n"
+		"        1   0.0000        0.0000        0.0000          0.00     0.00     0.00\n"
+		"        2   1.0000        0.0000        0.0000          0.00     0.00     0.00\n"
+		"        3   1.0000        1.0000       -2.5000          0.00     0.00     0.00\n"
+		"\n"
+		" SORT TABLE ON  NODE  NODE  NODE\n"
+		"    NODE        X             Y             Z           THXY     THYZ     THZX\n"
+		"        4   0.5000        0.5000        1.0000          0.00     0.00     0.00\n"
+		"\n"
+		"    ELEM MAT TYP REL ESY SEC        NODES\n"
+		"\n"
+		"      1   1   1   1   0   1      1     2     3     4     1     2     3     4\n"
+		"      2   1   1   1   0   1      1     2     3     3     4     4     4     4\n"
+		"      3   1   1   1   0   1      1     2     3     3     4     2     1     1\n");
+	fedes::Model expected;
+	fedes::AnsysInputReadLis(path_, expected);
+	BS::thread_pool pool(4);
+	fedes::AnsysInputReadLisParallel(path_, model_, pool);
+
+	ASSERT_EQ(model_.nodes.size(), 4);
+	EXPECT_EQ(model_.nodes, expected.nodes);
+	EXPECT_EQ(model_.nodes[2], fedes::Vector3<double>(1.0, 1.0, -2.5));
+	ASSERT_EQ(model_.elements.size(), 3);
+	EXPECT_EQ(model_.elements, expected.elements);
+	EXPECT_EQ(model_.elements[1], std::vector<size_t>({ 0, 1, 2, 3 }));
+}
+
+TEST_F(MappedParserTest, SparseIds) {
+	// Assembly parts are numbered with an offset, elements refer to the node IDs of the file
+	Write(
+		"*Node\n"
+		"1000001, 0.0, 0.0, 0.0\n"
+		"1000002, 1.0, 0.0, 0.0\n"
+		"7, 0.0, 1.0, 0.0\n"
+		"2000000, 0.0, 0.0, 1.0\n"
+		"*Element, type=C3D4\n"
+		"500, 1000001, 1000002, 7, 2000000\n"
+		"12, 2000000, 7, 1000002, 1000001\n");
+	fedes::AbaqusInputReadMapped(path_, model_);
+
+	ASSERT_EQ(model_.nodes.size(), 4);
+	EXPECT_EQ(model_.nodes[2], fedes::Vector3<double>(0.0, 1.0, 0.0));
+	EXPECT_EQ(model_.node_ids, std::vector<size_t>({ 1000001, 1000002, 7, 2000000 }));
+	EXPECT_EQ(model_.element_ids, std::vector<size_t>({ 500, 12 }));
+	ASSERT_EQ(model_.elements.size(), 2);
+	EXPECT_EQ(model_.elements[0], std::vector<size_t>({ 0, 1, 2, 3 }));
+	EXPECT_EQ(model_.elements[1], std::vector<size_t>({ 3, 2, 1, 0 }));
+
+	fedes::Model parallel;
+	BS::thread_pool pool(4);
+	fedes::AbaqusInputReadParallel(path_, parallel, pool);
+	EXPECT_EQ(parallel.nodes, model_.nodes);
+	EXPECT_EQ(parallel.elements, model_.elements);
+	EXPECT_EQ(parallel.node_ids, model_.node_ids);
+	EXPECT_EQ(parallel.element_ids, model_.element_ids);
+}
+
+TEST_F(MappedParserTest, DenseIdsNotKept) {
+	Write(
+		"*Node\n"
+		"1, 0.0, 0.0, 0.0\n"
+		"2, 1.0, 0.0, 0.0\n"
+		"*Element, type=C3D4\n"
+		"1, 1, 2, 1, 2\n");
+	fedes::AbaqusInputReadMapped(path_, model_);
+	EXPECT_TRUE(model_.node_ids.empty());
+	EXPECT_TRUE(model_.element_ids.empty());
+}
+
+TEST_F(MappedParserTest, UnknownNode) {
+	Write("*Node\n1, 0.0, 0.0, 0.0\n*Element, type=C3D4\n1, 1, 1, 1, 2\n");
+	EXPECT_THROW(fedes::AbaqusInputReadMapped(path_, model_), std::out_of_range);
+}
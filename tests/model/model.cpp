@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include "fedes/model/model.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/maths/vector3.h"
+#include "fedes/maths/gauss.h"
+
+class HexGridModel : public ::testing::Test {
+protected:
+	fedes::Model model_;
+
+	// n^3 unit hexahedra, numbered in reverse so that the file order is far from the Z-Order
+	void SetUp() override {
+		const size_t n = 5;
+		auto node = [&](size_t x, size_t y, size_t z) { return (n - x) + (n + 1) * ((n - y) + (n + 1) * (n - z)); };
+		model_.nodes.resize((n + 1) * (n + 1) * (n + 1));
+		for (size_t z = 0; z <= n; ++z) {
+			for (size_t y = 0; y <= n; ++y) {
+				for (size_t x = 0; x <= n; ++x) {
+					model_.nodes[node(x, y, z)] = fedes::Vector3<double>(x, y, z);
+				}
+			}
+		}
+		for (size_t z = n; z-- > 0;) {
+			for (size_t y = n; y-- > 0;) {
+				for (size_t x = n; x-- > 0;) {
+					model_.elements.push_back({ node(x, y, z), node(x + 1, y, z), node(x + 1, y + 1, z), node(x, y + 1, z),
+						node(x, y, z + 1), node(x + 1, y, z + 1), node(x + 1, y + 1, z + 1), node(x, y + 1, z + 1) });
+				}
+			}
+		}
+		for (const fedes::Vector3<double>& p : model_.nodes) {
+			model_.displacement.push_back({ p.x, p.y, p.z });
+			model_.stress.push_back({ p.x, p.y, p.z, p.x + p.y, p.y + p.z, p.x + p.z });
+			model_.accumulated_strain.push_back(p.x * p.y * p.z);
+		}
+		model_.AssignIntegration();
+		for (const fedes::Vector3<double>& p : model_.integration) {
+			model_.total_strain.push_back({ p.x, p.y, p.z, 0, 0, 0 });
+		}
+	}
+};
+
+TEST_F(HexGridModel, ReorderConsistent) {
+	const fedes::Model original = model_;
+	model_.Reorder();
+	ASSERT_EQ(model_.node_order.size(), model_.nodes.size());
+	ASSERT_EQ(model_.element_order.size(), model_.elements.size());
+	ASSERT_FALSE(model_ == original) << "Expected the reverse numbered grid to be renumbered";
+
+	for (size_t i = 0; i < model_.nodes.size(); ++i) {
+		ASSERT_EQ(model_.nodes[i], original.nodes[model_.node_order[i]]);
+		ASSERT_EQ(model_.displacement[i], std::vector<double>({ model_.nodes[i].x, model_.nodes[i].y, model_.nodes[i].z }));
+		ASSERT_EQ(model_.stress[i], original.stress[model_.node_order[i]]);
+		ASSERT_EQ(model_.accumulated_strain[i], original.accumulated_strain[model_.node_order[i]]);
+	}
+	for (size_t e = 0; e < model_.elements.size(); ++e) {
+		const std::vector<size_t>& element = model_.elements[e];
+		const std::vector<size_t>& before = original.elements[model_.element_order[e]];
+		ASSERT_EQ(element.size(), before.size());
+		for (size_t n = 0; n < element.size(); ++n) {
+			ASSERT_EQ(model_.nodes[element[n]], original.nodes[before[n]]) << "Expected the element connectivity to be kept";
+		}
+		ASSERT_EQ(model_.integration[e], original.integration[model_.element_order[e]]);
+		ASSERT_EQ(model_.total_strain[e], original.total_strain[model_.element_order[e]]);
+	}
+}
+
+TEST_F(HexGridModel, ReorderLocality) {
+	auto span = [](const fedes::Model& model) {
+		size_t total = 0;
+		for (const std::vector<size_t>& element : model.elements) {
+			auto [min, max] = std::minmax_element(element.begin(), element.end());
+			total += *max - *min;
+		}
+		return total;
+	};
+	const size_t before = span(model_);
+	model_.Reorder();
+	ASSERT_LE(span(model_), before) << "Expected the nodes of an element to be no further apart in memory";
+}
+
+TEST_F(HexGridModel, RestoreOrder) {
+	const fedes::Model original = model_;
+	model_.Reorder();
+	model_.Reorder();
+	model_.RestoreOrder();
+	ASSERT_TRUE(model_ == original);
+	ASSERT_EQ(model_.integration, original.integration);
+	ASSERT_TRUE(model_.node_order.empty());
+	ASSERT_TRUE(model_.element_order.empty());
+
+	// Nothing to restore
+	model_.RestoreOrder();
+	ASSERT_TRUE(model_ == original);
+}
+
+TEST_F(HexGridModel, GaussIntegration) {
+	fedes::Model target;
+	target.nodes = model_.nodes;
+	target.elements = model_.elements;
+	target.SetTargetIndexes(model_, true);
+
+	ASSERT_EQ(target.integration_offsets.size(), target.elements.size() + 1);
+	ASSERT_EQ(target.integration.size(), 8 * target.elements.size());
+	ASSERT_EQ(target.stress.size(), target.integration.size());
+	ASSERT_EQ(target.accumulated_strain.size(), target.integration.size());
+	ASSERT_EQ(target.total_strain.size(), target.integration.size());
+
+	const double s = 0.5 - 0.5 / std::sqrt(3.0); // Distance of the Gauss points from the faces of a unit hexahedron
+	for (size_t e = 0; e < target.elements.size(); ++e) {
+		ASSERT_EQ(target.integration_offsets[e + 1] - target.integration_offsets[e], 8);
+		fedes::Vector3<double> centroid, mean;
+		for (size_t node : target.elements[e]) {
+			centroid += target.nodes[node] / 8.0;
+		}
+		for (size_t p = target.integration_offsets[e]; p < target.integration_offsets[e + 1]; ++p) {
+			const fedes::Vector3<double> d = target.integration[p] - centroid;
+			ASSERT_NEAR(std::abs(d.x), 0.5 - s, 1e-12);
+			ASSERT_NEAR(std::abs(d.y), 0.5 - s, 1e-12);
+			ASSERT_NEAR(std::abs(d.z), 0.5 - s, 1e-12);
+			mean += target.integration[p] / 8.0;
+		}
+		ASSERT_NEAR(mean.x, centroid.x, 1e-12);
+		ASSERT_NEAR(mean.y, centroid.y, 1e-12);
+		ASSERT_NEAR(mean.z, centroid.z, 1e-12);
+	}
+}
+
+TEST(GaussRule, CentroidMean) {
+	// A single affine element of each type, the Gauss points of the symmetric rules average to its centroid
+	std::vector<fedes::Vector3<double>> nodes = { { 0, 0, 0 }, { 2, 0, 0 }, { 0, 1, 0 }, { 0, 0, 3 }, { 2, 0, 3 }, { 0, 1, 3 } };
+	for (const auto& [element_type, element] : { std::pair{ fedes::ElementType::Tetrahedron, std::vector<size_t>{ 0, 1, 2, 3 } },
+		                                          std::pair{ fedes::ElementType::Wedge, std::vector<size_t>{ 0, 1, 2, 3, 4, 5 } } }) {
+		fedes::Vector3<double> centroid, mean;
+		for (size_t node : element) {
+			centroid += nodes[node] / static_cast<double>(element.size());
+		}
+		std::span<const std::array<double, 3>> points = fedes::GaussPoints(element_type);
+		for (const std::array<double, 3>& local : points) {
+			mean += fedes::LocalToGlobal(nodes, element, element_type, local) / static_cast<double>(points.size());
+		}
+		ASSERT_NEAR(mean.x, centroid.x, 1e-12) << element_type;
+		ASSERT_NEAR(mean.y, centroid.y, 1e-12) << element_type;
+		ASSERT_NEAR(mean.z, centroid.z, 1e-12) << element_type;
+	}
+	ASSERT_EQ(fedes::GaussPoints(fedes::ElementType::Tetrahedron).size(), 4);
+	ASSERT_EQ(fedes::GaussPoints(fedes::ElementType::Wedge).size(), 6);
+	ASSERT_EQ(fedes::GaussPoints(fedes::ElementType::Hexahedron).size(), 8);
+}
+
+TEST_F(HexGridModel, ReorderGaussPoints) {
+	fedes::Model target;
+	target.nodes = model_.nodes;
+	target.elements = model_.elements;
+	target.SetTargetIndexes(model_, true);
+	for (size_t p = 0; p < target.stress.size(); ++p) {
+		target.stress[p][0] = static_cast<double>(p);
+	}
+	const fedes::Model original = target;
+
+	target.Reorder();
+	for (size_t e = 0; e < target.elements.size(); ++e) {
+		const size_t before = target.element_order[e];
+		ASSERT_EQ(target.integration_offsets[e + 1] - target.integration_offsets[e], 8);
+		for (size_t j = 0; j < 8; ++j) {
+			ASSERT_EQ(target.integration[target.integration_offsets[e] + j], original.integration[original.integration_offsets[before] + j]);
+			ASSERT_EQ(target.stress[target.integration_offsets[e] + j], original.stress[original.integration_offsets[before] + j]);
+		}
+	}
+	target.RestoreOrder();
+	ASSERT_TRUE(target == original);
+	ASSERT_EQ(target.integration, original.integration);
+	ASSERT_EQ(target.integration_offsets, original.integration_offsets);
+}
+
+TEST_F(HexGridModel, ParallelSetTargetIndexes) {
+	BS::thread_pool pool(4);
+	for (bool gauss_points : { false, true }) {
+		fedes::Model serial, parallel;
+		serial.nodes = parallel.nodes = model_.nodes;
+		serial.elements = parallel.elements = model_.elements;
+		serial.SetTargetIndexes(model_, gauss_points);
+		parallel.SetTargetIndexes(model_, pool, gauss_points);
+
+		ASSERT_TRUE(parallel == serial);
+		ASSERT_EQ(parallel.integration, serial.integration);
+		ASSERT_EQ(parallel.integration_offsets, serial.integration_offsets);
+		ASSERT_EQ(parallel.integration.size(), gauss_points ? 8 * model_.elements.size() : model_.elements.size());
+		ASSERT_EQ(parallel.stress.size(), parallel.integration.size());
+		ASSERT_EQ(parallel.displacement.size(), parallel.nodes.size());
+	}
+
+	// Centroids are only assigned once
+	fedes::Model model = model_;
+	model.ParallelAssignIntegration(pool);
+	ASSERT_EQ(model.integration, model_.integration);
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "fedes/model/streaming.h"
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fedes/model/model.h"
+#include "fedes/model/parsers.h"
+#include "fedes/maths/element_type.h"
+
+// Records the events without building a model
+class RecordingHandler : public fedes::ModelHandler {
+public:
+	std::vector<size_t> node_ids;
+	std::vector<size_t> element_ids;
+	std::vector<std::optional<fedes::ElementType>> types;
+	std::vector<std::vector<size_t>> elements;
+	std::vector<std::string> field_names;
+	std::vector<size_t> field_ids;
+
+	void OnNode(size_t id, const fedes::Vector3<double>& xyz) override {
+		node_ids.push_back(id);
+	}
+
+	void OnElement(size_t id, std::optional<fedes::ElementType> type, std::span<const size_t> nodes) override {
+		element_ids.push_back(id);
+		types.push_back(type);
+		elements.emplace_back(nodes.begin(), nodes.end());
+	}
+
+	void OnField(std::string_view name, size_t id, std::span<const double> values) override {
+		field_names.emplace_back(name);
+		field_ids.push_back(id);
+	}
+};
+
+class StreamingTest : public ::testing::Test {
+protected:
+	std::filesystem::path path_;
+
+	void SetUp() override {
+		path_ = std::filesystem::temp_directory_path() / ("fedes-streaming-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+			::testing::UnitTest::GetInstance()->current_test_info()->name());
+	}
+
+	void TearDown() override {
+		std::filesystem::remove(path_);
+	}
+
+	void Write(const std::string& contents) {
+		std::ofstream stream(path_, std::ios::binary);
+		stream << contents;
+	}
+};
+
+TEST_F(StreamingTest, AbaqusEvents) {
+	Write(
+		"*Node\n"
+		"10, 0., 0., 0.\n"
+		"20, 1., 0., 0.\n"
+		"30, 0., 1., 0.\n"
+		"40, 0., 0., 1.\n"
+		"*Element, type=C3D4\n"
+		"7, 10, 20, 30, 40\n"
+		"*Element, type=C3D10\n"
+		"8, 10, 20, 30, 40, 10, 20,\n"
+		"30, 40, 10, 20\n");
+	RecordingHandler handler;
+	fedes::AbaqusInputStream(path_, handler);
+
+	EXPECT_EQ(handler.node_ids, std::vector<size_t>({ 10, 20, 30, 40 }));
+	EXPECT_EQ(handler.element_ids, std::vector<size_t>({ 7, 8 }));
+	EXPECT_EQ(handler.elements[0], std::vector<size_t>({ 10, 20, 30, 40 })) << "Expected the node IDs of the file";
+	EXPECT_EQ(handler.types[0], fedes::ElementType::Tetrahedron);
+	EXPECT_EQ(handler.elements[1].size(), 10);
+	EXPECT_FALSE(handler.types[1].has_value());
+}
+
+TEST_F(StreamingTest, BuilderMatchesParser) {
+	if (!std::filesystem::exists("../../models/Example2/piston-hex.dat")) {
+		GTEST_SKIP() << "Model file not found";
+	}
+	fedes::Model expected, actual;
+	fedes::AbaqusInputReadMapped("../../models/Example2/piston-hex.inp", expected);
+	fedes::AbaqusOutputRead("../../models/Example2/piston-hex.dat", expected);
+
+	fedes::ModelBuilder builder(actual);
+	fedes::AbaqusInputStream("../../models/Example2/piston-hex.inp", builder);
+	fedes::AbaqusOutputStream("../../models/Example2/piston-hex.dat", builder);
+
+	EXPECT_EQ(actual.nodes, expected.nodes);
+	EXPECT_EQ(actual.elements, expected.elements);
+	EXPECT_EQ(actual.stress, expected.stress);
+	// The displacement table of this model has no rows: AbaqusOutputRead still sizes the field, no event is streamed
+	EXPECT_TRUE(actual.displacement.empty());
+	EXPECT_EQ(expected.displacement, std::vector<std::vector<double>>(expected.nodes.size()));
+}
+
+TEST_F(StreamingTest, BuilderFields) {
+	fedes::Model model;
+	model.nodes.resize(3);
+	fedes::ModelBuilder builder(model);
+	const std::vector<double> plastic = { 1, 2, 3, 4 };
+	const std::vector<double> accumulated = { 0.5 };
+	builder.OnField("plastic_strain", 2, plastic);
+	builder.OnField("accumulated_strain", 2, accumulated);
+	builder.OnField("unknown", 1, plastic);
+
+	ASSERT_EQ(model.plastic_strain.size(), 3) << "Expected the field to be sized to the nodes";
+	EXPECT_EQ(model.plastic_strain[1], plastic);
+	ASSERT_EQ(model.accumulated_strain.size(), 3);
+	EXPECT_EQ(model.accumulated_strain[1], 0.5);
+	EXPECT_TRUE(model.stress.empty());
+	EXPECT_THROW(builder.OnField("stress", 0, plastic), std::out_of_range);
+	EXPECT_THROW(builder.OnField("stress", 4, plastic), std::out_of_range);
+}
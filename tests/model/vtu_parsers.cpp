@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include "fedes/model/parsers.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fedes/model/model.h"
+#include "fedes/model/writers.h"
+#include "fedes/common/base64.h"
+#include "fedes/common/compression.h"
+
+namespace {
+	template <typename T>
+	std::string Bytes(const std::vector<T>& values) {
+		return std::string(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+	}
+
+	struct Array {
+		std::string section;
+		std::string name;
+		std::string type;
+		size_t components;
+		std::string bytes;
+	};
+
+	enum class Format { Binary, AppendedRaw, AppendedBase64 };
+
+	/*
+	 * @brief A two tetrahedra unstructured grid in the given binary encoding, as written by VTK: a header of the array size,
+	 * or of the compressed blocks, followed by the data. Blocks are small so that arrays span several of them.
+	 */
+	std::string Vtu(Format format, bool compressed, bool header_64) {
+		const std::vector<Array> arrays = {
+			{ "PointData", "displacement", "Float32", 3, Bytes(std::vector<float>({ 0, 0, 0, 0.5f, 0, 0, 0, 0.25f, 0, 0, 0, 1, 1, 1, 1 })) },
+			{ "PointData", "Stress", "Float64", 6, Bytes(std::vector<double>({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+				17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30 })) },
+			{ "PointData", "NodeId", "Int64", 1, Bytes(std::vector<int64_t>({ 11, 12, 13, 14, 15 })) },
+			{ "CellData", "ElementId", "Int32", 1, Bytes(std::vector<int32_t>({ 7, 9 })) },
+			{ "Points", "Points", "Float64", 3, Bytes(std::vector<double>({ 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 1 })) },
+			{ "Cells", "connectivity", "Int64", 1, Bytes(std::vector<int64_t>({ 0, 1, 2, 3, 1, 2, 3, 4 })) },
+			{ "Cells", "offsets", "UInt32", 1, Bytes(std::vector<uint32_t>({ 4, 8 })) },
+			{ "Cells", "types", "UInt8", 1, Bytes(std::vector<uint8_t>({ 10, 10 })) },
+		};
+		auto word = [&](size_t value) {
+			return header_64 ? Bytes(std::vector<uint64_t>({ value })) : Bytes(std::vector<uint32_t>({ static_cast<uint32_t>(value) }));
+		};
+		auto encode = [&](const std::string& bytes, std::string& header, std::string& data) {
+			if (!compressed) {
+				header = word(bytes.size());
+				data = bytes;
+				return;
+			}
+			const size_t block_size = 16;
+			const size_t blocks = (bytes.size() + block_size - 1) / block_size;
+			std::string sizes;
+			data.clear();
+			for (size_t i = 0; i < blocks; ++i) {
+				const std::vector<char> block = fedes::ZlibCompress(std::string_view(bytes).substr(i * block_size, block_size));
+				sizes += word(block.size());
+				data.append(block.begin(), block.end());
+			}
+			header = word(blocks) + word(block_size) + word(bytes.size() % block_size) + sizes;
+		};
+
+		std::string xml = std::string("<?xml version=\"1.0\"?>\n<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\"") +
+			(header_64 ? " header_type=\"UInt64\"" : "") + (compressed ? " compressor=\"vtkZLibDataCompressor\"" : "") + ">\n" +
+			"<UnstructuredGrid>\n<Piece NumberOfPoints=\"5\" NumberOfCells=\"2\">\n";
+		std::string appended;
+		std::string section;
+		for (const Array& array : arrays) {
+			if (array.section != section) {
+				if (!section.empty()) {
+					xml += "</" + section + ">\n";
+				}
+				section = array.section;
+				xml += "<" + section + ">\n";
+			}
+			std::string header, data;
+			encode(array.bytes, header, data);
+			xml += "<DataArray type=\"" + array.type + "\" Name=\"" + array.name + "\" NumberOfComponents=\"" +
+				std::to_string(array.components) + "\"";
+			if (format == Format::Binary) {
+				// Compressed arrays encode their header separately, as VTK does
+				const std::string text = compressed ? fedes::Base64Encode(header) + fedes::Base64Encode(data) : fedes::Base64Encode(header + data);
+				xml += " format=\"binary\">\n  " + text + "\n</DataArray>\n";
+			} else {
+				xml += " format=\"appended\" offset=\"" + std::to_string(appended.size()) + "\"/>\n";
+				appended += format == Format::AppendedRaw ? header + data : fedes::Base64Encode(header + data);
+			}
+		}
+		xml += "</" + section + ">\n</Piece>\n</UnstructuredGrid>\n";
+		if (format != Format::Binary) {
+			xml += std::string("<AppendedData encoding=\"") + (format == Format::AppendedRaw ? "raw" : "base64") + "\">\n   _" + appended +
+				"\n</AppendedData>\n";
+		}
+		return xml + "</VTKFile>\n";
+	}
+}
+
+class VtuParserTest : public ::testing::Test {
+protected:
+	fedes::Model model_;
+	std::filesystem::path path_;
+
+	void SetUp() override {
+		path_ = std::filesystem::temp_directory_path() / ("fedes-vtu-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+			::testing::UnitTest::GetInstance()->current_test_info()->name() + ".vtu");
+	}
+
+	void TearDown() override {
+		std::filesystem::remove(path_);
+	}
+
+	void Write(const std::string& contents) {
+		std::ofstream stream(path_, std::ios::binary);
+		stream << contents;
+	}
+
+	void ExpectTetrahedra() {
+		ASSERT_EQ(model_.nodes.size(), 5);
+		EXPECT_EQ(model_.nodes[1], fedes::Vector3<double>(1, 0, 0));
+		EXPECT_EQ(model_.nodes[4], fedes::Vector3<double>(1, 1, 1));
+		ASSERT_EQ(model_.elements.size(), 2);
+		EXPECT_EQ(model_.elements[0], std::vector<size_t>({ 0, 1, 2, 3 }));
+		EXPECT_EQ(model_.elements[1], std::vector<size_t>({ 1, 2, 3, 4 }));
+		ASSERT_EQ(model_.displacement.size(), 5);
+		EXPECT_EQ(model_.displacement[1], std::vector<double>({ 0.5, 0, 0 }));
+		EXPECT_EQ(model_.displacement[2], std::vector<double>({ 0, 0.25, 0 }));
+		ASSERT_EQ(model_.stress.size(), 5);
+		EXPECT_EQ(model_.stress[4], std::vector<double>({ 25, 26, 27, 28, 29, 30 }));
+		EXPECT_EQ(model_.node_ids, std::vector<size_t>({ 11, 12, 13, 14, 15 }));
+		EXPECT_EQ(model_.element_ids, std::vector<size_t>({ 7, 9 }));
+	}
+};
+
+TEST_F(VtuParserTest, Binary) {
+	Write(Vtu(Format::Binary, false, false));
+	fedes::VtuRead(path_, model_);
+	ExpectTetrahedra();
+}
+
+TEST_F(VtuParserTest, AppendedRaw) {
+	Write(Vtu(Format::AppendedRaw, false, true));
+	fedes::VtuRead(path_, model_);
+	ExpectTetrahedra();
+}
+
+TEST_F(VtuParserTest, AppendedBase64) {
+	Write(Vtu(Format::AppendedBase64, false, false));
+	fedes::VtuRead(path_, model_);
+	ExpectTetrahedra();
+}
+
+TEST_F(VtuParserTest, Compressed) {
+	if (!fedes::HasZlib()) {
+		GTEST_SKIP() << "Built without zlib";
+	}
+	for (Format format : { Format::Binary, Format::AppendedRaw, Format::AppendedBase64 }) {
+		for (bool header_64 : { false, true }) {
+			model_ = fedes::Model();
+			Write(Vtu(format, true, header_64));
+			fedes::VtuRead(path_, model_);
+			ExpectTetrahedra();
+		}
+	}
+}
+
+TEST_F(VtuParserTest, AsciiRoundTrip) {
+	fedes::Model expected;
+	expected.nodes = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 1, 1, 1 } };
+	expected.elements = { { 0, 1, 2, 3 }, { 1, 2, 3, 4 } };
+	expected.displacement = { { 0, 0, 0 }, { 0.5, 0, 0 }, { 0, 0.25, 0 }, { 0, 0, 1 }, { 1, 1, 1 } };
+	expected.stress = { { 1, 2, 3, 4, 5, 6 }, { 7, 8, 9, 10, 11, 12 }, { 13, 14, 15, 16, 17, 18 }, { 19, 20, 21, 22, 23, 24 },
+		{ 25, 26, 27, 28, 29, 30 } };
+	expected.accumulated_strain = { 0.1, 0.2, 0.3, 0.4, 0.5 };
+	expected.node_ids = { 11, 12, 13, 14, 15 };
+	expected.element_ids = { 7, 9 };
+	fedes::CreateXML(path_, expected, false, true);
+	fedes::VtuRead(path_, model_);
+
+	ExpectTetrahedra();
+	EXPECT_EQ(model_.accumulated_strain, expected.accumulated_strain);
+	EXPECT_TRUE(model_.total_strain.empty());
+}
+
+TEST_F(VtuParserTest, Pieces) {
+	Write(
+		"<VTKFile type=\"UnstructuredGrid\">\n<UnstructuredGrid>\n"
+		"<Piece NumberOfPoints=\"2\" NumberOfCells=\"1\">\n"
+		"<Points><DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"ascii\">0 0 0 1 2 3</DataArray></Points>\n"
+		"<Cells><DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">0 1</DataArray>\n"
+		"<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">2</DataArray></Cells>\n"
+		"</Piece>\n"
+		"<!-- second <Piece> -->\n"
+		"<Piece NumberOfPoints=\"1\" NumberOfCells=\"1\">\n"
+		"<Points><DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"ascii\">\n 4 5 6\n</DataArray></Points>\n"
+		"<Cells><DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">0</DataArray>\n"
+		"<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">1</DataArray></Cells>\n"
+		"</Piece>\n</UnstructuredGrid>\n</VTKFile>\n");
+	fedes::VtuRead(path_, model_);
+
+	ASSERT_EQ(model_.nodes.size(), 3);
+	EXPECT_EQ(model_.nodes[2], fedes::Vector3<double>(4, 5, 6));
+	ASSERT_EQ(model_.elements.size(), 2);
+	EXPECT_EQ(model_.elements[1], std::vector<size_t>({ 2 })) << "Expected the nodes of later pieces to be offset";
+}
+
+TEST_F(VtuParserTest, Invalid) {
+	Write("<VTKFile type=\"UnstructuredGrid\"><UnstructuredGrid><Piece>\n"
+		"<Points><DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"binary\">AAA*</DataArray></Points>\n"
+		"</Piece></UnstructuredGrid></VTKFile>\n");
+	EXPECT_THROW(fedes::VtuRead(path_, model_), std::invalid_argument);
+}
@@ -1,12 +1,18 @@
 #include "fedes/model/writers.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <string>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
 
 #include "fedes/model/model.h"
 #include "fedes/model/parsers.h"
 #include "fedes/common/files.h"
+#include "fedes/common/compression.h"
 
 
 TEST(Writer, CreateXML) {
@@ -33,4 +39,176 @@ TEST(Writer, CreateXML) {
 		throw;
 	}
 	ASSERT_EQ(got, expected) << "CreateXML writer doesn't produce expected output";
-}
\ No newline at end of file
+}
+TEST(Writer, CreateAppendedXML) {
+	fedes::Model model;
+	model.nodes = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 1, 1, 1 } };
+	model.elements = { { 0, 1, 2, 3 }, { 1, 2, 3, 4 } };
+	model.displacement = { { 0, 0, 0 }, { 0.5, 0, 0 }, { 0, 0.25, 0 }, { 0, 0, 1 }, { 1, 1, 1 } };
+	model.stress = { { 1, 2, 3, 4, 5, 6 }, { 7, 8, 9, 10, 11, 12 }, { 13, 14, 15, 16, 17, 18 }, { 19, 20, 21, 22, 23, 24 },
+		{ 25, 26, 27, 28, 29, 30 } };
+	model.accumulated_strain = { 0.1, 0.2, 0.3, 0.4, 0.5 };
+	model.node_ids = { 11, 12, 13, 14, 15 };
+	fedes::CreateAppendedXML("Test_CreateAppendedXML.vtu", model, false, true);
+
+	const std::string contents = fedes::StringFromFile("Test_CreateAppendedXML.vtu");
+	EXPECT_NE(contents.find("<AppendedData encoding=\"raw\" >"), std::string::npos);
+	EXPECT_EQ(contents.find("format=\"ascii\""), std::string::npos);
+
+	fedes::Model read;
+	fedes::VtuRead("Test_CreateAppendedXML.vtu", read);
+	EXPECT_EQ(read.nodes, model.nodes);
+	EXPECT_EQ(read.elements, model.elements);
+	EXPECT_EQ(read.displacement, model.displacement);
+	EXPECT_EQ(read.stress, model.stress);
+	EXPECT_EQ(read.accumulated_strain, model.accumulated_strain);
+	EXPECT_EQ(read.node_ids, model.node_ids);
+	EXPECT_TRUE(read.element_ids.empty());
+
+	// Same contents as the ascii writer
+	fedes::CreateXML("Test_CreateXML_Ascii.vtu", model, false, true);
+	fedes::Model ascii;
+	fedes::VtuRead("Test_CreateXML_Ascii.vtu", ascii);
+	EXPECT_EQ(ascii.stress, read.stress);
+	EXPECT_EQ(ascii.elements, read.elements);
+}
+
+TEST(Writer, CreateAppendedXMLByIntegration) {
+	fedes::Model model;
+	model.nodes = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+	model.elements = { { 0, 1, 2, 3 } };
+	model.stress = { { 1, 1, 1, 1, 1, 1 }, { 3, 3, 3, 3, 3, 3 } };
+	model.integration_offsets = { 0, 2 };
+	model.element_ids = { 42 };
+	fedes::CreateAppendedXML("Test_CreateAppendedXML_Integration.vtu", model, true, true);
+
+	fedes::Model read;
+	fedes::VtuRead("Test_CreateAppendedXML_Integration.vtu", read);
+	EXPECT_EQ(read.elements, model.elements);
+	EXPECT_TRUE(read.stress.empty()) << "Expected the element averages as cell data, which VtuRead ignores";
+	EXPECT_EQ(read.element_ids, model.element_ids);
+	const std::string contents = fedes::StringFromFile("Test_CreateAppendedXML_Integration.vtu");
+	EXPECT_NE(contents.find("<CellData>\n<DataArray type=\"Float64\" Name=\"Stress\""), std::string::npos);
+}
+
+TEST(Writer, CreateXMLParallel) {
+	// Enough rows for several chunks per array, formatted concurrently but written in order
+	fedes::Model model;
+	for (size_t i = 0; i < 50000; ++i) {
+		const double x = static_cast<double>(i) / 7.0;
+		model.nodes.emplace_back(x, -x * 1e-12, x * 3e20);
+		model.displacement.push_back({ x, 0.1 * x, -x });
+		model.stress.push_back({ x, 1, 2, 3, 4, 1.0 / (i + 1) });
+		model.node_ids.push_back(2 * i + 1);
+	}
+	for (size_t e = 0; e + 8 < model.nodes.size(); e += 3) {
+		model.elements.push_back(e % 2 == 0 ? std::vector<size_t>({ e, e + 1, e + 2, e + 3 }) :
+			std::vector<size_t>({ e, e + 1, e + 2, e + 3, e + 4, e + 5, e + 6, e + 7 }));
+	}
+	fedes::CreateXML("Test_CreateXML_Serial.vtu", model, false, true);
+	BS::thread_pool pool(4);
+	fedes::CreateXML("Test_CreateXML_Parallel.vtu", model, false, true, &pool);
+
+	const std::string serial = fedes::StringFromFile("Test_CreateXML_Serial.vtu");
+	const std::string parallel = fedes::StringFromFile("Test_CreateXML_Parallel.vtu");
+	ASSERT_EQ(serial.size(), parallel.size());
+	EXPECT_TRUE(serial == parallel);
+	EXPECT_NE(serial.find("\n0.14285714285714285 -1.4285714285714284e-13 42857142857142853632\n"), std::string::npos);
+	EXPECT_NE(serial.find("\n3 4 5 6 7 8 9 10 \n"), std::string::npos);
+
+	fedes::Model read;
+	fedes::VtuRead("Test_CreateXML_Parallel.vtu", read);
+	EXPECT_EQ(read.nodes, model.nodes);
+	EXPECT_EQ(read.elements, model.elements);
+	EXPECT_EQ(read.stress, model.stress);
+}
+
+TEST(Writer, CreateCompressedXML) {
+	if (!fedes::HasZlib()) {
+		GTEST_SKIP() << "Built without zlib";
+	}
+	// Arrays of several 32 KiB blocks, and some of none
+	fedes::Model model;
+	for (size_t i = 0; i < 10000; ++i) {
+		model.nodes.emplace_back(static_cast<double>(i % 100), static_cast<double>(i / 100), 0.5);
+		model.stress.push_back({ 1, 2, 3, static_cast<double>(i), 5, 6 });
+	}
+	for (size_t e = 0; e + 3 < model.nodes.size(); e += 2) {
+		model.elements.push_back({ e, e + 1, e + 2, e + 3 });
+	}
+	BS::thread_pool pool(4);
+	fedes::CreateCompressedXML("Test_CreateCompressedXML.vtu", model, false, true, &pool);
+	fedes::CreateAppendedXML("Test_CreateAppendedXML_Uncompressed.vtu", model, false, true);
+	EXPECT_LT(std::filesystem::file_size("Test_CreateCompressedXML.vtu"), std::filesystem::file_size("Test_CreateAppendedXML_Uncompressed.vtu") / 4);
+
+	fedes::Model read;
+	fedes::VtuRead("Test_CreateCompressedXML.vtu", read);
+	EXPECT_EQ(read.nodes, model.nodes);
+	EXPECT_EQ(read.elements, model.elements);
+	EXPECT_EQ(read.stress, model.stress);
+	EXPECT_TRUE(read.displacement.empty());
+
+	fedes::CreateCompressedXML("Test_CreateCompressedXML_Serial.vtu", model, false, true);
+	EXPECT_EQ(fedes::StringFromFile("Test_CreateCompressedXML_Serial.vtu"), fedes::StringFromFile("Test_CreateCompressedXML.vtu"));
+}
+
+TEST(Writer, CreatePartitionedXML) {
+	// 6 x 6 x 6 hexahedra, with sparse IDs to check the pieces against
+	fedes::Model model;
+	const size_t n = 7;
+	for (size_t k = 0; k < n; ++k) {
+		for (size_t j = 0; j < n; ++j) {
+			for (size_t i = 0; i < n; ++i) {
+				model.nodes.emplace_back(static_cast<double>(i), static_cast<double>(j), static_cast<double>(k));
+				model.node_ids.push_back(1000 + model.nodes.size());
+				model.displacement.push_back({ static_cast<double>(i), 0, 0 });
+			}
+		}
+	}
+	auto node = [&](size_t i, size_t j, size_t k) { return i + n * (j + n * k); };
+	for (size_t k = 0; k + 1 < n; ++k) {
+		for (size_t j = 0; j + 1 < n; ++j) {
+			for (size_t i = 0; i + 1 < n; ++i) {
+				model.elements.push_back({ node(i, j, k), node(i + 1, j, k), node(i + 1, j + 1, k), node(i, j + 1, k),
+					node(i, j, k + 1), node(i + 1, j, k + 1), node(i + 1, j + 1, k + 1), node(i, j + 1, k + 1) });
+				model.element_ids.push_back(model.elements.size() * 10);
+				model.stress.push_back({ static_cast<double>(model.elements.size()), 0, 0, 0, 0, 0 });
+			}
+		}
+	}
+
+	BS::thread_pool pool(4);
+	for (fedes::VtuFormat format : { fedes::VtuFormat::Ascii, fedes::VtuFormat::Appended }) {
+		std::filesystem::remove_all("Test_CreatePartitionedXML");
+		fedes::CreatePartitionedXML("Test_CreatePartitionedXML/target.pvtu", model, true, true, 4, format, pool);
+
+		const std::string index = fedes::StringFromFile("Test_CreatePartitionedXML/target.pvtu");
+		EXPECT_NE(index.find("<PDataArray type=\"Float64\" Name=\"displacement\" NumberOfComponents=\"3\" />"), std::string::npos);
+		EXPECT_NE(index.find("<PCellData>\n<PDataArray type=\"Float64\" Name=\"Stress\" NumberOfComponents=\"6\" />"), std::string::npos);
+		EXPECT_NE(index.find("<Piece Source=\"target_3.vtu\" />"), std::string::npos);
+
+		std::vector<bool> seen(model.elements.size());
+		for (size_t p = 0; p < 4; ++p) {
+			fedes::Model piece;
+			fedes::VtuRead("Test_CreatePartitionedXML/target_" + std::to_string(p) + ".vtu", piece);
+			EXPECT_EQ(piece.elements.size(), model.elements.size() / 4);
+			ASSERT_EQ(piece.node_ids.size(), piece.nodes.size());
+			ASSERT_EQ(piece.element_ids.size(), piece.elements.size());
+			ASSERT_EQ(piece.displacement.size(), piece.nodes.size());
+			for (size_t i = 0; i < piece.nodes.size(); ++i) {
+				const size_t original = piece.node_ids[i] - 1001;
+				EXPECT_EQ(piece.nodes[i], model.nodes[original]);
+				EXPECT_EQ(piece.displacement[i], model.displacement[original]);
+			}
+			for (size_t e = 0; e < piece.elements.size(); ++e) {
+				const size_t original = piece.element_ids[e] / 10 - 1;
+				EXPECT_FALSE(seen[original]) << "Element " << original << " in several pieces";
+				seen[original] = true;
+				for (size_t k = 0; k < 8; ++k) {
+					EXPECT_EQ(piece.node_ids[piece.elements[e][k]], model.node_ids[model.elements[original][k]]);
+				}
+			}
+		}
+		EXPECT_EQ(std::count(seen.begin(), seen.end(), true), model.elements.size());
+	}
+}
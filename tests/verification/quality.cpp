@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "fedes/verification/quality.h"
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <sstream>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "fedes/model/model.h"
+#include "fedes/indexing/octree/octree.h"
+#include "fedes/interpolations/octree/octree.h"
+
+class MappingQuality : public ::testing::Test {
+protected:
+	fedes::Model source_, target_;
+	std::span<fedes::Vector3<double>> span_;
+	std::unique_ptr<fedes::Octree<double>> octree_;
+	BS::thread_pool pool_{ 4 };
+
+	// n^3 unit hexahedra over [0, n]^3 with linear fields
+	void SetUp() override {
+		const size_t n = 4;
+		auto node = [&](size_t x, size_t y, size_t z) { return x + (n + 1) * (y + (n + 1) * z); };
+		for (size_t z = 0; z <= n; ++z) {
+			for (size_t y = 0; y <= n; ++y) {
+				for (size_t x = 0; x <= n; ++x) {
+					source_.nodes.emplace_back(x, y, z);
+					source_.displacement.push_back({ double(x), double(y), double(z) });
+					source_.accumulated_strain.push_back(double(x + y + z));
+				}
+			}
+		}
+		for (size_t z = 0; z < n; ++z) {
+			for (size_t y = 0; y < n; ++y) {
+				for (size_t x = 0; x < n; ++x) {
+					source_.elements.push_back({ node(x, y, z), node(x + 1, y, z), node(x + 1, y + 1, z), node(x, y + 1, z),
+						node(x, y, z + 1), node(x + 1, y, z + 1), node(x + 1, y + 1, z + 1), node(x, y + 1, z + 1) });
+				}
+			}
+		}
+		span_ = std::span<fedes::Vector3<double>>(source_.nodes);
+		octree_ = std::make_unique<fedes::Octree<double>>(span_, source_.elements, 10, 8);
+	}
+};
+
+TEST_F(MappingQuality, FieldStatistics) {
+	const std::vector<std::vector<double>> field = { { 1.0, -2.0 }, { 3.0, 2.0 }, { std::numeric_limits<double>::quiet_NaN(), 0.0 } };
+	const fedes::FieldStatistics statistics = fedes::ParallelFieldStatistics("field", field, pool_);
+	EXPECT_EQ(statistics.count, 2);
+	EXPECT_EQ(statistics.non_finite, 1);
+	EXPECT_DOUBLE_EQ(statistics.min[0], 1.0);
+	EXPECT_DOUBLE_EQ(statistics.max[0], 3.0);
+	EXPECT_DOUBLE_EQ(statistics.mean[0], 2.0);
+	EXPECT_DOUBLE_EQ(statistics.l2[0], std::sqrt(10.0));
+	EXPECT_DOUBLE_EQ(statistics.min[1], -2.0);
+	EXPECT_DOUBLE_EQ(statistics.mean[1], 0.0);
+	EXPECT_DOUBLE_EQ(statistics.l2[1], std::sqrt(8.0));
+}
+
+TEST_F(MappingQuality, ScalarFieldStatisticsMatchSerial) {
+	const fedes::FieldStatistics statistics = fedes::ParallelFieldStatistics("accumulated strain", source_.accumulated_strain, pool_);
+	const double sum = std::accumulate(source_.accumulated_strain.begin(), source_.accumulated_strain.end(), 0.0);
+	const double sum_sq = std::inner_product(source_.accumulated_strain.begin(), source_.accumulated_strain.end(),
+		source_.accumulated_strain.begin(), 0.0);
+	ASSERT_EQ(statistics.count, source_.accumulated_strain.size());
+	EXPECT_DOUBLE_EQ(statistics.min[0], 0.0);
+	EXPECT_DOUBLE_EQ(statistics.max[0], 12.0);
+	EXPECT_NEAR(statistics.mean[0], sum / source_.accumulated_strain.size(), 1e-12);
+	EXPECT_NEAR(statistics.l2[0], std::sqrt(sum_sq), 1e-9);
+}
+
+TEST_F(MappingQuality, Histogram) {
+	const std::vector<double> values = { 0.0, 0.1, 0.5, 0.9, 1.0 };
+	const fedes::Histogram histogram = fedes::MakeHistogram(values, 2, pool_);
+	EXPECT_DOUBLE_EQ(histogram.lower, 0.0);
+	EXPECT_DOUBLE_EQ(histogram.upper, 1.0);
+	ASSERT_EQ(histogram.counts.size(), 2);
+	EXPECT_EQ(histogram.counts[0], 2);
+	EXPECT_EQ(histogram.counts[1], 3) << "Expected the upper bound to fall into the last bin";
+}
+
+TEST_F(MappingQuality, CountsRelaxedAndProjected) {
+	// Two interior points, one just outside of the face x = 0 and one far outside
+	const std::vector<fedes::Vector3<double>> points = { { 1.5, 1.5, 1.5 }, { 0.25, 3.5, 2.0 }, { -0.01, 2.0, 2.0 }, { 10.0, 2.0, 2.0 } };
+	const fedes::PointQuality quality = fedes::ParallelPointQuality(*octree_, points, pool_, 4, 1000);
+	EXPECT_EQ(quality.count, points.size());
+	EXPECT_EQ(quality.relaxed + quality.projected, 2);
+	EXPECT_GE(quality.projected, 1);
+	EXPECT_NEAR(quality.max_distance, 6.0, 1e-12);
+	EXPECT_EQ(std::accumulate(quality.distance.counts.begin(), quality.distance.counts.end(), size_t(0)), points.size());
+	EXPECT_EQ(std::accumulate(quality.relaxation.counts.begin(), quality.relaxation.counts.end(), size_t(0)), 2);
+}
+
+TEST_F(MappingQuality, ReportAfterMapping) {
+	target_.nodes = { { 0.5, 0.5, 0.5 }, { 3.25, 1.0, 2.75 }, { 4.0, 4.0, 4.0 } };
+	target_.elements = { { 0, 1, 2, 0 } };
+	target_.displacement.resize(target_.nodes.size(), std::vector<double>(3));
+	fedes::ParallelElementShapeFunction(*octree_, source_, target_, pool_);
+
+	const fedes::MappingQuality quality = fedes::ParallelMappingQuality(*octree_, source_, target_, pool_);
+	ASSERT_EQ(quality.fields.size(), 1);
+	EXPECT_EQ(quality.fields[0].name, "displacement");
+	EXPECT_DOUBLE_EQ(quality.fields[0].min[0], 0.5);
+	EXPECT_DOUBLE_EQ(quality.fields[0].max[2], 4.0);
+	EXPECT_EQ(quality.nodes.count, 3);
+	EXPECT_EQ(quality.nodes.projected, 0);
+	EXPECT_EQ(quality.integration.count, 0);
+
+	std::ostringstream output;
+	quality.Write(output);
+	EXPECT_NE(output.str().find("displacement"), std::string::npos);
+}
+
+TEST_F(MappingQuality, RoundTripOfLinearFieldIsExact) {
+	// The target nodes coincide with half of the source nodes, mapping back by RBF reproduces the linear field
+	for (size_t i = 0; i < source_.nodes.size(); i += 2) {
+		target_.nodes.push_back(source_.nodes[i]);
+		target_.displacement.push_back(source_.displacement[i]);
+	}
+	const std::vector<fedes::FieldError> errors = fedes::ParallelRoundTripError(source_, target_, pool_,
+		[&](const fedes::Octree<double>& octree, const fedes::Model& source, fedes::Model& target) {
+			fedes::ParallelRadialBasisFunction(octree, source, target, pool_, 16);
+		});
+	ASSERT_EQ(errors.size(), 1);
+	EXPECT_EQ(errors[0].name, "displacement");
+	EXPECT_LT(errors[0].max, 1e-8);
+	EXPECT_LT(errors[0].relative_l2, 1e-8);
+}
+
+TEST_F(MappingQuality, RoundTripIntegrationFields) {
+	for (size_t i = 0; i < source_.nodes.size(); i += 3) {
+		target_.integration.push_back(source_.nodes[i]);
+		target_.accumulated_strain.push_back(source_.accumulated_strain[i]);
+	}
+	fedes::Model by_integration = source_;
+	by_integration.displacement.clear();
+	const std::vector<fedes::FieldError> errors = fedes::ParallelRoundTripError(by_integration, target_, pool_,
+		[&](const fedes::Octree<double>& octree, const fedes::Model& source, fedes::Model& target) {
+			fedes::ParallelNearestPointMethod(octree, source, target, pool_);
+		});
+	ASSERT_EQ(errors.size(), 1);
+	EXPECT_EQ(errors[0].name, "accumulated strain");
+	EXPECT_GT(errors[0].max, 0.0) << "Expected the nearest point method to lose the skipped nodes";
+	EXPECT_LE(errors[0].max, 2.0);
+}